@@ -4,6 +4,7 @@
 #include <sstream>
 
 #include <triton/api.hpp>
+#include <triton/astNodePool.hpp>
 #include <triton/bitsVector.hpp>
 #include <triton/exceptions.hpp>
 #include <triton/immediate.hpp>
@@ -17,6 +18,10 @@
 #include <triton/aarch64Cpu.hpp>
 #include <triton/aarch64Specifications.hpp>
 
+#ifdef TRITON_Z3_INTERFACE
+  #include <triton/tritonToZ3Ast.hpp>
+#endif
+
 
 int test_1(void) {
   triton::arch::x86::x8664Cpu   cpy1;
@@ -517,6 +522,120 @@ int test_9(void) {
 }
 
 
+#ifdef TRITON_Z3_INTERFACE
+int test_10(void) {
+  triton::API api;
+  triton::ast::TritonToZ3Ast z3ast(false, true);
+
+  api.setArchitecture(triton::arch::ARCH_X86_64);
+  auto actx = api.getAstContext();
+  auto x = actx->variable(api.newSymbolicVariable(32));
+  auto shared = actx->bvadd(x, actx->bv(1, 32));
+
+  /* A shared sub-expression is translated once */
+  z3ast.convert(actx->bvmul(shared, shared));
+  triton::usize size = z3ast.getCacheSize();
+  z3ast.convert(shared);
+  if (z3ast.getCacheSize() != size) {
+    std::cerr << "test_10: KO (the cache grew on a cached node)" << std::endl;
+    return 1;
+  }
+
+  z3ast.convert(actx->bvsub(shared, x));
+  if (z3ast.getCacheSize() != size + 1) {
+    std::cerr << "test_10: KO (the cache did not reuse the shared sub-expression)" << std::endl;
+    return 1;
+  }
+
+  /* A node modified in place is translated again */
+  shared->setChild(1, actx->bv(2, 32));
+  auto expr = z3ast.convert(shared);
+  if (!z3::eq(expr.simplify(), z3ast.convert(actx->bvadd(x, actx->bv(2, 32))).simplify())) {
+    std::cerr << "test_10: KO (the cache returned a stale translation)" << std::endl;
+    return 1;
+  }
+
+  std::cout << "test_10: OK" << std::endl;
+  return 0;
+}
+
+
+int test_11(void) {
+  triton::API api;
+  triton::ast::TritonToZ3Ast z3ast(false, true);
+
+  api.setArchitecture(triton::arch::ARCH_X86_64);
+  auto actx = api.getAstContext();
+  auto x = actx->variable(api.newSymbolicVariable(32));
+
+  z3ast.convert(x);
+  triton::usize size = z3ast.getCacheSize();
+
+  /* The entries of dropped nodes are swept once the cache doubled */
+  z3ast.convert(actx->bvnot(actx->bvneg(x)));
+  if (z3ast.getCacheSize() != size + 2) {
+    std::cerr << "test_11: KO (wrong cache size)" << std::endl;
+    return 1;
+  }
+
+  auto node = x;
+  for (triton::usize i = 0; i < 5000; i++)
+    node = actx->bvadd(node, x);
+  z3ast.convert(node);
+  if (z3ast.getCacheSize() != size + 5000) {
+    std::cerr << "test_11: KO (dead entries are not swept)" << std::endl;
+    return 1;
+  }
+
+  z3ast.clearCache();
+  if (z3ast.getCacheSize() != 0) {
+    std::cerr << "test_11: KO (the cache is not empty)" << std::endl;
+    return 1;
+  }
+
+  std::cout << "test_11: OK" << std::endl;
+  return 0;
+}
+#endif
+
+
+int test_12(void) {
+  triton::ast::NodePool* pool = new triton::ast::NodePool();
+  void* block = pool->allocate(100);
+
+  /* A scope without survivors is released in bulk */
+  pool->beginScope();
+  void* first = pool->allocate(100);
+  for (triton::usize i = 0; i < 5000; i++)
+    pool->deallocate(pool->allocate(48), 48);
+  pool->deallocate(first, 100);
+  pool->endScope();
+
+  void* again = pool->allocate(100);
+  if (again != first || pool->getMemoryUsage() != 64 * 1024) {
+    std::cerr << "test_12: KO (the scope is not released)" << std::endl;
+    return 1;
+  }
+
+  /* Survivors are handed over to the enclosing scope */
+  pool->beginScope();
+  void* survivor = pool->allocate(48);
+  pool->endScope();
+  if (pool->getNumberOfBlocks() != 3) {
+    std::cerr << "test_12: KO (wrong number of blocks)" << std::endl;
+    return 1;
+  }
+
+  pool->deallocate(survivor, 48);
+  pool->deallocate(again, 100);
+  pool->deallocate(block, 100);
+  pool->release();
+
+  std::cout << "test_12: OK" << std::endl;
+  return 0;
+}
+
+
 int main(int ac, const char **av) {
   if (test_1())
     return 1;
@@ -545,5 +664,16 @@ int main(int ac, const char **av) {
   if (test_9())
     return 1;
 
+  #ifdef TRITON_Z3_INTERFACE
+  if (test_10())
+    return 1;
+
+  if (test_11())
+    return 1;
+  #endif
+
+  if (test_12())
+    return 1;
+
   return 0;
 }
@@ -9,6 +9,7 @@
 #include <triton/config.hpp>
 #include <triton/exceptions.hpp>
 
+#include <algorithm>
 #include <list>
 #include <map>
 #include <memory>
@@ -475,6 +476,40 @@ namespace triton {
   }
 
 
+  void API::mapConcreteMemoryArea(triton::uint64 baseAddr, const triton::uint8* area, triton::usize size) {
+    this->checkArchitecture();
+    this->arch.mapConcreteMemoryArea(baseAddr, area, size);
+    /*
+     * In order to synchronize the concrete state with the symbolic
+     * one, the symbolic expression is concretized. Mapped areas are
+     * large, so this is skipped when no memory cell is symbolic.
+     */
+    this->checkSymbolic();
+    if (!this->symbolic->getSymbolicMemory().empty()) {
+      for (triton::usize index = 0 ; index < size ; index++) {
+        this->concretizeMemory(baseAddr + index);
+      }
+    }
+  }
+
+
+  void API::mapConcreteMemoryFile(triton::uint64 baseAddr, const std::string& path, triton::uint64 offset, triton::usize size) {
+    this->checkArchitecture();
+    this->arch.mapConcreteMemoryFile(baseAddr, path, offset, size);
+    /*
+     * In order to synchronize the concrete state with the symbolic
+     * one, the symbolic expression is concretized. Mapped areas are
+     * large, so this is skipped when no memory cell is symbolic.
+     */
+    this->checkSymbolic();
+    if (!this->symbolic->getSymbolicMemory().empty()) {
+      for (triton::usize index = 0 ; index < size ; index++) {
+        this->concretizeMemory(baseAddr + index);
+      }
+    }
+  }
+
+
   void API::setConcreteRegisterValue(const triton::arch::Register& reg, const triton::uint512& value) {
     this->checkArchitecture();
     this->arch.setConcreteRegisterValue(reg, value);
@@ -870,6 +905,36 @@ namespace triton {
   }
 
 
+  void API::addSimplificationRule(const std::string& rule) {
+    this->checkSymbolic();
+    this->symbolic->addSimplificationRule(rule);
+  }
+
+
+  void API::clearSimplificationRules(void) {
+    this->checkSymbolic();
+    this->symbolic->clearSimplificationRules();
+  }
+
+
+  std::vector<std::string> API::getSimplificationRules(void) const {
+    this->checkSymbolic();
+    return this->symbolic->getSimplificationRules();
+  }
+
+
+  void API::setMaxSimplificationIterations(triton::usize iterations) {
+    this->checkSymbolic();
+    this->symbolic->setMaxSimplificationIterations(iterations);
+  }
+
+
+  triton::usize API::getMaxSimplificationIterations(void) const {
+    this->checkSymbolic();
+    return this->symbolic->getMaxSimplificationIterations();
+  }
+
+
   triton::engines::symbolic::SharedSymbolicExpression API::getSymbolicExpression(triton::usize symExprId) const {
     this->checkSymbolic();
     return this->symbolic->getSymbolicExpression(symExprId);
@@ -930,6 +995,12 @@ namespace triton {
   }
 
 
+  triton::ast::SharedAbstractNode API::getPathPredicateSlice(const triton::ast::SharedAbstractNode& node, triton::usize prefix) {
+    this->checkSymbolic();
+    return this->symbolic->getPathPredicateSlice(node, prefix);
+  }
+
+
   std::vector<triton::ast::SharedAbstractNode> API::getPredicatesToReachAddress(triton::uint64 addr) {
     this->checkSymbolic();
     return this->symbolic->getPredicatesToReachAddress(addr);
@@ -960,6 +1031,30 @@ namespace triton {
   }
 
 
+  void API::setMaxPathConstraintsPerSite(triton::usize limit) {
+    this->checkSymbolic();
+    this->symbolic->setMaxPathConstraintsPerSite(limit);
+  }
+
+
+  void API::setPathConstraintLog(const std::string& path, triton::usize window) {
+    this->checkSymbolic();
+    this->symbolic->setPathConstraintLog(path, window);
+  }
+
+
+  triton::usize API::getSizeOfLoggedPathConstraints(void) const {
+    this->checkSymbolic();
+    return this->symbolic->getSizeOfLoggedPathConstraints();
+  }
+
+
+  std::vector<triton::engines::symbolic::PathConstraint> API::getLoggedPathConstraints(triton::usize start, triton::usize end) const {
+    this->checkSymbolic();
+    return this->symbolic->getLoggedPathConstraints(start, end);
+  }
+
+
   void API::enableSymbolicEngine(bool flag) {
     this->checkSymbolic();
     this->symbolic->enable(flag);
@@ -1101,12 +1196,108 @@ namespace triton {
   }
 
 
+  std::vector<std::unordered_map<triton::usize, triton::engines::solver::SolverModel>> API::getModels(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, const std::vector<triton::engines::symbolic::SharedSymbolicVariable>& variables, triton::engines::solver::status_e* status, triton::uint32 timeout, triton::uint32* solvingTime) const {
+    this->checkSolver();
+    return this->solver->getModels(node, limit, variables, status, timeout, solvingTime);
+  }
+
+
   bool API::isSat(const triton::ast::SharedAbstractNode& node, triton::engines::solver::status_e* status, triton::uint32 timeout, triton::uint32* solvingTime) const {
     this->checkSolver();
     return this->solver->isSat(node, status, timeout, solvingTime);
   }
 
 
+  std::unordered_map<triton::usize, triton::engines::solver::SolverModel> API::getModelOnPath(const triton::ast::SharedAbstractNode& node, triton::usize prefix, triton::engines::solver::status_e* status, triton::uint32 timeout, triton::uint32* solvingTime, triton::engines::solver::policy_e* strategy) const {
+    auto models = this->getModelsOnPath(node, prefix, 1, status, timeout, solvingTime, strategy);
+    if (models.size() > 0)
+      return models.front();
+    return {};
+  }
+
+
+  std::vector<std::unordered_map<triton::usize, triton::engines::solver::SolverModel>> API::getModelsOnPath(const triton::ast::SharedAbstractNode& node, triton::usize prefix, triton::uint32 limit, triton::engines::solver::status_e* status, triton::uint32 timeout, triton::uint32* solvingTime, triton::engines::solver::policy_e* strategy) const {
+    this->checkSolver();
+    this->checkSymbolic();
+    #ifdef TRITON_Z3_INTERFACE
+    if (this->getSolver() == triton::engines::solver::SOLVER_Z3) {
+      triton::engines::solver::policy_e policy = this->solver->getPolicy();
+      triton::engines::solver::policy_e used   = triton::engines::solver::POLICY_FULL;
+      triton::engines::solver::status_e st     = triton::engines::solver::UNKNOWN;
+      triton::uint32 total = 0;
+      triton::uint32 time  = 0;
+
+      prefix = std::min(prefix, this->symbolic->getSizeOfPathConstraints());
+
+      auto& session = this->solver->getSession();
+      session.sync(this->symbolic->getPathConstraints(), this->symbolic->getPathConstraintStamps(), prefix);
+      auto models = session.getModels(node, limit, &st, timeout, &total);
+
+      /* Weaker queries are solved out of the session, so its prefix is kept */
+      if (st != triton::engines::solver::SAT && prefix > 0 && policy != triton::engines::solver::POLICY_FULL) {
+        if (st != triton::engines::solver::UNSAT) {
+          models = this->solver->getModels(this->symbolic->getPathPredicateSlice(node, prefix), limit, &st, timeout, &time);
+          used   = triton::engines::solver::POLICY_NESTED;
+          total += time;
+        }
+        if (st != triton::engines::solver::SAT && policy == triton::engines::solver::POLICY_LAST) {
+          models = this->solver->getModels(node, limit, &st, timeout, &time);
+          used   = triton::engines::solver::POLICY_LAST;
+          total += time;
+        }
+      }
+
+      if (status)      *status = st;
+      if (solvingTime) *solvingTime = total;
+      if (strategy)    *strategy = used;
+      return models;
+    }
+    #endif
+    throw triton::exceptions::API("API::getModelsOnPath(): Solver instance must be a SOLVER_Z3.");
+  }
+
+
+  bool API::isSatOnPath(const triton::ast::SharedAbstractNode& node, triton::usize prefix, triton::engines::solver::status_e* status, triton::uint32 timeout, triton::uint32* solvingTime, triton::engines::solver::policy_e* strategy) const {
+    triton::engines::solver::status_e st = triton::engines::solver::UNKNOWN;
+
+    /* No model is asked, only the status */
+    this->getModelsOnPath(node, prefix, 0, &st, timeout, solvingTime, strategy);
+
+    if (status) *status = st;
+    return (st == triton::engines::solver::SAT);
+  }
+
+
+  void API::resetSolverSession(void) {
+    this->checkSolver();
+    this->solver->resetSession();
+  }
+
+
+  void API::setSolverPolicy(triton::engines::solver::policy_e policy) {
+    this->checkSolver();
+    this->solver->setPolicy(policy);
+  }
+
+
+  triton::engines::solver::policy_e API::getSolverPolicy(void) const {
+    this->checkSolver();
+    return this->solver->getPolicy();
+  }
+
+
+  void API::flipPathConstraints(const triton::engines::solver::ParallelSolver::Callback& callback, triton::uint32 threads, triton::uint32 timeout) {
+    this->checkSolver();
+    this->checkSymbolic();
+
+    /* Workers read copies, so the path may change once flipPathConstraints() returns */
+    auto pcs    = this->symbolic->getPathConstraints();
+    auto stamps = this->symbolic->getPathConstraintStamps();
+
+    this->solver->flipPathConstraints(pcs, stamps, callback, threads, timeout);
+  }
+
+
   triton::uint512 API::evaluateAstViaZ3(const triton::ast::SharedAbstractNode& node) const {
     this->checkSolver();
     #ifdef TRITON_Z3_INTERFACE
@@ -1141,6 +1332,54 @@ namespace triton {
   }
 
 
+  void API::setSolverCommands(const std::vector<std::vector<std::string>>& commands) {
+    this->checkSolver();
+    this->solver->setCommands(commands);
+  }
+
+
+  void API::setSolverCacheCapacity(triton::usize capacity) {
+    this->checkSolver();
+    this->solver->getCache().setCapacity(capacity);
+  }
+
+
+  triton::usize API::getSolverCacheHits(void) const {
+    this->checkSolver();
+    return this->solver->getCache().getHits();
+  }
+
+
+  triton::usize API::getSolverCacheMisses(void) const {
+    this->checkSolver();
+    return this->solver->getCache().getMisses();
+  }
+
+
+  void API::clearSolverCache(void) {
+    this->checkSolver();
+    this->solver->getCache().clear();
+  }
+
+
+  void API::setSolverFastPath(bool flag) {
+    this->checkSolver();
+    this->solver->getTrivialSolver().setEnabled(flag);
+  }
+
+
+  bool API::isSolverFastPathEnabled(void) const {
+    this->checkSolver();
+    return this->solver->getTrivialSolver().isEnabled();
+  }
+
+
+  triton::usize API::getSolverFastPathHits(void) const {
+    this->checkSolver();
+    return this->solver->getTrivialSolver().getHits();
+  }
+
+
 
   /* Taint engine API ============================================================================== */
 
@@ -340,6 +340,20 @@ namespace triton {
     }
 
 
+    void Architecture::mapConcreteMemoryArea(triton::uint64 baseAddr, const triton::uint8* area, triton::usize size) {
+      if (!this->cpu)
+        throw triton::exceptions::Architecture("Architecture::mapConcreteMemoryArea(): You must define an architecture.");
+      this->cpu->mapConcreteMemoryArea(baseAddr, area, size);
+    }
+
+
+    void Architecture::mapConcreteMemoryFile(triton::uint64 baseAddr, const std::string& path, triton::uint64 offset, triton::usize size) {
+      if (!this->cpu)
+        throw triton::exceptions::Architecture("Architecture::mapConcreteMemoryFile(): You must define an architecture.");
+      this->cpu->mapConcreteMemoryFile(baseAddr, path, offset, size);
+    }
+
+
     void Architecture::setConcreteRegisterValue(const triton::arch::Register& reg, const triton::uint512& value) {
       if (!this->cpu)
         throw triton::exceptions::Architecture("Architecture::setConcreteRegisterValue(): You must define an architecture.");
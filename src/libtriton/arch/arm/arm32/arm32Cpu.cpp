@@ -573,11 +573,7 @@ namespace triton {
           if (execCallbacks && this->callbacks)
             this->callbacks->processCallbacks(triton::callbacks::GET_CONCRETE_MEMORY_VALUE, MemoryAccess(addr, triton::size::byte));
 
-          auto it = this->memory.find(addr);
-          if (it == this->memory.end())
-            return 0x00;
-
-          return it->second;
+          return this->memory.read(addr);
         }
 
 
@@ -595,8 +591,11 @@ namespace triton {
           if (size == 0 || size > triton::size::dqqword)
             throw triton::exceptions::Cpu("Arm32Cpu::getConcreteMemoryValue(): Invalid size memory.");
 
+          triton::uint8 buffer[triton::size::dqqword];
+          this->memory.read(addr, buffer, size);
+
           for (triton::sint32 i = size-1; i >= 0; i--)
-            ret = ((ret << triton::bitsize::byte) | this->getConcreteMemoryValue(addr+i, false));
+            ret = ((ret << triton::bitsize::byte) | buffer[i]);
 
           return ret;
         }
@@ -605,8 +604,15 @@ namespace triton {
         std::vector<triton::uint8> Arm32Cpu::getConcreteMemoryAreaValue(triton::uint64 baseAddr, triton::usize size, bool execCallbacks) const {
           std::vector<triton::uint8> area;
 
-          for (triton::usize index = 0; index < size; index++)
-            area.push_back(this->getConcreteMemoryValue(baseAddr+index));
+          /* Callbacks are processed byte per byte */
+          if (execCallbacks && this->callbacks && this->callbacks->isDefined(triton::callbacks::GET_CONCRETE_MEMORY_VALUE)) {
+            for (triton::usize index = 0; index < size; index++)
+              area.push_back(this->getConcreteMemoryValue(baseAddr+index));
+            return area;
+          }
+
+          area.resize(size);
+          this->memory.read(baseAddr, area.data(), size);
 
           return area;
         }
@@ -651,7 +657,7 @@ namespace triton {
         void Arm32Cpu::setConcreteMemoryValue(triton::uint64 addr, triton::uint8 value) {
           if (this->callbacks)
             this->callbacks->processCallbacks(triton::callbacks::SET_CONCRETE_MEMORY_VALUE, MemoryAccess(addr, triton::size::byte), value);
-          this->memory[addr] = value;
+          this->memory.write(addr, value);
         }
 
 
@@ -669,26 +675,63 @@ namespace triton {
           if (this->callbacks)
             this->callbacks->processCallbacks(triton::callbacks::SET_CONCRETE_MEMORY_VALUE, mem, value);
 
+          triton::uint8 buffer[triton::size::dqqword];
           for (triton::uint32 i = 0; i < size; i++) {
-            this->memory[addr+i] = (cv & 0xff).convert_to<triton::uint8>();
+            buffer[i] = (cv & 0xff).convert_to<triton::uint8>();
             cv >>= 8;
           }
+
+          this->memory.write(addr, buffer, size);
         }
 
 
         void Arm32Cpu::setConcreteMemoryAreaValue(triton::uint64 baseAddr, const std::vector<triton::uint8>& values) {
-          this->memory.reserve(values.size() + this->memory.size());
-          for (triton::usize index = 0; index < values.size(); index++) {
-            this->setConcreteMemoryValue(baseAddr+index, values[index]);
+          /* Callbacks are processed byte per byte */
+          if (this->callbacks && this->callbacks->isDefined(triton::callbacks::SET_CONCRETE_MEMORY_VALUE)) {
+            for (triton::usize index = 0; index < values.size(); index++) {
+              this->setConcreteMemoryValue(baseAddr+index, values[index]);
+            }
+            return;
           }
+
+          this->memory.write(baseAddr, values.data(), values.size());
         }
 
 
         void Arm32Cpu::setConcreteMemoryAreaValue(triton::uint64 baseAddr, const triton::uint8* area, triton::usize size) {
-          this->memory.reserve(size + this->memory.size());
-          for (triton::usize index = 0; index < size; index++) {
-            this->setConcreteMemoryValue(baseAddr+index, area[index]);
+          /* Callbacks are processed byte per byte */
+          if (this->callbacks && this->callbacks->isDefined(triton::callbacks::SET_CONCRETE_MEMORY_VALUE)) {
+            for (triton::usize index = 0; index < size; index++) {
+              this->setConcreteMemoryValue(baseAddr+index, area[index]);
+            }
+            return;
           }
+
+          this->memory.write(baseAddr, area, size);
+        }
+
+
+        void Arm32Cpu::mapConcreteMemoryArea(triton::uint64 baseAddr, const triton::uint8* area, triton::usize size) {
+          /* Callbacks are processed byte per byte */
+          if (this->callbacks && this->callbacks->isDefined(triton::callbacks::SET_CONCRETE_MEMORY_VALUE)) {
+            this->setConcreteMemoryAreaValue(baseAddr, area, size);
+            return;
+          }
+
+          this->memory.map(baseAddr, area, size);
+        }
+
+
+        void Arm32Cpu::mapConcreteMemoryFile(triton::uint64 baseAddr, const std::string& path, triton::uint64 offset, triton::usize size) {
+          auto file = triton::arch::PagedMemory::mapFile(path, offset, size);
+
+          /* Callbacks are processed byte per byte */
+          if (this->callbacks && this->callbacks->isDefined(triton::callbacks::SET_CONCRETE_MEMORY_VALUE)) {
+            this->setConcreteMemoryAreaValue(baseAddr, file.get(), size);
+            return;
+          }
+
+          this->memory.map(baseAddr, file.get(), size, file);
         }
 
 
@@ -783,11 +826,7 @@ namespace triton {
 
 
         bool Arm32Cpu::isConcreteMemoryValueDefined(triton::uint64 baseAddr, triton::usize size) const {
-          for (triton::usize index = 0; index < size; index++) {
-            if (this->memory.find(baseAddr + index) == this->memory.end())
-              return false;
-          }
-          return true;
+          return this->memory.isDefined(baseAddr, size);
         }
 
 
@@ -797,11 +836,7 @@ namespace triton {
 
 
         void Arm32Cpu::clearConcreteMemoryValue(triton::uint64 baseAddr, triton::usize size) {
-          for (triton::usize index = 0; index < size; index++) {
-            if (this->memory.find(baseAddr + index) != this->memory.end()) {
-              this->memory.erase(baseAddr + index);
-            }
-          }
+          this->memory.erase(baseAddr, size);
         }
 
 
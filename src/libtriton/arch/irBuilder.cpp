@@ -73,6 +73,9 @@ namespace triton {
         }
       }
 
+      /* With AST_SLAB_ALLOCATOR, the nodes of the instruction are released in bulk if none survives it */
+      triton::ast::NodeScope scope(this->astCtxt);
+
       /* Pre IR processing */
       this->preIrInit(inst);
 
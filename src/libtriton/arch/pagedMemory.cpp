@@ -0,0 +1,366 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the Apache License 2.0.
+*/
+
+#include <bitset>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include <triton/exceptions.hpp>
+#include <triton/pagedMemory.hpp>
+
+
+
+namespace triton {
+  namespace arch {
+
+    const triton::uint32 PagedMemory::pageBits;
+    const triton::uint32 PagedMemory::directoryBits;
+    const triton::usize PagedMemory::pageSize;
+    const triton::uint8 PagedMemory::zeroPage[PagedMemory::pageSize] = {};
+
+
+    /* Sets or clears `size` bits from `offset` and returns the number of bits changed */
+    static triton::usize updateBits(triton::uint64* bitmap, triton::usize offset, triton::usize size, bool set) {
+      triton::usize changed = 0;
+
+      while (size) {
+        triton::usize bit   = offset % 64;
+        triton::usize count = (64 - bit < size) ? 64 - bit : size;
+        triton::uint64 mask = (count == 64) ? ~0ULL : (((1ULL << count) - 1) << bit);
+        triton::uint64& word = bitmap[offset / 64];
+        triton::uint64 next  = set ? (word | mask) : (word & ~mask);
+
+        changed += std::bitset<64>(word ^ next).count();
+        word     = next;
+        offset  += count;
+        size    -= count;
+      }
+
+      return changed;
+    }
+
+
+    /* Returns true if `size` bits from `offset` are all set */
+    static bool allBits(const triton::uint64* bitmap, triton::usize offset, triton::usize size) {
+      while (size) {
+        triton::usize bit   = offset % 64;
+        triton::usize count = (64 - bit < size) ? 64 - bit : size;
+        triton::uint64 mask = (count == 64) ? ~0ULL : (((1ULL << count) - 1) << bit);
+
+        if ((bitmap[offset / 64] & mask) != mask)
+          return false;
+
+        offset += count;
+        size   -= count;
+      }
+      return true;
+    }
+
+
+    PagedMemory::PagedMemory() {
+      this->lastNumber = 0;
+      this->lastPage   = nullptr;
+    }
+
+
+    PagedMemory::PagedMemory(const PagedMemory& other) {
+      this->lastNumber = 0;
+      this->lastPage   = nullptr;
+      *this = other;
+    }
+
+
+    PagedMemory& PagedMemory::operator=(const PagedMemory& other) {
+      if (this == &other)
+        return *this;
+
+      this->clear();
+      for (auto&& it : other.directories) {
+        std::unique_ptr<Directory> directory(new(std::nothrow) Directory());
+        if (directory == nullptr)
+          throw triton::exceptions::Cpu("PagedMemory::operator=(): Not enough memory.");
+
+        for (triton::usize index = 0; index < (1 << directoryBits); index++) {
+          const Page* source = it.second->pages[index].get();
+          if (source == nullptr)
+            continue;
+
+          std::unique_ptr<Page> page(new(std::nothrow) Page());
+          if (page == nullptr)
+            throw triton::exceptions::Cpu("PagedMemory::operator=(): Not enough memory.");
+
+          /* Mapped pages and the zero page are shared */
+          page->data  = source->data;
+          page->owner = source->owner;
+          page->count = source->count;
+          std::memcpy(page->defined, source->defined, sizeof(page->defined));
+          if (source->storage != nullptr) {
+            page->storage.reset(new(std::nothrow) triton::uint8[pageSize]);
+            if (page->storage == nullptr)
+              throw triton::exceptions::Cpu("PagedMemory::operator=(): Not enough memory.");
+            std::memcpy(page->storage.get(), source->storage.get(), pageSize);
+            page->data = page->storage.get();
+          }
+
+          directory->pages[index] = std::move(page);
+        }
+
+        directory->count = it.second->count;
+        this->directories[it.first] = std::move(directory);
+      }
+
+      return *this;
+    }
+
+
+    PagedMemory::Page* PagedMemory::findPage(triton::uint64 addr) const {
+      triton::uint64 number = addr >> pageBits;
+
+      if (this->lastPage != nullptr && this->lastNumber == number)
+        return this->lastPage;
+
+      auto it = this->directories.find(number >> directoryBits);
+      if (it == this->directories.end())
+        return nullptr;
+
+      Page* page = it->second->pages[number & ((1 << directoryBits) - 1)].get();
+      if (page != nullptr) {
+        this->lastNumber = number;
+        this->lastPage   = page;
+      }
+
+      return page;
+    }
+
+
+    PagedMemory::Page* PagedMemory::getPage(triton::uint64 addr) {
+      Page* page = this->findPage(addr);
+      if (page != nullptr)
+        return page;
+
+      triton::uint64 number = addr >> pageBits;
+      auto& directory = this->directories[number >> directoryBits];
+      if (directory == nullptr) {
+        directory.reset(new(std::nothrow) Directory());
+        if (directory == nullptr)
+          throw triton::exceptions::Cpu("PagedMemory::getPage(): Not enough memory.");
+      }
+
+      auto& slot = directory->pages[number & ((1 << directoryBits) - 1)];
+      slot.reset(new(std::nothrow) Page());
+      if (slot == nullptr)
+        throw triton::exceptions::Cpu("PagedMemory::getPage(): Not enough memory.");
+      slot->data = zeroPage;
+      directory->count++;
+
+      this->lastNumber = number;
+      this->lastPage   = slot.get();
+
+      return slot.get();
+    }
+
+
+    void PagedMemory::freePage(triton::uint64 addr) {
+      triton::uint64 number = addr >> pageBits;
+
+      auto it = this->directories.find(number >> directoryBits);
+      if (it == this->directories.end())
+        return;
+
+      it->second->pages[number & ((1 << directoryBits) - 1)].reset();
+      if (--it->second->count == 0)
+        this->directories.erase(it);
+
+      this->lastPage = nullptr;
+    }
+
+
+    triton::uint8* PagedMemory::getStorage(Page* page) {
+      if (page->storage == nullptr) {
+        page->storage.reset(new(std::nothrow) triton::uint8[pageSize]);
+        if (page->storage == nullptr)
+          throw triton::exceptions::Cpu("PagedMemory::getStorage(): Not enough memory.");
+        std::memcpy(page->storage.get(), page->data, pageSize);
+        page->data = page->storage.get();
+        page->owner.reset();
+      }
+      return page->storage.get();
+    }
+
+
+    void PagedMemory::clear(void) {
+      this->directories.clear();
+      this->lastPage = nullptr;
+    }
+
+
+    bool PagedMemory::isDefined(triton::uint64 addr, triton::usize size) const {
+      while (size) {
+        triton::usize offset = addr & (pageSize - 1);
+        triton::usize chunk  = (pageSize - offset < size) ? pageSize - offset : size;
+        const Page* page     = this->findPage(addr);
+
+        if (page == nullptr || !allBits(page->defined, offset, chunk))
+          return false;
+
+        addr += chunk;
+        size -= chunk;
+      }
+      return true;
+    }
+
+
+    triton::uint8 PagedMemory::read(triton::uint64 addr) const {
+      const Page* page = this->findPage(addr);
+      if (page == nullptr)
+        return 0x00;
+      return page->data[addr & (pageSize - 1)];
+    }
+
+
+    void PagedMemory::read(triton::uint64 addr, triton::uint8* dst, triton::usize size) const {
+      while (size) {
+        triton::usize offset = addr & (pageSize - 1);
+        triton::usize chunk  = (pageSize - offset < size) ? pageSize - offset : size;
+        const Page* page     = this->findPage(addr);
+
+        /* Undefined bytes of a page are kept at 0 */
+        if (page != nullptr)
+          std::memcpy(dst, page->data + offset, chunk);
+        else
+          std::memset(dst, 0x00, chunk);
+
+        dst  += chunk;
+        addr += chunk;
+        size -= chunk;
+      }
+    }
+
+
+    void PagedMemory::write(triton::uint64 addr, triton::uint8 value) {
+      Page* page           = this->getPage(addr);
+      triton::usize offset = addr & (pageSize - 1);
+
+      page->count += updateBits(page->defined, offset, 1, true);
+      this->getStorage(page)[offset] = value;
+    }
+
+
+    void PagedMemory::write(triton::uint64 addr, const triton::uint8* src, triton::usize size) {
+      while (size) {
+        triton::usize offset = addr & (pageSize - 1);
+        triton::usize chunk  = (pageSize - offset < size) ? pageSize - offset : size;
+        Page* page           = this->getPage(addr);
+
+        page->count += updateBits(page->defined, offset, chunk, true);
+        std::memcpy(this->getStorage(page) + offset, src, chunk);
+
+        src  += chunk;
+        addr += chunk;
+        size -= chunk;
+      }
+    }
+
+
+    void PagedMemory::erase(triton::uint64 addr, triton::usize size) {
+      while (size) {
+        triton::usize offset = addr & (pageSize - 1);
+        triton::usize chunk  = (pageSize - offset < size) ? pageSize - offset : size;
+        Page* page           = this->findPage(addr);
+
+        if (page != nullptr) {
+          page->count -= updateBits(page->defined, offset, chunk, false);
+          if (page->count == 0)
+            this->freePage(addr);
+          else
+            std::memset(this->getStorage(page) + offset, 0x00, chunk);
+        }
+
+        addr += chunk;
+        size -= chunk;
+      }
+    }
+
+
+    void PagedMemory::map(triton::uint64 addr, const triton::uint8* area, triton::usize size, const std::shared_ptr<const void>& owner) {
+      while (size) {
+        triton::usize offset = addr & (pageSize - 1);
+        triton::usize chunk  = (pageSize - offset < size) ? pageSize - offset : size;
+
+        /* Pages partially covered by the area are copied */
+        if (chunk != pageSize) {
+          this->write(addr, area, chunk);
+        }
+        else {
+          Page* page = this->getPage(addr);
+          page->data  = area;
+          page->owner = owner;
+          page->count = pageSize;
+          page->storage.reset();
+          std::memset(page->defined, 0xff, sizeof(page->defined));
+        }
+
+        area += chunk;
+        addr += chunk;
+        size -= chunk;
+      }
+    }
+
+
+    std::shared_ptr<const triton::uint8> PagedMemory::mapFile(const std::string& path, triton::uint64 offset, triton::usize size) {
+      #if defined(__unix__) || defined(__APPLE__)
+      int fd = open(path.c_str(), O_RDONLY);
+      if (fd < 0)
+        throw triton::exceptions::Cpu("PagedMemory::mapFile(): Cannot open the file.");
+
+      struct stat st;
+      if (fstat(fd, &st) != 0 || offset > static_cast<triton::uint64>(st.st_size) || size > static_cast<triton::uint64>(st.st_size) - offset) {
+        close(fd);
+        throw triton::exceptions::Cpu("PagedMemory::mapFile(): The range is out of the file.");
+      }
+
+      if (size == 0) {
+        close(fd);
+        return nullptr;
+      }
+
+      /* The offset of a mapping must be aligned on a system page */
+      triton::usize delta  = offset % static_cast<triton::uint64>(sysconf(_SC_PAGESIZE));
+      triton::usize length = size + delta;
+      void* base = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, offset - delta);
+      close(fd);
+      if (base == MAP_FAILED)
+        throw triton::exceptions::Cpu("PagedMemory::mapFile(): Cannot map the file.");
+
+      std::shared_ptr<void> mapping(base, [length](void* ptr) { munmap(ptr, length); });
+      return std::shared_ptr<const triton::uint8>(mapping, static_cast<const triton::uint8*>(base) + delta);
+      #else
+      /* Without mmap, the range is read into a buffer shared by its pages */
+      std::ifstream file(path, std::ios::binary);
+      if (!file)
+        throw triton::exceptions::Cpu("PagedMemory::mapFile(): Cannot open the file.");
+
+      auto buffer = std::make_shared<std::vector<triton::uint8>>(size);
+      if (!file.seekg(offset) || !file.read(reinterpret_cast<char*>(buffer->data()), size))
+        throw triton::exceptions::Cpu("PagedMemory::mapFile(): The range is out of the file.");
+
+      return std::shared_ptr<const triton::uint8>(buffer, buffer->data());
+      #endif
+    }
+
+  }; /* arch namespace */
+}; /* triton namespace */
@@ -543,11 +543,7 @@ namespace triton {
         if (execCallbacks && this->callbacks)
           this->callbacks->processCallbacks(triton::callbacks::GET_CONCRETE_MEMORY_VALUE, MemoryAccess(addr, triton::size::byte));
 
-        auto it = this->memory.find(addr);
-        if (it == this->memory.end())
-          return 0x00;
-
-        return it->second;
+        return this->memory.read(addr);
       }
 
 
@@ -565,8 +561,11 @@ namespace triton {
         if (size == 0 || size > triton::size::dqqword)
           throw triton::exceptions::Cpu("x8664Cpu::getConcreteMemoryValue(): Invalid size memory.");
 
+        triton::uint8 buffer[triton::size::dqqword];
+        this->memory.read(addr, buffer, size);
+
         for (triton::sint32 i = size-1; i >= 0; i--)
-          ret = ((ret << triton::bitsize::byte) | this->getConcreteMemoryValue(addr+i, false));
+          ret = ((ret << triton::bitsize::byte) | buffer[i]);
 
         return ret;
       }
@@ -575,8 +574,15 @@ namespace triton {
       std::vector<triton::uint8> x8664Cpu::getConcreteMemoryAreaValue(triton::uint64 baseAddr, triton::usize size, bool execCallbacks) const {
         std::vector<triton::uint8> area;
 
-        for (triton::usize index = 0; index < size; index++)
-          area.push_back(this->getConcreteMemoryValue(baseAddr+index));
+        /* Callbacks are processed byte per byte */
+        if (execCallbacks && this->callbacks && this->callbacks->isDefined(triton::callbacks::GET_CONCRETE_MEMORY_VALUE)) {
+          for (triton::usize index = 0; index < size; index++)
+            area.push_back(this->getConcreteMemoryValue(baseAddr+index));
+          return area;
+        }
+
+        area.resize(size);
+        this->memory.read(baseAddr, area.data(), size);
 
         return area;
       }
@@ -833,7 +839,7 @@ namespace triton {
       void x8664Cpu::setConcreteMemoryValue(triton::uint64 addr, triton::uint8 value) {
         if (this->callbacks)
           this->callbacks->processCallbacks(triton::callbacks::SET_CONCRETE_MEMORY_VALUE, MemoryAccess(addr, triton::size::byte), value);
-        this->memory[addr] = value;
+        this->memory.write(addr, value);
       }
 
 
@@ -851,28 +857,63 @@ namespace triton {
         if (this->callbacks)
           this->callbacks->processCallbacks(triton::callbacks::SET_CONCRETE_MEMORY_VALUE, mem, value);
 
+        triton::uint8 buffer[triton::size::dqqword];
         for (triton::uint32 i = 0; i < size; i++) {
-          this->memory[addr+i] = (cv & 0xff).convert_to<triton::uint8>();
+          buffer[i] = (cv & 0xff).convert_to<triton::uint8>();
           cv >>= 8;
         }
+
+        this->memory.write(addr, buffer, size);
       }
 
 
       void x8664Cpu::setConcreteMemoryAreaValue(triton::uint64 baseAddr, const std::vector<triton::uint8>& values) {
-        // Pre-reserving the memory. We modified the original robin_map to not force rehash on reserve.
-        this->memory.reserve(values.size() + this->memory.size());
-        for (triton::usize index = 0; index < values.size(); index++) {
-          this->setConcreteMemoryValue(baseAddr+index, values[index]);
+        /* Callbacks are processed byte per byte */
+        if (this->callbacks && this->callbacks->isDefined(triton::callbacks::SET_CONCRETE_MEMORY_VALUE)) {
+          for (triton::usize index = 0; index < values.size(); index++) {
+            this->setConcreteMemoryValue(baseAddr+index, values[index]);
+          }
+          return;
         }
+
+        this->memory.write(baseAddr, values.data(), values.size());
       }
 
 
       void x8664Cpu::setConcreteMemoryAreaValue(triton::uint64 baseAddr, const triton::uint8* area, triton::usize size) {
-        // Pre-reserving the memory. We modified the original robin_map to not force rehash on every reserve if not needed.
-        this->memory.reserve(size + this->memory.size());
-        for (triton::usize index = 0; index < size; index++) {
-          this->setConcreteMemoryValue(baseAddr+index, area[index]);
+        /* Callbacks are processed byte per byte */
+        if (this->callbacks && this->callbacks->isDefined(triton::callbacks::SET_CONCRETE_MEMORY_VALUE)) {
+          for (triton::usize index = 0; index < size; index++) {
+            this->setConcreteMemoryValue(baseAddr+index, area[index]);
+          }
+          return;
         }
+
+        this->memory.write(baseAddr, area, size);
+      }
+
+
+      void x8664Cpu::mapConcreteMemoryArea(triton::uint64 baseAddr, const triton::uint8* area, triton::usize size) {
+        /* Callbacks are processed byte per byte */
+        if (this->callbacks && this->callbacks->isDefined(triton::callbacks::SET_CONCRETE_MEMORY_VALUE)) {
+          this->setConcreteMemoryAreaValue(baseAddr, area, size);
+          return;
+        }
+
+        this->memory.map(baseAddr, area, size);
+      }
+
+
+      void x8664Cpu::mapConcreteMemoryFile(triton::uint64 baseAddr, const std::string& path, triton::uint64 offset, triton::usize size) {
+        auto file = triton::arch::PagedMemory::mapFile(path, offset, size);
+
+        /* Callbacks are processed byte per byte */
+        if (this->callbacks && this->callbacks->isDefined(triton::callbacks::SET_CONCRETE_MEMORY_VALUE)) {
+          this->setConcreteMemoryAreaValue(baseAddr, file.get(), size);
+          return;
+        }
+
+        this->memory.map(baseAddr, file.get(), size, file);
       }
 
 
@@ -1279,11 +1320,7 @@ namespace triton {
 
 
       bool x8664Cpu::isConcreteMemoryValueDefined(triton::uint64 baseAddr, triton::usize size) const {
-        for (triton::usize index = 0; index < size; index++) {
-          if (this->memory.find(baseAddr + index) == this->memory.end())
-            return false;
-        }
-        return true;
+        return this->memory.isDefined(baseAddr, size);
       }
 
 
@@ -1293,11 +1330,7 @@ namespace triton {
 
 
       void x8664Cpu::clearConcreteMemoryValue(triton::uint64 baseAddr, triton::usize size) {
-        for (triton::usize index = 0; index < size; index++) {
-          if (this->memory.find(baseAddr + index) != this->memory.end()) {
-            this->memory.erase(baseAddr + index);
-          }
-        }
+        this->memory.erase(baseAddr, size);
       }
 
     }; /* x86 namespace */
@@ -13,6 +13,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include <triton/ast.hpp>
 #include <triton/astContext.hpp>
@@ -37,12 +38,59 @@ namespace triton {
       this->size        = 0;
       this->symbolized  = false;
       this->type        = type;
+      this->epoch       = (ctxt != nullptr ? ctxt->getEpoch() : 0);
+    }
+
+
+    AbstractNode::AbstractNode(const AbstractNode& other)
+      : std::enable_shared_from_this<AbstractNode>(other) {
+      this->children    = other.children;
+      this->ctxt        = other.ctxt;
+      this->epoch       = other.epoch;
+      this->eval        = other.eval;
+      this->wideEval.reset(other.wideEval ? new triton::uint512(*other.wideEval) : nullptr);
+      this->hash        = other.hash;
+      this->level       = other.level;
+      this->logical     = other.logical;
+      this->parents     = other.parents;
+      this->size        = other.size;
+      this->symbolized  = other.symbolized;
+      this->type        = other.type;
+      /* The parents index is rebuilt on demand */
     }
 
 
     AbstractNode::~AbstractNode() {
+      /*
+       * Children only owned by this node are not destroyed from here but pushed on
+       * a worklist drained by the outermost destructor. Thus, destroying a deep AST
+       * does not recurse through the shared_ptr destructors. The worklist lives on
+       * the stack of the outermost destructor, nested destructors reach it through
+       * a raw pointer, so nothing here outlives its thread (e.g. at process exit).
+       */
+      static thread_local std::vector<SharedAbstractNode>* orphans = nullptr;
+      std::vector<SharedAbstractNode> worklist;
+      bool outermost = (orphans == nullptr);
+
+      if (outermost)
+        orphans = &worklist;
+
+      for (SharedAbstractNode& child : this->children) {
+        if (child.use_count() == 1)
+          orphans->push_back(std::move(child));
+      }
+
       /* See #828: Release ownership before calling container destructor */
       this->children.clear();
+
+      if (!outermost)
+        return;
+
+      while (!worklist.empty()) {
+        SharedAbstractNode orphan = std::move(worklist.back());
+        worklist.pop_back();
+      }
+      orphans = nullptr;
     }
 
 
@@ -62,6 +110,9 @@ namespace triton {
 
 
     triton::uint512 AbstractNode::getBitvectorMask(void) const {
+      if (this->size <= 64)
+        return triton::ast::mask64(this->size);
+
       triton::uint512 mask = -1;
       mask = mask >> (512 - this->size);
       return mask;
@@ -69,7 +120,7 @@ namespace triton {
 
 
     bool AbstractNode::isSigned(void) const {
-      if ((this->eval >> (this->size-1)) & 1)
+      if ((this->evaluate() >> (this->size-1)) & 1)
         return true;
       return false;
     }
@@ -126,6 +177,10 @@ namespace triton {
 
 
     bool AbstractNode::equalTo(const SharedAbstractNode& other) const {
+      /* Hash-consed (or simply shared) nodes are equal by identity */
+      if (this == other.get())
+        return true;
+
       return (this->evaluate() == other->evaluate()) &&
              (this->getBitvectorSize() == other->getBitvectorSize()) &&
              (this->getHash() == other->getHash()) &&
@@ -134,11 +189,80 @@ namespace triton {
 
 
     triton::uint512 AbstractNode::evaluate(void) const {
+      /* Only symbolized nodes may depend on a variable updated in lazy mode */
+      if (this->symbolized && this->epoch != this->ctxt->getEpoch()) {
+        const_cast<AbstractNode*>(this)->refreshEvaluation();
+      }
+      if (this->wideEval)
+        return *this->wideEval;
       return this->eval;
     }
 
 
-    triton::uint512 AbstractNode::getHash(void) const {
+    triton::uint64 AbstractNode::evaluate64(void) const {
+      if (this->symbolized && this->epoch != this->ctxt->getEpoch()) {
+        const_cast<AbstractNode*>(this)->refreshEvaluation();
+      }
+      if (this->wideEval)
+        return static_cast<triton::uint64>(*this->wideEval);
+      return this->eval;
+    }
+
+
+    void AbstractNode::setEval(const triton::uint512& value) {
+      if (value <= 0xffffffffffffffff) {
+        this->setEval(static_cast<triton::uint64>(value));
+        return;
+      }
+
+      this->eval = 0;
+      if (this->wideEval)
+        *this->wideEval = value;
+      else
+        this->wideEval.reset(new triton::uint512(value));
+    }
+
+
+    void AbstractNode::setEval(triton::uint64 value) {
+      this->eval = value;
+      this->wideEval.reset();
+    }
+
+
+    void AbstractNode::refreshEvaluation(void) {
+      triton::uint64 current = this->ctxt->getEpoch();
+      std::vector<std::pair<AbstractNode*, bool>> worklist;
+
+      /* Iterative post-order, so children (and referenced expressions) are refreshed before their parents */
+      worklist.push_back(std::make_pair(this, false));
+      while (!worklist.empty()) {
+        AbstractNode* node = worklist.back().first;
+
+        if (node->symbolized == false || node->epoch == current) {
+          worklist.pop_back();
+          continue;
+        }
+
+        if (worklist.back().second == false) {
+          worklist.back().second = true;
+          if (node->type == REFERENCE_NODE) {
+            const SharedAbstractNode& ast = reinterpret_cast<ReferenceNode*>(node)->getSymbolicExpression()->getAst();
+            worklist.push_back(std::make_pair(ast.get(), false));
+          }
+          for (const auto& child : node->children) {
+            worklist.push_back(std::make_pair(child.get(), false));
+          }
+          continue;
+        }
+
+        worklist.pop_back();
+        node->init();
+        node->epoch = current;
+      }
+    }
+
+
+    triton::uint64 AbstractNode::getHash(void) const {
       return this->hash;
     }
 
@@ -161,54 +285,103 @@ namespace triton {
     }
 
 
+    triton::usize AbstractNode::findParent(AbstractNode* p) {
+      if (this->parents.size() <= AbstractNode::maxLinearParents) {
+        for (triton::usize index = 0; index < this->parents.size(); index++) {
+          if (this->parents[index].node == p)
+            return index;
+        }
+        return this->parents.size();
+      }
+
+      if (this->parentsIndex == nullptr) {
+        this->parentsIndex.reset(new std::unordered_map<AbstractNode*, triton::usize>());
+        for (triton::usize index = 0; index < this->parents.size(); index++)
+          (*this->parentsIndex)[this->parents[index].node] = index;
+      }
+
+      auto it = this->parentsIndex->find(p);
+      if (it == this->parentsIndex->end())
+        return this->parents.size();
+
+      return it->second;
+    }
+
+
+    void AbstractNode::eraseParent(triton::usize index) {
+      if (this->parentsIndex)
+        this->parentsIndex->erase(this->parents[index].node);
+
+      /* Move the last parent in the hole */
+      if (index != this->parents.size() - 1) {
+        this->parents[index] = std::move(this->parents.back());
+        if (this->parentsIndex)
+          (*this->parentsIndex)[this->parents[index].node] = index;
+      }
+      this->parents.pop_back();
+
+      if (this->parents.size() <= AbstractNode::maxLinearParents)
+        this->parentsIndex.reset();
+    }
+
+
+    void AbstractNode::pruneParents(void) {
+      for (triton::usize index = this->parents.size(); index > 0; index--) {
+        if (this->parents[index - 1].weak.expired())
+          this->eraseParent(index - 1);
+      }
+    }
+
+
     std::vector<SharedAbstractNode> AbstractNode::getParents(void) {
       std::vector<SharedAbstractNode> res;
-      std::vector<AbstractNode*> toRemove;
 
-      for (auto& kv: parents) {
-        if (auto sp = kv.second.second.lock())
+      this->pruneParents();
+      res.reserve(this->parents.size());
+      for (const auto& edge : this->parents) {
+        if (auto sp = edge.weak.lock())
           res.push_back(sp);
-        else
-          toRemove.push_back(kv.first);
       }
 
-      for(auto* an: toRemove)
-        parents.erase(an);
-
       return res;
     }
 
 
     void AbstractNode::setParent(AbstractNode* p) {
-      auto it = parents.find(p);
+      triton::usize index = this->findParent(p);
+
+      if (index == this->parents.size()) {
+        /* Dead parents are only removed from time to time (each time the list size is a power of two) */
+        if (index > AbstractNode::maxLinearParents && (index & (index - 1)) == 0)
+          this->pruneParents();
 
-      if (it == parents.end()) {
-        auto A = p->shared_from_this();
-        this->parents.insert(std::make_pair(p, std::make_pair(1, WeakAbstractNode(A))));
+        this->parents.push_back({p, 1, WeakAbstractNode(p->shared_from_this())});
+        if (this->parentsIndex)
+          (*this->parentsIndex)[p] = this->parents.size() - 1;
       }
       else {
-        if (it->second.second.expired()) {
-          parents.erase(it);
-          auto A = p->shared_from_this();
-          this->parents.insert(std::make_pair(p, std::make_pair(1, WeakAbstractNode(A))));
+        auto& edge = this->parents[index];
+        if (edge.weak.expired()) {
+          edge.count = 1;
+          edge.weak  = p->shared_from_this();
         }
         // Ptr already in, add it for the counter
         else {
-          it->second.first += 1;
+          edge.count += 1;
         }
       }
     }
 
 
     void AbstractNode::removeParent(AbstractNode* p) {
-      auto it = this->parents.find(p);
+      triton::usize index = this->findParent(p);
 
-      if (it == parents.end())
+      if (index == this->parents.size())
         return;
 
-      it->second.first--;
-      if (it->second.first == 0)
-        this->parents.erase(it);
+      this->parents[index].count--;
+      if (this->parents[index].count == 0)
+        this->eraseParent(index);
     }
 
 
@@ -277,7 +450,7 @@ namespace triton {
 
       /* Init attributes */
       this->size       = this->children[0]->getBitvectorSize();
-      this->eval       = ((this->children[0]->evaluate()) & this->getBitvectorMask());
+      this->setEval(((this->children[0]->evaluate()) & this->getBitvectorMask()));
       this->level      = 1;
       this->symbolized = false;
 
@@ -298,13 +471,11 @@ namespace triton {
 
 
     void AssertNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
-      for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * this->children[index]->getHash();
-      }
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
+      this->hash = triton::ast::hashCombine(this->hash, triton::ast::hashUnordered(this->children));
 
       this->hash = triton::ast::rotl(this->hash, this->level);
     }
@@ -328,7 +499,10 @@ namespace triton {
 
       /* Init attributes */
       this->size       = this->children[0]->getBitvectorSize();
-      this->eval       = ((this->children[0]->evaluate() + this->children[1]->evaluate()) & this->getBitvectorMask());
+      if (this->size <= 64)
+        this->setEval(((this->children[0]->evaluate64() + this->children[1]->evaluate64()) & triton::ast::mask64(this->size)));
+      else
+        this->setEval(((this->children[0]->evaluate() + this->children[1]->evaluate()) & this->getBitvectorMask()));
       this->level      = 1;
       this->symbolized = false;
 
@@ -349,13 +523,11 @@ namespace triton {
 
 
     void BvaddNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
-      for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * this->children[index]->getHash();
-      }
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
+      this->hash = triton::ast::hashCombine(this->hash, triton::ast::hashUnordered(this->children));
 
       this->hash = triton::ast::rotl(this->hash, this->level);
     }
@@ -379,7 +551,10 @@ namespace triton {
 
       /* Init attributes */
       this->size       = this->children[0]->getBitvectorSize();
-      this->eval       = (this->children[0]->evaluate() & this->children[1]->evaluate());
+      if (this->size <= 64)
+        this->setEval((this->children[0]->evaluate64() & this->children[1]->evaluate64()));
+      else
+        this->setEval((this->children[0]->evaluate() & this->children[1]->evaluate()));
       this->level      = 1;
       this->symbolized = false;
 
@@ -400,13 +575,11 @@ namespace triton {
 
 
     void BvandNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
-      for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * this->children[index]->getHash();
-      }
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
+      this->hash = triton::ast::hashCombine(this->hash, triton::ast::hashUnordered(this->children));
 
       this->hash = triton::ast::rotl(this->hash, this->level);
     }
@@ -447,23 +620,23 @@ namespace triton {
       }
 
       if (shift >= this->size && this->children[0]->isSigned()) {
-        this->eval = -1;
-        this->eval &= this->getBitvectorMask();
+        this->setEval(this->getBitvectorMask());
       }
 
       else if (shift >= this->size && !this->children[0]->isSigned()) {
-        this->eval = 0;
+        this->setEval(0);
       }
 
       else if (shift == 0) {
-        this->eval = value;
+        this->setEval(value);
       }
 
       else {
-        this->eval = value & this->getBitvectorMask();
+        value &= this->getBitvectorMask();
         for (triton::uint32 index = 0; index < shift; index++) {
-          this->eval = (((this->eval >> 1) | mask) & this->getBitvectorMask());
+          value = (((value >> 1) | mask) & this->getBitvectorMask());
         }
+        this->setEval(value);
       }
 
       /* Init children and spread information */
@@ -483,12 +656,12 @@ namespace triton {
 
 
     void BvashrNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * triton::ast::hash2n(this->children[index]->getHash(), index+1);
+        this->hash = triton::ast::hashCombine(this->hash, this->children[index]->getHash());
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -513,7 +686,12 @@ namespace triton {
 
       /* Init attributes */
       this->size       = this->children[0]->getBitvectorSize();
-      this->eval       = (this->children[0]->evaluate() >> this->children[1]->evaluate().convert_to<triton::uint32>());
+      if (this->children[1]->evaluate() >= this->size)
+        this->setEval(0);
+      else if (this->size <= 64)
+        this->setEval((this->children[0]->evaluate64() >> this->children[1]->evaluate64()));
+      else
+        this->setEval((this->children[0]->evaluate() >> this->children[1]->evaluate().convert_to<triton::uint32>()));
       this->level      = 1;
       this->symbolized = false;
 
@@ -534,12 +712,12 @@ namespace triton {
 
 
     void BvlshrNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * triton::ast::hash2n(this->children[index]->getHash(), index+1);
+        this->hash = triton::ast::hashCombine(this->hash, this->children[index]->getHash());
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -564,7 +742,10 @@ namespace triton {
 
       /* Init attributes */
       this->size       = this->children[0]->getBitvectorSize();
-      this->eval       = ((this->children[0]->evaluate() * this->children[1]->evaluate()) & this->getBitvectorMask());
+      if (this->size <= 64)
+        this->setEval(((this->children[0]->evaluate64() * this->children[1]->evaluate64()) & triton::ast::mask64(this->size)));
+      else
+        this->setEval(((this->children[0]->evaluate() * this->children[1]->evaluate()) & this->getBitvectorMask()));
       this->level      = 1;
       this->symbolized = false;
 
@@ -585,13 +766,11 @@ namespace triton {
 
 
     void BvmulNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
-      for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * this->children[index]->getHash();
-      }
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
+      this->hash = triton::ast::hashCombine(this->hash, triton::ast::hashUnordered(this->children));
 
       this->hash = triton::ast::rotl(this->hash, this->level);
     }
@@ -615,7 +794,7 @@ namespace triton {
 
       /* Init attributes */
       this->size       = this->children[0]->getBitvectorSize();
-      this->eval       = (~(this->children[0]->evaluate() & this->children[1]->evaluate()) & this->getBitvectorMask());
+      this->setEval((~(this->children[0]->evaluate() & this->children[1]->evaluate()) & this->getBitvectorMask()));
       this->level      = 1;
       this->symbolized = false;
 
@@ -636,13 +815,11 @@ namespace triton {
 
 
     void BvnandNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
-      for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * this->children[index]->getHash();
-      }
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
+      this->hash = triton::ast::hashCombine(this->hash, triton::ast::hashUnordered(this->children));
 
       this->hash = triton::ast::rotl(this->hash, this->level);
     }
@@ -662,7 +839,10 @@ namespace triton {
 
       /* Init attributes */
       this->size       = this->children[0]->getBitvectorSize();
-      this->eval       = ((-(this->children[0]->evaluate().convert_to<triton::sint512>())).convert_to<triton::uint512>() & this->getBitvectorMask());
+      if (this->size <= 64)
+        this->setEval(((~this->children[0]->evaluate64() + 1) & triton::ast::mask64(this->size)));
+      else
+        this->setEval(((-(this->children[0]->evaluate().convert_to<triton::sint512>())).convert_to<triton::uint512>() & this->getBitvectorMask()));
       this->level      = 1;
       this->symbolized = false;
 
@@ -683,13 +863,11 @@ namespace triton {
 
 
     void BvnegNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
-      for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * this->children[index]->getHash();
-      }
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
+      this->hash = triton::ast::hashCombine(this->hash, triton::ast::hashUnordered(this->children));
 
       this->hash = triton::ast::rotl(this->hash, this->level);
     }
@@ -713,7 +891,7 @@ namespace triton {
 
       /* Init attributes */
       this->size       = this->children[0]->getBitvectorSize();
-      this->eval       = (~(this->children[0]->evaluate() | this->children[1]->evaluate()) & this->getBitvectorMask());
+      this->setEval((~(this->children[0]->evaluate() | this->children[1]->evaluate()) & this->getBitvectorMask()));
       this->level      = 1;
       this->symbolized = false;
 
@@ -734,13 +912,11 @@ namespace triton {
 
 
     void BvnorNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
-      for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * this->children[index]->getHash();
-      }
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
+      this->hash = triton::ast::hashCombine(this->hash, triton::ast::hashUnordered(this->children));
 
       this->hash = triton::ast::rotl(this->hash, this->level);
     }
@@ -760,7 +936,10 @@ namespace triton {
 
       /* Init attributes */
       this->size       = this->children[0]->getBitvectorSize();
-      this->eval       = (~this->children[0]->evaluate() & this->getBitvectorMask());
+      if (this->size <= 64)
+        this->setEval((~this->children[0]->evaluate64() & triton::ast::mask64(this->size)));
+      else
+        this->setEval((~this->children[0]->evaluate() & this->getBitvectorMask()));
       this->level      = 1;
       this->symbolized = false;
 
@@ -781,13 +960,11 @@ namespace triton {
 
 
     void BvnotNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
-      for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * this->children[index]->getHash();
-      }
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
+      this->hash = triton::ast::hashCombine(this->hash, triton::ast::hashUnordered(this->children));
 
       this->hash = triton::ast::rotl(this->hash, this->level);
     }
@@ -811,7 +988,10 @@ namespace triton {
 
       /* Init attributes */
       this->size       = this->children[0]->getBitvectorSize();
-      this->eval       = (this->children[0]->evaluate() | this->children[1]->evaluate());
+      if (this->size <= 64)
+        this->setEval((this->children[0]->evaluate64() | this->children[1]->evaluate64()));
+      else
+        this->setEval((this->children[0]->evaluate() | this->children[1]->evaluate()));
       this->level      = 1;
       this->symbolized = false;
 
@@ -832,13 +1012,11 @@ namespace triton {
 
 
     void BvorNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
-      for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * this->children[index]->getHash();
-      }
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
+      this->hash = triton::ast::hashCombine(this->hash, triton::ast::hashUnordered(this->children));
 
       this->hash = triton::ast::rotl(this->hash, this->level);
     }
@@ -873,7 +1051,7 @@ namespace triton {
       /* Init attributes */
       this->size       = this->children[0]->getBitvectorSize();
       rot             %= this->size;
-      this->eval       = (((value << rot) | (value >> (this->size - rot))) & this->getBitvectorMask());
+      this->setEval((((value << rot) | (value >> (this->size - rot))) & this->getBitvectorMask()));
       this->level      = 1;
       this->symbolized = false;
 
@@ -894,12 +1072,12 @@ namespace triton {
 
 
     void BvrolNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * triton::ast::hash2n(this->children[index]->getHash(), index+1);
+        this->hash = triton::ast::hashCombine(this->hash, this->children[index]->getHash());
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -935,7 +1113,7 @@ namespace triton {
       /* Init attributes */
       this->size       = this->children[0]->getBitvectorSize();
       rot             %= this->size;
-      this->eval       = (((value >> rot) | (value << (this->size - rot))) & this->getBitvectorMask());
+      this->setEval((((value >> rot) | (value << (this->size - rot))) & this->getBitvectorMask()));
       this->level      = 1;
       this->symbolized = false;
 
@@ -956,12 +1134,12 @@ namespace triton {
 
 
     void BvrorNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * triton::ast::hash2n(this->children[index]->getHash(), index+1);
+        this->hash = triton::ast::hashCombine(this->hash, this->children[index]->getHash());
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -997,11 +1175,10 @@ namespace triton {
       this->symbolized = false;
 
       if (op2Signed == 0) {
-        this->eval = (op1Signed < 0 ? 1 : -1);
-        this->eval &= this->getBitvectorMask();
+        this->setEval(op1Signed < 0 ? triton::uint512(1) : this->getBitvectorMask());
       }
       else
-        this->eval = ((op1Signed / op2Signed).convert_to<triton::uint512>() & this->getBitvectorMask());
+        this->setEval(((op1Signed / op2Signed).convert_to<triton::uint512>() & this->getBitvectorMask()));
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -1020,12 +1197,12 @@ namespace triton {
 
 
     void BvsdivNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * triton::ast::hash2n(this->children[index]->getHash(), index+1);
+        this->hash = triton::ast::hashCombine(this->hash, this->children[index]->getHash());
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -1057,7 +1234,7 @@ namespace triton {
 
       /* Init attributes */
       this->size       = 1;
-      this->eval       = (op1Signed >= op2Signed);
+      this->setEval((op1Signed >= op2Signed));
       this->level      = 1;
       this->symbolized = false;
 
@@ -1078,12 +1255,12 @@ namespace triton {
 
 
     void BvsgeNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * triton::ast::hash2n(this->children[index]->getHash(), index+1);
+        this->hash = triton::ast::hashCombine(this->hash, this->children[index]->getHash());
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -1115,7 +1292,7 @@ namespace triton {
 
       /* Init attributes */
       this->size       = 1;
-      this->eval       = (op1Signed > op2Signed);
+      this->setEval((op1Signed > op2Signed));
       this->level      = 1;
       this->symbolized = false;
 
@@ -1136,12 +1313,12 @@ namespace triton {
 
 
     void BvsgtNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * triton::ast::hash2n(this->children[index]->getHash(), index+1);
+        this->hash = triton::ast::hashCombine(this->hash, this->children[index]->getHash());
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -1166,7 +1343,12 @@ namespace triton {
 
       /* Init attributes */
       this->size       = this->children[0]->getBitvectorSize();
-      this->eval       = ((this->children[0]->evaluate() << this->children[1]->evaluate().convert_to<triton::uint32>()) & this->getBitvectorMask());
+      if (this->children[1]->evaluate() >= this->size)
+        this->setEval(0);
+      else if (this->size <= 64)
+        this->setEval(((this->children[0]->evaluate64() << this->children[1]->evaluate64()) & triton::ast::mask64(this->size)));
+      else
+        this->setEval(((this->children[0]->evaluate() << this->children[1]->evaluate().convert_to<triton::uint32>()) & this->getBitvectorMask()));
       this->level      = 1;
       this->symbolized = false;
 
@@ -1187,12 +1369,12 @@ namespace triton {
 
 
     void BvshlNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * triton::ast::hash2n(this->children[index]->getHash(), index+1);
+        this->hash = triton::ast::hashCombine(this->hash, this->children[index]->getHash());
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -1224,7 +1406,7 @@ namespace triton {
 
       /* Init attributes */
       this->size       = 1;
-      this->eval       = (op1Signed <= op2Signed);
+      this->setEval((op1Signed <= op2Signed));
       this->level      = 1;
       this->symbolized = false;
 
@@ -1245,12 +1427,12 @@ namespace triton {
 
 
     void BvsleNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * triton::ast::hash2n(this->children[index]->getHash(), index+1);
+        this->hash = triton::ast::hashCombine(this->hash, this->children[index]->getHash());
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -1282,7 +1464,7 @@ namespace triton {
 
       /* Init attributes */
       this->size       = 1;
-      this->eval       = (op1Signed < op2Signed);
+      this->setEval((op1Signed < op2Signed));
       this->level      = 1;
       this->symbolized = false;
 
@@ -1303,12 +1485,12 @@ namespace triton {
 
 
     void BvsltNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * triton::ast::hash2n(this->children[index]->getHash(), index+1);
+        this->hash = triton::ast::hashCombine(this->hash, this->children[index]->getHash());
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -1344,9 +1526,9 @@ namespace triton {
       this->symbolized = false;
 
       if (this->children[1]->evaluate() == 0)
-        this->eval = this->children[0]->evaluate();
+        this->setEval(this->children[0]->evaluate());
       else
-        this->eval = ((((op1Signed % op2Signed) + op2Signed) % op2Signed).convert_to<triton::uint512>() & this->getBitvectorMask());
+        this->setEval(((((op1Signed % op2Signed) + op2Signed) % op2Signed).convert_to<triton::uint512>() & this->getBitvectorMask()));
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -1365,12 +1547,12 @@ namespace triton {
 
 
     void BvsmodNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * triton::ast::hash2n(this->children[index]->getHash(), index+1);
+        this->hash = triton::ast::hashCombine(this->hash, this->children[index]->getHash());
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -1406,9 +1588,9 @@ namespace triton {
       this->symbolized = false;
 
       if (this->children[1]->evaluate() == 0)
-        this->eval = this->children[0]->evaluate();
+        this->setEval(this->children[0]->evaluate());
       else
-        this->eval = ((op1Signed - ((op1Signed / op2Signed) * op2Signed)).convert_to<triton::uint512>() & this->getBitvectorMask());
+        this->setEval(((op1Signed - ((op1Signed / op2Signed) * op2Signed)).convert_to<triton::uint512>() & this->getBitvectorMask()));
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -1427,12 +1609,12 @@ namespace triton {
 
 
     void BvsremNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * triton::ast::hash2n(this->children[index]->getHash(), index+1);
+        this->hash = triton::ast::hashCombine(this->hash, this->children[index]->getHash());
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -1457,7 +1639,10 @@ namespace triton {
 
       /* Init attributes */
       this->size       = this->children[0]->getBitvectorSize();
-      this->eval       = ((this->children[0]->evaluate() - this->children[1]->evaluate()) & this->getBitvectorMask());
+      if (this->size <= 64)
+        this->setEval(((this->children[0]->evaluate64() - this->children[1]->evaluate64()) & triton::ast::mask64(this->size)));
+      else
+        this->setEval(((this->children[0]->evaluate() - this->children[1]->evaluate()) & this->getBitvectorMask()));
       this->level      = 1;
       this->symbolized = false;
 
@@ -1478,12 +1663,12 @@ namespace triton {
 
 
     void BvsubNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * triton::ast::hash2n(this->children[index]->getHash(), index+1);
+        this->hash = triton::ast::hashCombine(this->hash, this->children[index]->getHash());
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -1512,9 +1697,9 @@ namespace triton {
       this->symbolized = false;
 
       if (this->children[1]->evaluate() == 0)
-        this->eval = (-1 & this->getBitvectorMask());
+        this->setEval((-1 & this->getBitvectorMask()));
       else
-        this->eval = (this->children[0]->evaluate() / this->children[1]->evaluate());
+        this->setEval((this->children[0]->evaluate() / this->children[1]->evaluate()));
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -1533,12 +1718,12 @@ namespace triton {
 
 
     void BvudivNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * triton::ast::hash2n(this->children[index]->getHash(), index+1);
+        this->hash = triton::ast::hashCombine(this->hash, this->children[index]->getHash());
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -1563,7 +1748,7 @@ namespace triton {
 
       /* Init attributes */
       this->size       = 1;
-      this->eval       = (this->children[0]->evaluate() >= this->children[1]->evaluate());
+      this->setEval((this->children[0]->evaluate() >= this->children[1]->evaluate()));
       this->level      = 1;
       this->symbolized = false;
 
@@ -1584,12 +1769,12 @@ namespace triton {
 
 
     void BvugeNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * triton::ast::hash2n(this->children[index]->getHash(), index+1);
+        this->hash = triton::ast::hashCombine(this->hash, this->children[index]->getHash());
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -1614,7 +1799,7 @@ namespace triton {
 
       /* Init attributes */
       this->size       = 1;
-      this->eval       = (this->children[0]->evaluate() > this->children[1]->evaluate());
+      this->setEval((this->children[0]->evaluate() > this->children[1]->evaluate()));
       this->level      = 1;
       this->symbolized = false;
 
@@ -1635,12 +1820,12 @@ namespace triton {
 
 
     void BvugtNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * triton::ast::hash2n(this->children[index]->getHash(), index+1);
+        this->hash = triton::ast::hashCombine(this->hash, this->children[index]->getHash());
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -1665,7 +1850,7 @@ namespace triton {
 
       /* Init attributes */
       this->size       = 1;
-      this->eval       = (this->children[0]->evaluate() <= this->children[1]->evaluate());
+      this->setEval((this->children[0]->evaluate() <= this->children[1]->evaluate()));
       this->level      = 1;
       this->symbolized = false;
 
@@ -1686,12 +1871,12 @@ namespace triton {
 
 
     void BvuleNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * triton::ast::hash2n(this->children[index]->getHash(), index+1);
+        this->hash = triton::ast::hashCombine(this->hash, this->children[index]->getHash());
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -1716,7 +1901,7 @@ namespace triton {
 
       /* Init attributes */
       this->size       = 1;
-      this->eval       = (this->children[0]->evaluate() < this->children[1]->evaluate());
+      this->setEval((this->children[0]->evaluate() < this->children[1]->evaluate()));
       this->level      = 1;
       this->symbolized = false;
 
@@ -1737,12 +1922,12 @@ namespace triton {
 
 
     void BvultNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * triton::ast::hash2n(this->children[index]->getHash(), index+1);
+        this->hash = triton::ast::hashCombine(this->hash, this->children[index]->getHash());
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -1771,9 +1956,9 @@ namespace triton {
       this->symbolized = false;
 
       if (this->children[1]->evaluate() == 0)
-        this->eval = this->children[0]->evaluate();
+        this->setEval(this->children[0]->evaluate());
       else
-        this->eval = (this->children[0]->evaluate() % this->children[1]->evaluate());
+        this->setEval((this->children[0]->evaluate() % this->children[1]->evaluate()));
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -1792,12 +1977,12 @@ namespace triton {
 
 
     void BvuremNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * triton::ast::hash2n(this->children[index]->getHash(), index+1);
+        this->hash = triton::ast::hashCombine(this->hash, this->children[index]->getHash());
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -1822,7 +2007,7 @@ namespace triton {
 
       /* Init attributes */
       this->size       = this->children[0]->getBitvectorSize();
-      this->eval       = (~(this->children[0]->evaluate() ^ this->children[1]->evaluate()) & this->getBitvectorMask());
+      this->setEval((~(this->children[0]->evaluate() ^ this->children[1]->evaluate()) & this->getBitvectorMask()));
       this->level      = 1;
       this->symbolized = false;
 
@@ -1843,13 +2028,11 @@ namespace triton {
 
 
     void BvxnorNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
-      for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * this->children[index]->getHash();
-      }
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
+      this->hash = triton::ast::hashCombine(this->hash, triton::ast::hashUnordered(this->children));
 
       this->hash = triton::ast::rotl(this->hash, this->level);
     }
@@ -1873,7 +2056,10 @@ namespace triton {
 
       /* Init attributes */
       this->size       = this->children[0]->getBitvectorSize();
-      this->eval       = (this->children[0]->evaluate() ^ this->children[1]->evaluate());
+      if (this->size <= 64)
+        this->setEval((this->children[0]->evaluate64() ^ this->children[1]->evaluate64()));
+      else
+        this->setEval((this->children[0]->evaluate() ^ this->children[1]->evaluate()));
       this->level      = 1;
       this->symbolized = false;
 
@@ -1894,13 +2080,11 @@ namespace triton {
 
 
     void BvxorNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
-      for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * this->children[index]->getHash();
-      }
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
+      this->hash = triton::ast::hashCombine(this->hash, triton::ast::hashUnordered(this->children));
 
       this->hash = triton::ast::rotl(this->hash, this->level);
     }
@@ -1937,7 +2121,7 @@ namespace triton {
 
       /* Init attributes */
       this->size       = size;
-      this->eval       = (value & this->getBitvectorMask());
+      this->setEval((value & this->getBitvectorMask()));
       this->level      = 1;
       this->symbolized = false;
 
@@ -1958,12 +2142,12 @@ namespace triton {
 
 
     void BvNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * triton::ast::hash2n(this->children[index]->getHash(), index+1);
+        this->hash = triton::ast::hashCombine(this->hash, this->children[index]->getHash());
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -1978,7 +2162,7 @@ namespace triton {
         throw triton::exceptions::Ast("CompoundNode::init(): Must take at least one child.");
 
       /* Init attributes */
-      this->eval       = 0;
+      this->setEval(0);
       this->size       = 0;
       this->level      = 1;
       this->symbolized = false;
@@ -2000,12 +2184,12 @@ namespace triton {
 
 
     void CompoundNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * triton::ast::hash2n(this->children[index]->getHash(), index+1);
+        this->hash = triton::ast::hashCombine(this->hash, this->children[index]->getHash());
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -2036,9 +2220,18 @@ namespace triton {
       if (this->size > triton::bitsize::max_supported)
         throw triton::exceptions::Ast("ConcatNode::init(): Size cannot be greater than triton::bitsize::max_supported.");
 
-      this->eval = this->children[0]->evaluate();
-      for (triton::uint32 index = 0; index < this->children.size()-1; index++)
-        this->eval = ((this->eval << this->children[index+1]->getBitvectorSize()) | this->children[index+1]->evaluate());
+      if (this->size <= 64) {
+        triton::uint64 value = this->children[0]->evaluate64();
+        for (triton::uint32 index = 0; index < this->children.size()-1; index++)
+          value = ((value << this->children[index+1]->getBitvectorSize()) | this->children[index+1]->evaluate64());
+        this->setEval(value);
+      }
+      else {
+        triton::uint512 value = this->children[0]->evaluate();
+        for (triton::uint32 index = 0; index < this->children.size()-1; index++)
+          value = ((value << this->children[index+1]->getBitvectorSize()) | this->children[index+1]->evaluate());
+        this->setEval(value);
+      }
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -2057,12 +2250,12 @@ namespace triton {
 
 
     void ConcatNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * triton::ast::hash2n(this->children[index]->getHash(), index+1);
+        this->hash = triton::ast::hashCombine(this->hash, this->children[index]->getHash());
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -2086,7 +2279,7 @@ namespace triton {
 
       /* Init attributes */
       this->size       = this->children[0]->getBitvectorSize();
-      this->eval       = this->children[0]->evaluate();
+      this->setEval(this->children[0]->evaluate());
       this->level      = 1;
       this->symbolized = false;
 
@@ -2107,12 +2300,12 @@ namespace triton {
 
 
     void DeclareNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * triton::ast::hash2n(this->children[index]->getHash(), index+1);
+        this->hash = triton::ast::hashCombine(this->hash, this->children[index]->getHash());
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -2137,7 +2330,7 @@ namespace triton {
 
       /* Init attributes */
       this->size       = 1;
-      this->eval       = (this->children[0]->evaluate() != this->children[1]->evaluate());
+      this->setEval((this->children[0]->evaluate() != this->children[1]->evaluate()));
       this->level      = 1;
       this->symbolized = false;
 
@@ -2158,13 +2351,11 @@ namespace triton {
 
 
     void DistinctNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
-      for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * this->children[index]->getHash();
-      }
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
+      this->hash = triton::ast::hashCombine(this->hash, triton::ast::hashUnordered(this->children));
 
       this->hash = triton::ast::rotl(this->hash, this->level);
     }
@@ -2188,7 +2379,7 @@ namespace triton {
 
       /* Init attributes */
       this->size       = 1;
-      this->eval       = (this->children[0]->evaluate() == this->children[1]->evaluate());
+      this->setEval((this->children[0]->evaluate() == this->children[1]->evaluate()));
       this->level      = 1;
       this->symbolized = false;
 
@@ -2209,13 +2400,11 @@ namespace triton {
 
 
     void EqualNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
-      for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * this->children[index]->getHash();
-      }
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
+      this->hash = triton::ast::hashCombine(this->hash, triton::ast::hashUnordered(this->children));
 
       this->hash = triton::ast::rotl(this->hash, this->level);
     }
@@ -2249,7 +2438,10 @@ namespace triton {
 
       /* Init attributes */
       this->size       = ((high - low) + 1);
-      this->eval       = ((this->children[2]->evaluate() >> low) & this->getBitvectorMask());
+      if (this->children[2]->getBitvectorSize() <= 64)
+        this->setEval(((this->children[2]->evaluate64() >> low) & triton::ast::mask64(this->size)));
+      else
+        this->setEval(((this->children[2]->evaluate() >> low) & this->getBitvectorMask()));
       this->level      = 1;
       this->symbolized = false;
 
@@ -2273,12 +2465,12 @@ namespace triton {
 
 
     void ExtractNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * triton::ast::hash2n(this->children[index]->getHash(), index+1);
+        this->hash = triton::ast::hashCombine(this->hash, this->children[index]->getHash());
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -2303,7 +2495,7 @@ namespace triton {
         throw triton::exceptions::Ast("ForallNode::init(): Must take a logical node as body.");
 
       this->size       = 1;
-      this->eval       = 0;
+      this->setEval(0);
       this->level      = 1;
       this->symbolized = false;
 
@@ -2324,12 +2516,12 @@ namespace triton {
 
 
     void ForallNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * triton::ast::hash2n(this->children[index]->getHash(), index+1);
+        this->hash = triton::ast::hashCombine(this->hash, this->children[index]->getHash());
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -2360,7 +2552,7 @@ namespace triton {
       triton::uint512 Q = this->children[1]->evaluate();
 
       this->size       = 1;
-      this->eval       = (P && Q) || (!P && !Q);
+      this->setEval((P && Q) || (!P && !Q));
       this->level      = 1;
       this->symbolized = false;
 
@@ -2381,12 +2573,12 @@ namespace triton {
 
 
     void IffNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * triton::ast::hash2n(this->children[index]->getHash(), index+1);
+        this->hash = triton::ast::hashCombine(this->hash, this->children[index]->getHash());
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -2403,7 +2595,7 @@ namespace triton {
 
     void IntegerNode::init(bool withParents) {
       /* Init attributes */
-      this->eval        = 0;
+      this->setEval(0);
       this->size        = 0;
       this->level       = 1;
       this->symbolized  = false;
@@ -2423,7 +2615,10 @@ namespace triton {
 
 
     void IntegerNode::initHash(void) {
-      this->hash = static_cast<triton::uint64>(this->type) ^ this->value;
+      this->hash = static_cast<triton::uint64>(this->type);
+      for (triton::uint512 value = this->value; value != 0; value >>= 64) {
+        this->hash = triton::ast::hash2n(this->hash ^ static_cast<triton::uint64>(value), 1);
+      }
     }
 
 
@@ -2452,7 +2647,7 @@ namespace triton {
 
       /* Init attributes */
       this->size       = this->children[1]->getBitvectorSize();
-      this->eval       = this->children[0]->evaluate() ? this->children[1]->evaluate() : this->children[2]->evaluate();
+      this->setEval(this->children[0]->evaluate() ? this->children[1]->evaluate() : this->children[2]->evaluate());
       this->logical    = this->children[1]->isLogical();
       this->level      = 1;
       this->symbolized = false;
@@ -2474,12 +2669,12 @@ namespace triton {
 
 
     void IteNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * triton::ast::hash2n(this->children[index]->getHash(), index+1);
+        this->hash = triton::ast::hashCombine(this->hash, this->children[index]->getHash());
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -2501,7 +2696,7 @@ namespace triton {
 
       /* Init attributes */
       this->size       = 1;
-      this->eval       = 1;
+      this->setEval(1);
       this->level      = 1;
       this->symbolized = false;
 
@@ -2509,7 +2704,7 @@ namespace triton {
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
         this->children[index]->setParent(this);
         this->symbolized |= this->children[index]->isSymbolized();
-        this->eval = this->eval && this->children[index]->evaluate();
+        this->setEval(this->eval && this->children[index]->evaluate());
         this->level = std::max(this->children[index]->getLevel() + 1, this->level);
 
         if (this->children[index]->isLogical() == false)
@@ -2526,13 +2721,11 @@ namespace triton {
 
 
     void LandNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
-      for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * this->children[index]->getHash();
-      }
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
+      this->hash = triton::ast::hashCombine(this->hash, triton::ast::hashUnordered(this->children));
 
       this->hash = triton::ast::rotl(this->hash, this->level);
     }
@@ -2557,7 +2750,7 @@ namespace triton {
 
       /* Init attributes */
       this->size       = this->children[2]->getBitvectorSize();
-      this->eval       = this->children[2]->evaluate();
+      this->setEval(this->children[2]->evaluate());
       this->level      = 1;
       this->symbolized = false;
 
@@ -2578,12 +2771,12 @@ namespace triton {
 
 
     void LetNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * triton::ast::hash2n(this->children[index]->getHash(), index+1);
+        this->hash = triton::ast::hashCombine(this->hash, this->children[index]->getHash());
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -2604,7 +2797,7 @@ namespace triton {
 
       /* Init attributes */
       this->size       = 1;
-      this->eval       = !(this->children[0]->evaluate());
+      this->setEval(!(this->children[0]->evaluate()));
       this->level      = 1;
       this->symbolized = false;
 
@@ -2628,13 +2821,11 @@ namespace triton {
 
 
     void LnotNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
-      for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * this->children[index]->getHash();
-      }
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
+      this->hash = triton::ast::hashCombine(this->hash, triton::ast::hashUnordered(this->children));
 
       this->hash = triton::ast::rotl(this->hash, this->level);
     }
@@ -2655,7 +2846,7 @@ namespace triton {
 
       /* Init attributes */
       this->size       = 1;
-      this->eval       = 0;
+      this->setEval(0);
       this->level      = 1;
       this->symbolized = false;
 
@@ -2663,7 +2854,7 @@ namespace triton {
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
         this->children[index]->setParent(this);
         this->symbolized |= this->children[index]->isSymbolized();
-        this->eval = this->eval || this->children[index]->evaluate();
+        this->setEval(this->eval || this->children[index]->evaluate());
         this->level = std::max(this->children[index]->getLevel() + 1, this->level);
 
         if (this->children[index]->isLogical() == false)
@@ -2680,13 +2871,11 @@ namespace triton {
 
 
     void LorNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
-      for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * this->children[index]->getHash();
-      }
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
+      this->hash = triton::ast::hashCombine(this->hash, triton::ast::hashUnordered(this->children));
 
       this->hash = triton::ast::rotl(this->hash, this->level);
     }
@@ -2707,7 +2896,7 @@ namespace triton {
 
       /* Init attributes */
       this->size       = 1;
-      this->eval       = 0;
+      this->setEval(0);
       this->level      = 1;
       this->symbolized = false;
 
@@ -2715,7 +2904,7 @@ namespace triton {
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
         this->children[index]->setParent(this);
         this->symbolized |= this->children[index]->isSymbolized();
-        this->eval = !this->eval != !this->children[index]->evaluate();
+        this->setEval(!this->eval != !this->children[index]->evaluate());
         this->level = std::max(this->children[index]->getLevel() + 1, this->level);
 
         if (this->children[index]->isLogical() == false)
@@ -2732,13 +2921,11 @@ namespace triton {
 
 
     void LxorNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
-      for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * this->children[index]->getHash();
-      }
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
+      this->hash = triton::ast::hashCombine(this->hash, triton::ast::hashUnordered(this->children));
 
       this->hash = triton::ast::rotl(this->hash, this->level);
     }
@@ -2755,7 +2942,7 @@ namespace triton {
 
     void ReferenceNode::init(bool withParents) {
       /* Init attributes */
-      this->eval        = this->expr->getAst()->evaluate();
+      this->setEval(this->expr->getAst()->evaluate());
       this->logical     = this->expr->getAst()->isLogical();
       this->size        = this->expr->getAst()->getBitvectorSize();
       this->symbolized  = this->expr->getAst()->isSymbolized();
@@ -2792,7 +2979,7 @@ namespace triton {
 
     void StringNode::init(bool withParents) {
       /* Init attributes */
-      this->eval        = 0;
+      this->setEval(0);
       this->size        = 0;
       this->level       = 1;
       this->symbolized  = false;
@@ -2850,8 +3037,8 @@ namespace triton {
 
       this->level      = 1;
       this->symbolized = false;
-      this->eval       = ((((this->children[1]->evaluate() >> (this->children[1]->getBitvectorSize()-1)) == 0) ?
-                          this->children[1]->evaluate() : (this->children[1]->evaluate() | ~(this->children[1]->getBitvectorMask()))) & this->getBitvectorMask());
+      this->setEval(((((this->children[1]->evaluate() >> (this->children[1]->getBitvectorSize()-1)) == 0) ?
+                          this->children[1]->evaluate() : (this->children[1]->evaluate() | ~(this->children[1]->getBitvectorMask()))) & this->getBitvectorMask()));
 
       /* Init children and spread information */
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
@@ -2870,12 +3057,12 @@ namespace triton {
 
 
     void SxNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * triton::ast::hash2n(this->children[index]->getHash(), index+1);
+        this->hash = triton::ast::hashCombine(this->hash, this->children[index]->getHash());
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -2893,7 +3080,7 @@ namespace triton {
 
     void VariableNode::init(bool withParents) {
       this->size        = this->symVar->getSize();
-      this->eval        = this->ctxt->getVariableValue(this->symVar->getName()) & this->getBitvectorMask();
+      this->setEval(this->ctxt->getVariableValue(this->symVar->getName()) & this->getBitvectorMask());
       this->symbolized  = true;
       this->level       = 1;
 
@@ -2917,7 +3104,7 @@ namespace triton {
 
       this->hash = static_cast<triton::uint64>(this->type);
       for (char c : this->symVar->getName()) {
-        this->hash = triton::ast::rotl(c ^ this->hash ^ triton::ast::hash2n(this->hash, index++), (id & 511));
+        this->hash = triton::ast::rotl(c ^ this->hash ^ triton::ast::hash2n(this->hash, index++), (id & 63));
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -2949,7 +3136,10 @@ namespace triton {
       if (size > triton::bitsize::max_supported)
         throw triton::exceptions::Ast("ZxNode::init(): Size cannot be greater than triton::bitsize::max_supported.");
 
-      this->eval       = (this->children[1]->evaluate() & this->getBitvectorMask());
+      if (this->size <= 64)
+        this->setEval(this->children[1]->evaluate64());
+      else
+        this->setEval((this->children[1]->evaluate() & this->getBitvectorMask()));
       this->level      = 1;
       this->symbolized = false;
 
@@ -2970,12 +3160,12 @@ namespace triton {
 
 
     void ZxNode::initHash(void) {
-      triton::uint512 s = this->children.size();
+      triton::uint64 s = this->children.size();
 
       this->hash = static_cast<triton::uint64>(this->type);
-      if (s) this->hash = this->hash * s;
+      if (s) this->hash = triton::ast::hashCombine(this->hash, s);
       for (triton::uint32 index = 0; index < this->children.size(); index++) {
-        this->hash = this->hash * triton::ast::hash2n(this->children[index]->getHash(), index+1);
+        this->hash = triton::ast::hashCombine(this->hash, this->children[index]->getHash());
       }
 
       this->hash = triton::ast::rotl(this->hash, this->level);
@@ -3029,18 +3219,55 @@ namespace triton {
 namespace triton {
   namespace ast {
 
-    triton::uint512 hash2n(triton::uint512 hash, triton::uint32 n) {
-      triton::uint512 mask = -1;
-      for (triton::uint32 i = 0; i < n; i++)
-        hash = ((hash * hash) & mask);
+    triton::uint64 hash2n(triton::uint64 hash, triton::uint32 n) {
+      /* Mixes the hash with its position (splitmix64 finalizer) */
+      hash += n * 0x9e3779b97f4a7c15;
+      hash  = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9;
+      hash  = (hash ^ (hash >> 27)) * 0x94d049bb133111eb;
+      return hash ^ (hash >> 31);
+    }
+
+
+    triton::uint64 hashCombine(triton::uint64 seed, triton::uint64 value) {
+      /* Order sensitive, each step goes through the splitmix64 finalizer */
+      return triton::ast::hash2n(triton::ast::rotl(seed, 23) ^ value, 1);
+    }
+
+
+    triton::uint64 hashUnordered(const std::vector<SharedAbstractNode>& nodes) {
+      triton::uint64 hash = 0;
+
+      /* Hashes are combined in ascending order, so the order of the nodes does not matter */
+      if (nodes.size() == 2) {
+        triton::uint64 a = nodes[0]->getHash();
+        triton::uint64 b = nodes[1]->getHash();
+        return triton::ast::hashCombine(triton::ast::hashCombine(hash, std::min(a, b)), std::max(a, b));
+      }
+
+      std::vector<triton::uint64> hashes;
+      hashes.reserve(nodes.size());
+      for (const SharedAbstractNode& node : nodes)
+        hashes.push_back(node->getHash());
+      std::sort(hashes.begin(), hashes.end());
+
+      for (triton::uint64 h : hashes)
+        hash = triton::ast::hashCombine(hash, h);
+
       return hash;
     }
 
 
-    triton::uint512 rotl(const triton::uint512& value, triton::uint32 shift) {
-      if ((shift &= 511) == 0)
+    triton::uint64 rotl(triton::uint64 value, triton::uint32 shift) {
+      if ((shift &= 63) == 0)
         return value;
-      return ((value << shift) | (value >> (512 - shift)));
+      return ((value << shift) | (value >> (64 - shift)));
+    }
+
+
+    triton::uint64 mask64(triton::uint32 size) {
+      if (size >= 64)
+        return 0xffffffffffffffff;
+      return ((static_cast<triton::uint64>(1) << size) - 1);
     }
 
 
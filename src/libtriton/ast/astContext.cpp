@@ -5,12 +5,20 @@
 **  This program is under the terms of the Apache License 2.0.
 */
 
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
 #include <list>
 #include <memory>
+#include <new>
+#include <set>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include <triton/ast.hpp>
 #include <triton/astContext.hpp>
+#include <triton/cpuSize.hpp>
 #include <triton/exceptions.hpp>
 #include <triton/symbolicExpression.hpp>
 #include <triton/symbolicVariable.hpp>
@@ -22,12 +30,22 @@ namespace triton {
 
     AstContext::AstContext(const triton::modes::SharedModes& modes)
       : modes(modes) {
+      this->uniqueTableSwept = 0;
+      this->oldNodesCursor   = 0;
+      this->epoch            = 0;
+      this->pool = new(std::nothrow) NodePool();
+      if (this->pool == nullptr)
+        throw triton::exceptions::Ast("AstContext::AstContext(): Not enough memory.");
     }
 
 
     AstContext::~AstContext() {
       this->valueMapping.clear();
-      this->nodes.clear();
+      this->uniqueTable.clear();
+      this->youngNodes.clear();
+      this->oldNodes.clear();
+      /* Slabs are released once the last node allocated from them is freed */
+      this->pool->release();
     }
 
 
@@ -37,42 +55,302 @@ namespace triton {
       this->astRepresentation = other.astRepresentation;
       this->modes             = other.modes;
       this->valueMapping      = other.valueMapping;
-      this->nodes             = other.nodes;
+      this->youngNodes        = other.youngNodes;
+      this->oldNodes          = other.oldNodes;
+      this->oldNodesCursor    = other.oldNodesCursor;
+      this->uniqueTable       = other.uniqueTable;
+      this->uniqueTableSwept  = other.uniqueTableSwept;
+      this->epoch             = other.epoch;
 
       return *this;
     }
 
 
     SharedAbstractNode AstContext::collect(const SharedAbstractNode& node) {
+      /* If hash-consing is enabled, returns the node already built with the same structure */
+      if (this->modes->isModeEnabled(triton::modes::AST_HASH_CONSING)) {
+        SharedAbstractNode interned = this->intern(node);
+        if (interned != node)
+          return interned;
+      }
+
       /*
        * We keep references to nodes which belong to a depth in the AST which is
-       * a multiple of 10000. Thus, when the root node is destroyed, the stack recursivity
+       * a multiple of 10000. Thus, when the root node is destroyed, the destruction
        * stops when the depth level of 10000 is reached, because the nodes there still
-       * have a reference to them in the AST manager. The destruction will continue at the
-       * next allocation of nodes and so on. So, it means that ASTs are destroyed by steps
-       * of depth of 10000 which avoids the overflow while keeping a good scale.
+       * have a reference to them in the AST manager. The destruction will continue at
+       * the next calls to garbage() and so on. So, it means that ASTs are destroyed by
+       * steps of depth of 10000 which avoids long pauses while keeping a good scale.
+       * Nodes are destroyed without recursion (see ~AbstractNode), so the depth of a
+       * step is not bounded by the stack.
        *
        * See: #753.
        */
       triton::uint32 lvl = node->getLevel();
       if (lvl != 0 && (lvl % 10000) == 0) {
-        this->nodes.push_front(node);
+        this->youngNodes.push_back(node);
       }
       return node;
     }
 
 
     void AstContext::garbage(void) {
-      this->nodes.erase(std::remove_if(this->nodes.begin(), this->nodes.end(),
-        [](const SharedAbstractNode& n) {
-          return (n.use_count() == 1 ? true : false);
-        }), this->nodes.end()
-      );
+      /* Young nodes are released or promoted to the old generation */
+      for (SharedAbstractNode& node : this->youngNodes) {
+        if (node.use_count() != 1)
+          this->oldNodes.push_back(std::move(node));
+      }
+      this->youngNodes.clear();
+
+      /* Old nodes are swept by bounded steps, from where the last sweep stopped */
+      triton::usize budget = AstContext::garbageBudget;
+      while (budget-- && !this->oldNodes.empty()) {
+        if (this->oldNodesCursor >= this->oldNodes.size())
+          this->oldNodesCursor = 0;
+
+        if (this->oldNodes[this->oldNodesCursor].use_count() == 1) {
+          this->oldNodes[this->oldNodesCursor] = std::move(this->oldNodes.back());
+          this->oldNodes.pop_back();
+        }
+        else {
+          this->oldNodesCursor++;
+        }
+      }
+    }
+
+
+    bool AstContext::beginNodeScope(void) {
+      if (!this->modes->isModeEnabled(triton::modes::AST_SLAB_ALLOCATOR))
+        return false;
+      this->pool->beginScope();
+      return true;
+    }
+
+
+    void AstContext::endNodeScope(void) {
+      this->pool->endScope();
+    }
+
+
+    /* Mixes a value into a structural key */
+    static triton::uint64 mixKey(triton::uint64 key, triton::uint64 value) {
+      return key ^ (value + 0x9e3779b97f4a7c15 + (key << 6) + (key >> 2));
+    }
+
+
+    triton::uint64 AstContext::getStructuralKey(AbstractNode* node) const {
+      /* The size is not mixed, it only depends on the type, the payload and the children */
+      triton::uint64 key = static_cast<triton::uint64>(node->getType());
+
+      switch (node->getType()) {
+        case INTEGER_NODE:
+          key = mixKey(key, static_cast<triton::uint64>(reinterpret_cast<IntegerNode*>(node)->getInteger() & 0xffffffffffffffff));
+          break;
+
+        case REFERENCE_NODE:
+          key = mixKey(key, reinterpret_cast<triton::uint64>(reinterpret_cast<ReferenceNode*>(node)->getSymbolicExpression().get()));
+          break;
+
+        case STRING_NODE:
+          key = mixKey(key, std::hash<std::string>()(reinterpret_cast<StringNode*>(node)->getString()));
+          break;
+
+        default:
+          break;
+      }
+
+      for (const auto& child : node->getChildren()) {
+        key = mixKey(key, reinterpret_cast<triton::uint64>(child.get()));
+      }
+
+      return key;
+    }
+
+
+    /* Returns true if both nodes have the same type, size and payload */
+    static bool haveSamePayload(AbstractNode* node1, AbstractNode* node2) {
+      if (node1->getType() != node2->getType() || node1->getBitvectorSize() != node2->getBitvectorSize())
+        return false;
+
+      switch (node1->getType()) {
+        case INTEGER_NODE:
+          return reinterpret_cast<IntegerNode*>(node1)->getInteger() == reinterpret_cast<IntegerNode*>(node2)->getInteger();
+
+        case REFERENCE_NODE:
+          return reinterpret_cast<ReferenceNode*>(node1)->getSymbolicExpression() == reinterpret_cast<ReferenceNode*>(node2)->getSymbolicExpression();
+
+        case STRING_NODE:
+          return reinterpret_cast<StringNode*>(node1)->getString() == reinterpret_cast<StringNode*>(node2)->getString();
+
+        case VARIABLE_NODE:
+          return reinterpret_cast<VariableNode*>(node1)->getSymbolicVariable() == reinterpret_cast<VariableNode*>(node2)->getSymbolicVariable();
+
+        default:
+          return true;
+      }
+    }
+
+
+    bool AstContext::isStructurallyIdentical(AbstractNode* node1, AbstractNode* node2) const {
+      if (!haveSamePayload(node1, node2))
+        return false;
+
+      const auto& children1 = node1->getChildren();
+      const auto& children2 = node2->getChildren();
+
+      if (children1.size() != children2.size())
+        return false;
+
+      for (triton::usize index = 0; index < children1.size(); index++) {
+        if (children1[index] != children2[index])
+          return false;
+      }
+
+      return true;
+    }
+
+
+    bool AstContext::isStructurallyIdentical(const SharedAbstractNode& node1, const SharedAbstractNode& node2) const {
+      std::vector<std::pair<AbstractNode*, AbstractNode*>> worklist;
+      std::set<std::pair<AbstractNode*, AbstractNode*>> visited;
+
+      worklist.push_back(std::make_pair(node1.get(), node2.get()));
+      while (!worklist.empty()) {
+        auto pair = worklist.back();
+        worklist.pop_back();
+
+        /* Shared subtrees are identical, and two distinct subtrees are only compared once */
+        if (pair.first == pair.second || !visited.insert(pair).second)
+          continue;
+
+        if (pair.first->getHash() != pair.second->getHash())
+          return false;
+
+        /* Two references are identical if their expressions are */
+        if (pair.first->getType() == REFERENCE_NODE && pair.second->getType() == REFERENCE_NODE) {
+          worklist.push_back(std::make_pair(
+            reinterpret_cast<ReferenceNode*>(pair.first)->getSymbolicExpression()->getAst().get(),
+            reinterpret_cast<ReferenceNode*>(pair.second)->getSymbolicExpression()->getAst().get()
+          ));
+          continue;
+        }
+
+        if (!haveSamePayload(pair.first, pair.second))
+          return false;
+
+        const auto& children1 = pair.first->getChildren();
+        const auto& children2 = pair.second->getChildren();
+
+        if (children1.size() != children2.size())
+          return false;
+
+        for (triton::usize index = 0; index < children1.size(); index++) {
+          worklist.push_back(std::make_pair(children1[index].get(), children2[index].get()));
+        }
+      }
+
+      return true;
+    }
+
+
+    template <typename Match>
+    SharedAbstractNode AstContext::findInterned(triton::uint64 key, const Match& match) {
+      auto range = this->uniqueTable.equal_range(key);
+
+      for (auto it = range.first; it != range.second;) {
+        SharedAbstractNode candidate = it->second.lock();
+        if (candidate == nullptr) {
+          it = this->uniqueTable.erase(it);
+          continue;
+        }
+        /*
+         * The candidate may have been modified in place since it has been
+         * interned (e.g. setChild), so the structure is always checked again.
+         */
+        if (match(candidate.get()))
+          return candidate;
+        ++it;
+      }
+
+      return nullptr;
+    }
+
+
+    SharedAbstractNode AstContext::lookupNode(triton::ast::ast_e type, std::initializer_list<SharedAbstractNode> children) {
+      if (!this->modes->isModeEnabled(triton::modes::AST_HASH_CONSING))
+        return nullptr;
+
+      triton::uint64 key = static_cast<triton::uint64>(type);
+      for (const auto& child : children) {
+        key = mixKey(key, reinterpret_cast<triton::uint64>(child.get()));
+      }
+
+      return this->findInterned(key, [&](AbstractNode* candidate) {
+        const auto& nodes = candidate->getChildren();
+        return candidate->getType() == type && nodes.size() == children.size() && std::equal(children.begin(), children.end(), nodes.begin());
+      });
+    }
+
+
+    SharedAbstractNode AstContext::lookupInteger(const triton::uint512& value) {
+      if (!this->modes->isModeEnabled(triton::modes::AST_HASH_CONSING))
+        return nullptr;
+
+      triton::uint64 key = mixKey(static_cast<triton::uint64>(INTEGER_NODE), static_cast<triton::uint64>(value & 0xffffffffffffffff));
+
+      return this->findInterned(key, [&](AbstractNode* candidate) {
+        return candidate->getType() == INTEGER_NODE && reinterpret_cast<IntegerNode*>(candidate)->getInteger() == value;
+      });
+    }
+
+
+    SharedAbstractNode AstContext::lookupReference(const triton::engines::symbolic::SharedSymbolicExpression& expr) {
+      if (!this->modes->isModeEnabled(triton::modes::AST_HASH_CONSING))
+        return nullptr;
+
+      triton::uint64 key = mixKey(static_cast<triton::uint64>(REFERENCE_NODE), reinterpret_cast<triton::uint64>(expr.get()));
+
+      return this->findInterned(key, [&](AbstractNode* candidate) {
+        return candidate->getType() == REFERENCE_NODE && reinterpret_cast<ReferenceNode*>(candidate)->getSymbolicExpression() == expr;
+      });
+    }
+
+
+    SharedAbstractNode AstContext::intern(const SharedAbstractNode& node) {
+      /* Variables are already unique through the valueMapping */
+      if (node->getType() == VARIABLE_NODE)
+        return node;
+
+      triton::uint64 key = this->getStructuralKey(node.get());
+      SharedAbstractNode interned = this->findInterned(key, [&](AbstractNode* candidate) {
+        return this->isStructurallyIdentical(candidate, node.get());
+      });
+
+      if (interned != nullptr)
+        return interned;
+
+      this->uniqueTable.insert(std::make_pair(key, WeakAbstractNode(node)));
+
+      /* Sweep dead entries each time the table doubled since the last sweep */
+      if (this->uniqueTable.size() > std::max<triton::usize>(this->uniqueTableSwept * 2, 4096)) {
+        for (auto it = this->uniqueTable.begin(); it != this->uniqueTable.end();) {
+          if (it->second.expired())
+            it = this->uniqueTable.erase(it);
+          else
+            ++it;
+        }
+        this->uniqueTableSwept = this->uniqueTable.size();
+      }
+
+      return node;
     }
 
 
     SharedAbstractNode AstContext::assert_(const SharedAbstractNode& expr) {
-      SharedAbstractNode node = std::make_shared<AssertNode>(expr);
+      if (auto interned = this->lookupNode(ASSERT_NODE, {expr}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<AssertNode>(expr);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::assert_(): Not enough memory.");
       node->init();
@@ -81,7 +359,14 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::bv(const triton::uint512& value, triton::uint32 size) {
-      SharedAbstractNode node = std::make_shared<BvNode>(value, size, this->shared_from_this());
+      if (size != 0 && size <= triton::bitsize::max_supported && this->modes->isModeEnabled(triton::modes::AST_HASH_CONSING)) {
+        triton::uint512 mask = -1;
+        mask = mask >> (512 - size);
+        if (auto interned = this->lookupNode(BV_NODE, {this->integer(value & mask), this->integer(size)}))
+          return interned;
+      }
+
+      SharedAbstractNode node = this->newNode<BvNode>(value, size, this->shared_from_this());
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bv(): Not enough memory.");
       node->init();
@@ -100,7 +385,10 @@ namespace triton {
           return expr1;
       }
 
-      SharedAbstractNode node = std::make_shared<BvaddNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(BVADD_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<BvaddNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvadd(): Not enough memory.");
       node->init();
@@ -138,7 +426,10 @@ namespace triton {
           return expr1;
       }
 
-      SharedAbstractNode node = std::make_shared<BvandNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(BVAND_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<BvandNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvand(): Not enough memory.");
       node->init();
@@ -164,7 +455,10 @@ namespace triton {
           return expr1;
       }
 
-      SharedAbstractNode node = std::make_shared<BvashrNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(BVASHR_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<BvashrNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvashr(): Not enough memory.");
       node->init();
@@ -180,7 +474,7 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::bvfalse(void) {
-      SharedAbstractNode node = std::make_shared<BvNode>(0, 1, this->shared_from_this());
+      SharedAbstractNode node = this->newNode<BvNode>(0, 1, this->shared_from_this());
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvfalse(): Not enough memory.");
       node->init();
@@ -203,7 +497,10 @@ namespace triton {
           return this->bv(0, expr1->getBitvectorSize());
       }
 
-      SharedAbstractNode node = std::make_shared<BvlshrNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(BVLSHR_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<BvlshrNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvlshr(): Not enough memory.");
       node->init();
@@ -237,7 +534,10 @@ namespace triton {
           return expr1;
       }
 
-      SharedAbstractNode node = std::make_shared<BvmulNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(BVMUL_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<BvmulNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvmul(): Not enough memory.");
       node->init();
@@ -253,7 +553,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::bvnand(const SharedAbstractNode& expr1, const SharedAbstractNode& expr2) {
-      SharedAbstractNode node = std::make_shared<BvnandNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(BVNAND_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<BvnandNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvnand(): Not enough memory.");
       node->init();
@@ -269,7 +572,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::bvneg(const SharedAbstractNode& expr) {
-      SharedAbstractNode node = std::make_shared<BvnegNode>(expr);
+      if (auto interned = this->lookupNode(BVNEG_NODE, {expr}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<BvnegNode>(expr);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvneg(): Not enough memory.");
       node->init();
@@ -285,7 +591,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::bvnor(const SharedAbstractNode& expr1, const SharedAbstractNode& expr2) {
-      SharedAbstractNode node = std::make_shared<BvnorNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(BVNOR_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<BvnorNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvnor(): Not enough memory.");
       node->init();
@@ -301,7 +610,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::bvnot(const SharedAbstractNode& expr) {
-      SharedAbstractNode node = std::make_shared<BvnotNode>(expr);
+      if (auto interned = this->lookupNode(BVNOT_NODE, {expr}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<BvnotNode>(expr);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvnot(): Not enough memory.");
       node->init();
@@ -339,7 +651,10 @@ namespace triton {
           return expr1;
       }
 
-      SharedAbstractNode node = std::make_shared<BvorNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(BVOR_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<BvorNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvor(): Not enough memory.");
       node->init();
@@ -355,7 +670,12 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::bvrol(const SharedAbstractNode& expr, triton::uint32 rot) {
-      SharedAbstractNode node = std::make_shared<BvrolNode>(expr, rot);
+      if (this->modes->isModeEnabled(triton::modes::AST_HASH_CONSING)) {
+        if (auto interned = this->lookupNode(BVROL_NODE, {expr, this->integer(rot)}))
+          return interned;
+      }
+
+      SharedAbstractNode node = this->newNode<BvrolNode>(expr, rot);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvrol(): Not enough memory.");
       node->init();
@@ -389,7 +709,12 @@ namespace triton {
       }
 
       /* Otherwise, we concretize the index rotation */
-      SharedAbstractNode node = std::make_shared<BvrolNode>(expr, this->integer(rot->evaluate()));
+      if (this->modes->isModeEnabled(triton::modes::AST_HASH_CONSING)) {
+        if (auto interned = this->lookupNode(BVROL_NODE, {expr, this->integer(rot->evaluate())}))
+          return interned;
+      }
+
+      SharedAbstractNode node = this->newNode<BvrolNode>(expr, this->integer(rot->evaluate()));
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvrol(): Not enough memory.");
       node->init();
@@ -405,7 +730,12 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::bvror(const SharedAbstractNode& expr, triton::uint32 rot) {
-      SharedAbstractNode node = std::make_shared<BvrorNode>(expr, rot);
+      if (this->modes->isModeEnabled(triton::modes::AST_HASH_CONSING)) {
+        if (auto interned = this->lookupNode(BVROR_NODE, {expr, this->integer(rot)}))
+          return interned;
+      }
+
+      SharedAbstractNode node = this->newNode<BvrorNode>(expr, rot);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvror(): Not enough memory.");
       node->init();
@@ -439,7 +769,12 @@ namespace triton {
       }
 
       /* Otherwise, we concretize the index rotation */
-      SharedAbstractNode node = std::make_shared<BvrorNode>(expr, this->integer(rot->evaluate()));
+      if (this->modes->isModeEnabled(triton::modes::AST_HASH_CONSING)) {
+        if (auto interned = this->lookupNode(BVROR_NODE, {expr, this->integer(rot->evaluate())}))
+          return interned;
+      }
+
+      SharedAbstractNode node = this->newNode<BvrorNode>(expr, this->integer(rot->evaluate()));
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvror(): Not enough memory.");
       node->init();
@@ -461,7 +796,10 @@ namespace triton {
           return expr1;
       }
 
-      SharedAbstractNode node = std::make_shared<BvsdivNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(BVSDIV_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<BvsdivNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvsdiv(): Not enough memory.");
       node->init();
@@ -477,7 +815,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::bvsge(const SharedAbstractNode& expr1, const SharedAbstractNode& expr2) {
-      SharedAbstractNode node = std::make_shared<BvsgeNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(BVSGE_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<BvsgeNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvsge(): Not enough memory.");
       node->init();
@@ -486,7 +827,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::bvsgt(const SharedAbstractNode& expr1, const SharedAbstractNode& expr2) {
-      SharedAbstractNode node = std::make_shared<BvsgtNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(BVSGT_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<BvsgtNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvsgt(): Not enough memory.");
       node->init();
@@ -509,7 +853,10 @@ namespace triton {
           return this->bv(0, expr1->getBitvectorSize());
       }
 
-      SharedAbstractNode node = std::make_shared<BvshlNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(BVSHL_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<BvshlNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvshl(): Not enough memory.");
       node->init();
@@ -525,7 +872,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::bvsle(const SharedAbstractNode& expr1, const SharedAbstractNode& expr2) {
-      SharedAbstractNode node = std::make_shared<BvsleNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(BVSLE_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<BvsleNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvsle(): Not enough memory.");
       node->init();
@@ -534,7 +884,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::bvslt(const SharedAbstractNode& expr1, const SharedAbstractNode& expr2) {
-      SharedAbstractNode node = std::make_shared<BvsltNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(BVSLT_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<BvsltNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvslt(): Not enough memory.");
       node->init();
@@ -543,7 +896,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::bvsmod(const SharedAbstractNode& expr1, const SharedAbstractNode& expr2) {
-      SharedAbstractNode node = std::make_shared<BvsmodNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(BVSMOD_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<BvsmodNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvsmod(): Not enough memory.");
       node->init();
@@ -559,7 +915,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::bvsrem(const SharedAbstractNode& expr1, const SharedAbstractNode& expr2) {
-      SharedAbstractNode node = std::make_shared<BvsremNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(BVSREM_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<BvsremNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvsrem(): Not enough memory.");
       node->init();
@@ -589,7 +948,10 @@ namespace triton {
           return this->bv(0, expr1->getBitvectorSize());
       }
 
-      SharedAbstractNode node = std::make_shared<BvsubNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(BVSUB_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<BvsubNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvsub(): Not enough memory.");
       node->init();
@@ -605,7 +967,7 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::bvtrue(void) {
-      SharedAbstractNode node = std::make_shared<BvNode>(1, 1, this->shared_from_this());
+      SharedAbstractNode node = this->newNode<BvNode>(1, 1, this->shared_from_this());
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvtrue(): Not enough memory.");
       node->init();
@@ -620,7 +982,10 @@ namespace triton {
           return expr1;
       }
 
-      SharedAbstractNode node = std::make_shared<BvudivNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(BVUDIV_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<BvudivNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvudiv(): Not enough memory.");
       node->init();
@@ -636,7 +1001,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::bvuge(const SharedAbstractNode& expr1, const SharedAbstractNode& expr2) {
-      SharedAbstractNode node = std::make_shared<BvugeNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(BVUGE_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<BvugeNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvuge(): Not enough memory.");
       node->init();
@@ -645,7 +1013,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::bvugt(const SharedAbstractNode& expr1, const SharedAbstractNode& expr2) {
-      SharedAbstractNode node = std::make_shared<BvugtNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(BVUGT_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<BvugtNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvugt(): Not enough memory.");
       node->init();
@@ -654,7 +1025,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::bvule(const SharedAbstractNode& expr1, const SharedAbstractNode& expr2) {
-      SharedAbstractNode node = std::make_shared<BvuleNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(BVULE_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<BvuleNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvule(): Not enough memory.");
       node->init();
@@ -663,7 +1037,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::bvult(const SharedAbstractNode& expr1, const SharedAbstractNode& expr2) {
-      SharedAbstractNode node = std::make_shared<BvultNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(BVULT_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<BvultNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvult(): Not enough memory.");
       node->init();
@@ -672,7 +1049,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::bvurem(const SharedAbstractNode& expr1, const SharedAbstractNode& expr2) {
-      SharedAbstractNode node = std::make_shared<BvuremNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(BVUREM_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<BvuremNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvurem(): Not enough memory.");
       node->init();
@@ -688,7 +1068,10 @@ namespace triton {
 
 
      SharedAbstractNode AstContext::bvxnor(const SharedAbstractNode& expr1, const SharedAbstractNode& expr2) {
-      SharedAbstractNode node = std::make_shared<BvxnorNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(BVXNOR_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<BvxnorNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvxnor(): Not enough memory.");
       node->init();
@@ -718,7 +1101,10 @@ namespace triton {
           return this->bv(0, expr1->getBitvectorSize());
       }
 
-      SharedAbstractNode node = std::make_shared<BvxorNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(BVXOR_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<BvxorNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::bvxor(): Not enough memory.");
       node->init();
@@ -738,7 +1124,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::concat(const SharedAbstractNode& expr1, const SharedAbstractNode& expr2) {
-      SharedAbstractNode node = std::make_shared<ConcatNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(CONCAT_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<ConcatNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::concat(): Not enough memory.");
       node->init();
@@ -766,7 +1155,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::declare(const SharedAbstractNode& var) {
-      SharedAbstractNode node = std::make_shared<DeclareNode>(var);
+      if (auto interned = this->lookupNode(DECLARE_NODE, {var}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<DeclareNode>(var);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::declare(): Not enough memory.");
       node->init();
@@ -775,7 +1167,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::distinct(const SharedAbstractNode& expr1, const SharedAbstractNode& expr2) {
-      SharedAbstractNode node = std::make_shared<DistinctNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(DISTINCT_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<DistinctNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::distinct(): Not enough memory.");
       node->init();
@@ -784,7 +1179,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::equal(const SharedAbstractNode& expr1, const SharedAbstractNode& expr2) {
-      SharedAbstractNode node = std::make_shared<EqualNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(EQUAL_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<EqualNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::equal(): Not enough memory.");
       node->init();
@@ -804,7 +1202,12 @@ namespace triton {
         }
       }
 
-      SharedAbstractNode node = std::make_shared<ExtractNode>(high, low, expr);
+      if (this->modes->isModeEnabled(triton::modes::AST_HASH_CONSING)) {
+        if (auto interned = this->lookupNode(EXTRACT_NODE, {this->integer(high), this->integer(low), expr}))
+          return interned;
+      }
+
+      SharedAbstractNode node = this->newNode<ExtractNode>(high, low, expr);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::extract(): Not enough memory.");
       node->init();
@@ -824,7 +1227,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::iff(const SharedAbstractNode& expr1, const SharedAbstractNode& expr2) {
-      SharedAbstractNode node = std::make_shared<IffNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(IFF_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<IffNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::iff(): Not enough memory.");
       node->init();
@@ -833,7 +1239,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::integer(const triton::uint512& value) {
-      SharedAbstractNode node = std::make_shared<IntegerNode>(value, this->shared_from_this());
+      if (auto interned = this->lookupInteger(value))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<IntegerNode>(value, this->shared_from_this());
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::integer(): Not enough memory.");
       node->init();
@@ -850,7 +1259,10 @@ namespace triton {
         }
       }
 
-      SharedAbstractNode node = std::make_shared<IteNode>(ifExpr, thenExpr, elseExpr);
+      if (auto interned = this->lookupNode(ITE_NODE, {ifExpr, thenExpr, elseExpr}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<IteNode>(ifExpr, thenExpr, elseExpr);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::ite(): Not enough memory.");
       node->init();
@@ -860,7 +1272,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::land(const SharedAbstractNode& expr1, const SharedAbstractNode& expr2) {
-      SharedAbstractNode node = std::make_shared<LandNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(LAND_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<LandNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::land(): Not enough memory.");
       node->init();
@@ -873,7 +1288,7 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::let(std::string alias, const SharedAbstractNode& expr2, const SharedAbstractNode& expr3) {
-      SharedAbstractNode node = std::make_shared<LetNode>(alias, expr2, expr3);
+      SharedAbstractNode node = this->newNode<LetNode>(alias, expr2, expr3);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::let(): Not enough memory.");
       node->init();
@@ -882,7 +1297,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::lnot(const SharedAbstractNode& expr) {
-      SharedAbstractNode node = std::make_shared<LnotNode>(expr);
+      if (auto interned = this->lookupNode(LNOT_NODE, {expr}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<LnotNode>(expr);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::lnot(): Not enough memory.");
       node->init();
@@ -891,7 +1309,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::lor(const SharedAbstractNode& expr1, const SharedAbstractNode& expr2) {
-      SharedAbstractNode node = std::make_shared<LorNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(LOR_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<LorNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::lor(): Not enough memory.");
       node->init();
@@ -904,7 +1325,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::lxor(const SharedAbstractNode& expr1, const SharedAbstractNode& expr2) {
-      SharedAbstractNode node = std::make_shared<LxorNode>(expr1, expr2);
+      if (auto interned = this->lookupNode(LXOR_NODE, {expr1, expr2}))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<LxorNode>(expr1, expr2);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::lxor(): Not enough memory");
       node->init();
@@ -917,7 +1341,10 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::reference(const triton::engines::symbolic::SharedSymbolicExpression& expr) {
-      SharedAbstractNode node = std::make_shared<ReferenceNode>(expr);
+      if (auto interned = this->lookupReference(expr))
+        return interned;
+
+      SharedAbstractNode node = this->newNode<ReferenceNode>(expr);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::reference(): Not enough memory.");
       node->init();
@@ -926,7 +1353,7 @@ namespace triton {
 
 
     SharedAbstractNode AstContext::string(std::string value) {
-      SharedAbstractNode node = std::make_shared<StringNode>(value, this->shared_from_this());
+      SharedAbstractNode node = this->newNode<StringNode>(value, this->shared_from_this());
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::string(): Not enough memory.");
       node->init();
@@ -939,7 +1366,12 @@ namespace triton {
       if (sizeExt == 0)
         return expr;
 
-      SharedAbstractNode node = std::make_shared<SxNode>(sizeExt, expr);
+      if (this->modes->isModeEnabled(triton::modes::AST_HASH_CONSING)) {
+        if (auto interned = this->lookupNode(SX_NODE, {this->integer(sizeExt), expr}))
+          return interned;
+      }
+
+      SharedAbstractNode node = this->newNode<SxNode>(sizeExt, expr);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::sx(): Not enough memory.");
       node->init();
@@ -969,7 +1401,7 @@ namespace triton {
       }
       else {
         // if not found, create a new variable node
-        SharedAbstractNode node = std::make_shared<VariableNode>(symVar, this->shared_from_this());
+        SharedAbstractNode node = this->newNode<VariableNode>(symVar, this->shared_from_this());
         this->initVariable(symVar->getName(), 0, node);
         if (node == nullptr) {
           throw triton::exceptions::Ast("AstContext::variable(): Not enough memory");
@@ -985,7 +1417,12 @@ namespace triton {
       if (sizeExt == 0)
         return expr;
 
-      SharedAbstractNode node = std::make_shared<ZxNode>(sizeExt, expr);
+      if (this->modes->isModeEnabled(triton::modes::AST_HASH_CONSING)) {
+        if (auto interned = this->lookupNode(ZX_NODE, {this->integer(sizeExt), expr}))
+          return interned;
+      }
+
+      SharedAbstractNode node = this->newNode<ZxNode>(sizeExt, expr);
       if (node == nullptr)
         throw triton::exceptions::Ast("AstContext::zx(): Not enough memory.");
       node->init();
@@ -1016,7 +1453,11 @@ namespace triton {
       if (it != this->valueMapping.end()) {
         if (auto node = it->second.first.lock()) {
           it->second.second = value;
-          node->initParents();
+          /* In lazy mode, nodes computed before this epoch are re-evaluated on demand */
+          if (this->modes->isModeEnabled(triton::modes::AST_LAZY_EVALUATION))
+            this->epoch++;
+          else
+            node->initParents();
         }
         else {
           throw triton::exceptions::Ast("AstContext::updateVariable(): This symbolic variable is dead.");
@@ -0,0 +1,227 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the Apache License 2.0.
+*/
+
+#include <iterator>
+#include <new>
+
+#include <triton/astNodePool.hpp>
+#include <triton/exceptions.hpp>
+
+
+
+namespace triton {
+  namespace ast {
+
+    NodePool::NodePool() {
+      for (triton::usize index = 0; index < NodePool::classes; index++) {
+        this->freeLists[index] = nullptr;
+        this->cursors[index]   = nullptr;
+        this->limits[index]    = nullptr;
+      }
+      this->live     = 0;
+      this->released = false;
+    }
+
+
+    NodePool::~NodePool() {
+      for (triton::uint8* slab : this->slabs)
+        delete[] slab;
+      this->slabs.clear();
+      this->owners.clear();
+    }
+
+
+    triton::usize NodePool::findScope(void* ptr, triton::usize cls) const {
+      triton::uint8* addr = static_cast<triton::uint8*>(ptr);
+
+      /* The rest of the slab which was current when a scope began */
+      for (triton::usize depth = this->scopes.size(); depth > 0; depth--) {
+        const Scope& scope = this->scopes[depth - 1];
+        if (scope.marks[cls] != nullptr && addr >= scope.marks[cls] && addr < scope.limits[cls])
+          return depth;
+      }
+
+      /* The slabs allocated while a scope was open */
+      auto it = this->owners.upper_bound(addr);
+      if (it == this->owners.begin())
+        return 0;
+      --it;
+      return (addr < it->first + NodePool::slabSize) ? it->second : 0;
+    }
+
+
+    void* NodePool::allocate(triton::usize size) {
+      triton::usize cls = (size + NodePool::granularity - 1) / NodePool::granularity;
+      std::lock_guard<std::mutex> guard(this->lock);
+
+      /* Too big for a size class */
+      if (cls >= NodePool::classes) {
+        void* ptr = ::operator new(size, std::nothrow);
+        if (ptr == nullptr)
+          throw triton::exceptions::Ast("NodePool::allocate(): Not enough memory.");
+        this->live++;
+        return ptr;
+      }
+
+      /* Reuse a freed block of this class, from the innermost scope first */
+      for (triton::usize depth = this->scopes.size(); depth > 0; depth--) {
+        Scope& scope = this->scopes[depth - 1];
+        if (scope.freeLists[cls] != nullptr) {
+          FreeBlock* block = scope.freeLists[cls];
+          scope.freeLists[cls] = block->next;
+          scope.live++;
+          this->live++;
+          return block;
+        }
+      }
+
+      if (this->freeLists[cls] != nullptr) {
+        FreeBlock* block = this->freeLists[cls];
+        this->freeLists[cls] = block->next;
+        this->live++;
+        return block;
+      }
+
+      /* Carve a block out of the current slab of this class */
+      triton::usize blockSize = cls * NodePool::granularity;
+      if (this->cursors[cls] == nullptr || this->cursors[cls] + blockSize > this->limits[cls]) {
+        triton::uint8* slab = new(std::nothrow) triton::uint8[NodePool::slabSize];
+        if (slab == nullptr)
+          throw triton::exceptions::Ast("NodePool::allocate(): Not enough memory.");
+        this->slabs.push_back(slab);
+        this->owners[slab] = this->scopes.size();
+        this->cursors[cls] = slab;
+        this->limits[cls]  = slab + NodePool::slabSize;
+      }
+
+      void* ptr = this->cursors[cls];
+      this->cursors[cls] += blockSize;
+
+      if (!this->scopes.empty())
+        this->scopes.back().live++;
+      this->live++;
+
+      return ptr;
+    }
+
+
+    void NodePool::deallocate(void* ptr, triton::usize size) {
+      triton::usize cls = (size + NodePool::granularity - 1) / NodePool::granularity;
+      std::unique_lock<std::mutex> guard(this->lock);
+
+      if (cls >= NodePool::classes) {
+        ::operator delete(ptr);
+      }
+      else {
+        FreeBlock* block = static_cast<FreeBlock*>(ptr);
+        triton::usize depth = this->scopes.empty() ? 0 : this->findScope(ptr, cls);
+        if (depth != 0) {
+          Scope& scope = this->scopes[depth - 1];
+          block->next = scope.freeLists[cls];
+          scope.freeLists[cls] = block;
+          scope.live--;
+        }
+        else {
+          block->next = this->freeLists[cls];
+          this->freeLists[cls] = block;
+        }
+      }
+
+      this->live--;
+
+      /* The owner is gone and this was the last block, release all slabs at once */
+      if (this->released && this->live == 0) {
+        guard.unlock();
+        delete this;
+      }
+    }
+
+
+    triton::usize NodePool::getNumberOfBlocks(void) const {
+      std::lock_guard<std::mutex> guard(this->lock);
+      return this->live;
+    }
+
+
+    triton::usize NodePool::getMemoryUsage(void) const {
+      std::lock_guard<std::mutex> guard(this->lock);
+      return this->slabs.size() * NodePool::slabSize;
+    }
+
+
+    void NodePool::release(void) {
+      std::unique_lock<std::mutex> guard(this->lock);
+      this->released = true;
+      if (this->live == 0) {
+        guard.unlock();
+        delete this;
+      }
+    }
+
+
+    void NodePool::beginScope(void) {
+      std::lock_guard<std::mutex> guard(this->lock);
+      Scope scope;
+
+      for (triton::usize index = 0; index < NodePool::classes; index++) {
+        scope.freeLists[index] = nullptr;
+        scope.marks[index]     = this->cursors[index];
+        scope.limits[index]    = this->limits[index];
+      }
+      scope.slabs = this->slabs.size();
+      scope.live  = 0;
+
+      this->scopes.push_back(scope);
+    }
+
+
+    void NodePool::endScope(void) {
+      std::lock_guard<std::mutex> guard(this->lock);
+
+      if (this->scopes.empty())
+        throw triton::exceptions::Ast("NodePool::endScope(): No scope is open.");
+
+      Scope& scope = this->scopes.back();
+      triton::usize depth = this->scopes.size();
+
+      /* None of its blocks is alive, rewind the cursors and free its slabs at once */
+      if (scope.live == 0) {
+        for (triton::usize index = 0; index < NodePool::classes; index++) {
+          this->cursors[index] = scope.marks[index];
+          this->limits[index]  = scope.limits[index];
+        }
+        for (auto it = this->slabs.begin() + scope.slabs; it != this->slabs.end(); ++it) {
+          this->owners.erase(*it);
+          delete[] *it;
+        }
+        this->slabs.resize(scope.slabs);
+        this->scopes.pop_back();
+        return;
+      }
+
+      /* Otherwise, its slabs, free blocks and live blocks are handed over to the enclosing scope */
+      for (auto it = this->slabs.begin() + scope.slabs; it != this->slabs.end(); ++it)
+        this->owners[*it] = depth - 1;
+
+      for (triton::usize index = 0; index < NodePool::classes; index++) {
+        FreeBlock*& head = (depth > 1) ? this->scopes[depth - 2].freeLists[index] : this->freeLists[index];
+        while (scope.freeLists[index] != nullptr) {
+          FreeBlock* block = scope.freeLists[index];
+          scope.freeLists[index] = block->next;
+          block->next = head;
+          head = block;
+        }
+      }
+
+      if (depth > 1)
+        this->scopes[depth - 2].live += scope.live;
+
+      this->scopes.pop_back();
+    }
+
+  };
+};
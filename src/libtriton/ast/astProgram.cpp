@@ -0,0 +1,476 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the Apache License 2.0.
+*/
+
+#include <algorithm>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <triton/astProgram.hpp>
+#include <triton/exceptions.hpp>
+#include <triton/symbolicExpression.hpp>
+
+
+
+namespace triton {
+  namespace ast {
+
+    /* Sign extends a value of `size` bits to 64 bits */
+    static inline triton::sint64 signExtend64(triton::uint64 value, triton::uint32 size) {
+      triton::uint64 sign = (static_cast<triton::uint64>(1) << (size - 1));
+      return static_cast<triton::sint64>((value ^ sign) - sign);
+    }
+
+
+    /* Returns the absolute value of a signed value */
+    static inline triton::uint64 magnitude64(triton::sint64 value) {
+      return (value < 0) ? (0 - static_cast<triton::uint64>(value)) : static_cast<triton::uint64>(value);
+    }
+
+
+    AstProgram::AstProgram(const SharedAbstractNode& node) {
+      std::unordered_map<AbstractNode*, triton::uint32> compiled;
+      std::unordered_map<triton::usize, triton::uint32> vars;
+      std::unordered_set<AbstractNode*> visited;
+      std::vector<std::pair<AbstractNode*, bool>> worklist;
+
+      if (node == nullptr)
+        throw triton::exceptions::Ast("AstProgram::AstProgram(): Node cannot be null.");
+
+      /*
+       *  Children are compiled before their parents using a worklist
+       *  instead of recursive calls. Leaves and sub-trees without
+       *  symbolic variable are compiled when they are first reached.
+       */
+      worklist.push_back({node.get(), false});
+
+      while (!worklist.empty()) {
+        AbstractNode* ast = worklist.back().first;
+        bool postOrder    = worklist.back().second;
+        worklist.pop_back();
+
+        if (compiled.find(ast) != compiled.end())
+          continue;
+
+        if (postOrder || !ast->isSymbolized() || ast->getType() == VARIABLE_NODE) {
+          compiled[ast] = this->compile(ast, compiled, vars);
+          continue;
+        }
+
+        if (!visited.insert(ast).second)
+          continue;
+
+        worklist.push_back({ast, true});
+
+        for (const SharedAbstractNode& child : ast->getChildren()) {
+          if (child->getType() != INTEGER_NODE && visited.find(child.get()) == visited.end())
+            worklist.push_back({child.get(), false});
+        }
+
+        if (ast->getType() == REFERENCE_NODE) {
+          AbstractNode* ref = reinterpret_cast<ReferenceNode*>(ast)->getSymbolicExpression()->getAst().get();
+          if (visited.find(ref) == visited.end())
+            worklist.push_back({ref, false});
+        }
+      }
+
+      this->result = compiled.at(node.get());
+      this->size   = node->getBitvectorSize();
+
+      /* Variables are given ordered by id */
+      std::vector<triton::usize> order(this->variables.size());
+      for (triton::usize index = 0; index < order.size(); index++)
+        order[index] = index;
+
+      std::sort(order.begin(), order.end(), [this](triton::usize a, triton::usize b) {
+        return this->variables[a]->getId() < this->variables[b]->getId();
+      });
+
+      std::vector<triton::engines::symbolic::SharedSymbolicVariable> variables;
+      std::vector<triton::uint32> variableSlots;
+      std::vector<triton::uint64> variableMasks;
+      for (triton::usize index : order) {
+        variables.push_back(this->variables[index]);
+        variableSlots.push_back(this->variableSlots[index]);
+        variableMasks.push_back(this->variableMasks[index]);
+      }
+
+      this->variables     = std::move(variables);
+      this->variableSlots = std::move(variableSlots);
+      this->variableMasks = std::move(variableMasks);
+    }
+
+
+    triton::uint32 AstProgram::newSlot(triton::uint64 value) {
+      this->slots.push_back(value);
+      return static_cast<triton::uint32>(this->slots.size() - 1);
+    }
+
+
+    triton::uint32 AstProgram::emit(opcode_e opcode, triton::uint32 size, triton::uint64 mask, triton::uint32 src0, triton::uint32 src1, triton::uint32 src2, triton::uint32 imm) {
+      Instruction inst;
+
+      inst.opcode = opcode;
+      inst.size   = size;
+      inst.imm    = imm;
+      inst.dst    = this->newSlot();
+      inst.src[0] = src0;
+      inst.src[1] = src1;
+      inst.src[2] = src2;
+      inst.mask   = mask;
+
+      this->instructions.push_back(inst);
+
+      return inst.dst;
+    }
+
+
+    triton::uint32 AstProgram::compile(AbstractNode* node, std::unordered_map<AbstractNode*, triton::uint32>& compiled, std::unordered_map<triton::usize, triton::uint32>& vars) {
+      const std::vector<SharedAbstractNode>& children = node->getChildren();
+      triton::uint32 size = node->getBitvectorSize();
+      triton::uint64 mask = triton::ast::mask64(size);
+
+      auto slot = [&](triton::usize index) -> triton::uint32 {
+        return compiled.at(children[index].get());
+      };
+
+      auto integer = [&](triton::usize index) -> triton::uint32 {
+        return reinterpret_cast<IntegerNode*>(children[index].get())->getInteger().convert_to<triton::uint32>();
+      };
+
+      switch (node->getType()) {
+        case ASSERT_NODE:
+        case COMPOUND_NODE:
+        case DECLARE_NODE:
+        case FORALL_NODE:
+        case INTEGER_NODE:
+        case LET_NODE:
+        case STRING_NODE:
+          throw triton::exceptions::Ast("AstProgram::compile(): Unsupported node type.");
+        default:
+          break;
+      }
+
+      if (size == 0 || size > 64)
+        throw triton::exceptions::Ast("AstProgram::compile(): Only bit-vectors up to 64 bits are supported.");
+
+      /* Sub-trees without symbolic variable are constants */
+      if (!node->isSymbolized())
+        return this->newSlot(node->evaluate64());
+
+      switch (node->getType()) {
+        case BVADD_NODE:    return this->emit(OP_ADD,  size, mask, slot(0), slot(1));
+        case BVAND_NODE:    return this->emit(OP_AND,  size, mask, slot(0), slot(1));
+        case BVASHR_NODE:   return this->emit(OP_ASHR, size, mask, slot(0), slot(1));
+        case BVLSHR_NODE:   return this->emit(OP_LSHR, size, mask, slot(0), slot(1));
+        case BVMUL_NODE:    return this->emit(OP_MUL,  size, mask, slot(0), slot(1));
+        case BVNAND_NODE:   return this->emit(OP_NAND, size, mask, slot(0), slot(1));
+        case BVNEG_NODE:    return this->emit(OP_NEG,  size, mask, slot(0));
+        case BVNOR_NODE:    return this->emit(OP_NOR,  size, mask, slot(0), slot(1));
+        case BVNOT_NODE:    return this->emit(OP_NOT,  size, mask, slot(0));
+        case BVOR_NODE:     return this->emit(OP_OR,   size, mask, slot(0), slot(1));
+        case BVSDIV_NODE:   return this->emit(OP_SDIV, size, mask, slot(0), slot(1));
+        case BVSHL_NODE:    return this->emit(OP_SHL,  size, mask, slot(0), slot(1));
+        case BVSMOD_NODE:   return this->emit(OP_SMOD, size, mask, slot(0), slot(1));
+        case BVSREM_NODE:   return this->emit(OP_SREM, size, mask, slot(0), slot(1));
+        case BVSUB_NODE:    return this->emit(OP_SUB,  size, mask, slot(0), slot(1));
+        case BVUDIV_NODE:   return this->emit(OP_UDIV, size, mask, slot(0), slot(1));
+        case BVUREM_NODE:   return this->emit(OP_UREM, size, mask, slot(0), slot(1));
+        case BVXNOR_NODE:   return this->emit(OP_XNOR, size, mask, slot(0), slot(1));
+        case BVXOR_NODE:    return this->emit(OP_XOR,  size, mask, slot(0), slot(1));
+
+        /* Comparisons work on the size of their operands */
+        case BVSGE_NODE:    return this->emit(OP_SGE,  children[0]->getBitvectorSize(), mask, slot(0), slot(1));
+        case BVSGT_NODE:    return this->emit(OP_SGT,  children[0]->getBitvectorSize(), mask, slot(0), slot(1));
+        case BVSLE_NODE:    return this->emit(OP_SLE,  children[0]->getBitvectorSize(), mask, slot(0), slot(1));
+        case BVSLT_NODE:    return this->emit(OP_SLT,  children[0]->getBitvectorSize(), mask, slot(0), slot(1));
+        case BVUGE_NODE:    return this->emit(OP_UGE,  children[0]->getBitvectorSize(), mask, slot(0), slot(1));
+        case BVUGT_NODE:    return this->emit(OP_UGT,  children[0]->getBitvectorSize(), mask, slot(0), slot(1));
+        case BVULE_NODE:    return this->emit(OP_ULE,  children[0]->getBitvectorSize(), mask, slot(0), slot(1));
+        case BVULT_NODE:    return this->emit(OP_ULT,  children[0]->getBitvectorSize(), mask, slot(0), slot(1));
+        case DISTINCT_NODE: return this->emit(OP_NE,   children[0]->getBitvectorSize(), mask, slot(0), slot(1));
+        case EQUAL_NODE:    return this->emit(OP_EQ,   children[0]->getBitvectorSize(), mask, slot(0), slot(1));
+        case IFF_NODE:      return this->emit(OP_EQ,   children[0]->getBitvectorSize(), mask, slot(0), slot(1));
+
+        case BVROL_NODE:
+        case BVROR_NODE: {
+          triton::uint32 rot = integer(1) % size;
+          if (node->getType() == BVROR_NODE)
+            rot = (size - rot) % size;
+          /* A null rotation is the identity */
+          if (rot == 0)
+            return slot(0);
+          return this->emit(OP_ROL, size, mask, slot(0), 0, 0, rot);
+        }
+
+        case CONCAT_NODE: {
+          triton::uint32 acc     = slot(0);
+          triton::uint32 accSize = children[0]->getBitvectorSize();
+          for (triton::usize index = 1; index < children.size(); index++) {
+            triton::uint32 childSize = children[index]->getBitvectorSize();
+            accSize += childSize;
+            acc = this->emit(OP_CONCAT, accSize, triton::ast::mask64(accSize), acc, slot(index), 0, childSize);
+          }
+          return acc;
+        }
+
+        case EXTRACT_NODE:
+          return this->emit(OP_EXTRACT, children[2]->getBitvectorSize(), mask, slot(2), 0, 0, integer(1));
+
+        case ITE_NODE:
+          return this->emit(OP_ITE, size, mask, slot(0), slot(1), slot(2));
+
+        case LAND_NODE:
+        case LOR_NODE:
+        case LXOR_NODE: {
+          opcode_e opcode = (node->getType() == LAND_NODE) ? OP_AND : (node->getType() == LOR_NODE) ? OP_OR : OP_XOR;
+          triton::uint32 acc = slot(0);
+          for (triton::usize index = 1; index < children.size(); index++)
+            acc = this->emit(opcode, size, mask, acc, slot(index));
+          return acc;
+        }
+
+        case LNOT_NODE:
+          return this->emit(OP_NOT, size, mask, slot(0));
+
+        case REFERENCE_NODE:
+          return compiled.at(reinterpret_cast<ReferenceNode*>(node)->getSymbolicExpression()->getAst().get());
+
+        case SX_NODE:
+          return this->emit(OP_SX, children[1]->getBitvectorSize(), mask, slot(1));
+
+        case VARIABLE_NODE: {
+          const auto& var = reinterpret_cast<VariableNode*>(node)->getSymbolicVariable();
+          /* Several nodes may represent the same variable */
+          auto it = vars.find(var->getId());
+          if (it != vars.end())
+            return it->second;
+          triton::uint32 dst = this->newSlot();
+          vars[var->getId()] = dst;
+          this->variables.push_back(var);
+          this->variableSlots.push_back(dst);
+          this->variableMasks.push_back(mask);
+          return dst;
+        }
+
+        /* The value of the child already fits */
+        case ZX_NODE:
+          return slot(1);
+
+        default:
+          throw triton::exceptions::Ast("AstProgram::compile(): Unsupported node type.");
+      }
+    }
+
+
+    const std::vector<triton::engines::symbolic::SharedSymbolicVariable>& AstProgram::getVariables(void) const {
+      return this->variables;
+    }
+
+
+    triton::uint32 AstProgram::getBitvectorSize(void) const {
+      return this->size;
+    }
+
+
+    triton::usize AstProgram::getNumberOfInstructions(void) const {
+      return this->instructions.size();
+    }
+
+
+    triton::uint64 AstProgram::evaluate(const std::vector<triton::uint64>& values) {
+      if (values.size() != this->variables.size())
+        throw triton::exceptions::Ast("AstProgram::evaluate(): Expects one value per variable.");
+      return this->evaluate(values.data());
+    }
+
+
+    triton::uint64 AstProgram::execute(const Instruction& inst, triton::uint64 a, triton::uint64 b, triton::uint64 c) {
+      triton::uint64 r = 0;
+
+      switch (inst.opcode) {
+        case OP_ADD:     r = (a + b) & inst.mask; break;
+        case OP_AND:     r = a & b; break;
+        case OP_CONCAT:  r = (a << inst.imm) | b; break;
+        case OP_EQ:      r = (a == b); break;
+        case OP_EXTRACT: r = (a >> inst.imm) & inst.mask; break;
+        case OP_ITE:     r = a ? b : c; break;
+        case OP_LSHR:    r = (b >= inst.size) ? 0 : (a >> b); break;
+        case OP_MUL:     r = (a * b) & inst.mask; break;
+        case OP_NAND:    r = ~(a & b) & inst.mask; break;
+        case OP_NE:      r = (a != b); break;
+        case OP_NEG:     r = (0 - a) & inst.mask; break;
+        case OP_NOR:     r = ~(a | b) & inst.mask; break;
+        case OP_NOT:     r = ~a & inst.mask; break;
+        case OP_OR:      r = a | b; break;
+        case OP_ROL:     r = ((a << inst.imm) | (a >> (inst.size - inst.imm))) & inst.mask; break;
+        case OP_SGE:     r = (signExtend64(a, inst.size) >= signExtend64(b, inst.size)); break;
+        case OP_SGT:     r = (signExtend64(a, inst.size) >  signExtend64(b, inst.size)); break;
+        case OP_SHL:     r = (b >= inst.size) ? 0 : ((a << b) & inst.mask); break;
+        case OP_SLE:     r = (signExtend64(a, inst.size) <= signExtend64(b, inst.size)); break;
+        case OP_SLT:     r = (signExtend64(a, inst.size) <  signExtend64(b, inst.size)); break;
+        case OP_SUB:     r = (a - b) & inst.mask; break;
+        case OP_SX:      r = static_cast<triton::uint64>(signExtend64(a, inst.size)) & inst.mask; break;
+        case OP_UDIV:    r = (b == 0) ? inst.mask : (a / b); break;
+        case OP_UGE:     r = (a >= b); break;
+        case OP_UGT:     r = (a >  b); break;
+        case OP_ULE:     r = (a <= b); break;
+        case OP_ULT:     r = (a <  b); break;
+        case OP_UREM:    r = (b == 0) ? a : (a % b); break;
+        case OP_XNOR:    r = ~(a ^ b) & inst.mask; break;
+        case OP_XOR:     r = a ^ b; break;
+
+        case OP_ASHR: {
+          /* Shifting a signed value by its size or more gives -1 */
+          triton::uint32 shift = (b >= inst.size) ? (inst.size - 1) : static_cast<triton::uint32>(b);
+          r = static_cast<triton::uint64>(signExtend64(a, inst.size) >> shift) & inst.mask;
+          break;
+        }
+
+        case OP_SDIV: {
+          triton::sint64 sa = signExtend64(a, inst.size);
+          triton::sint64 sb = signExtend64(b, inst.size);
+          if (b == 0) {
+            r = (sa < 0) ? 1 : inst.mask;
+            break;
+          }
+          r = magnitude64(sa) / magnitude64(sb);
+          if ((sa < 0) != (sb < 0))
+            r = 0 - r;
+          r &= inst.mask;
+          break;
+        }
+
+        case OP_SREM:
+        case OP_SMOD: {
+          triton::sint64 sa = signExtend64(a, inst.size);
+          triton::sint64 sb = signExtend64(b, inst.size);
+          if (b == 0) {
+            r = a;
+            break;
+          }
+          /* The remainder has the sign of the dividend */
+          r = magnitude64(sa) % magnitude64(sb);
+          if (sa < 0)
+            r = 0 - r;
+          /* The modulus has the sign of the divisor */
+          if (inst.opcode == OP_SMOD && r != 0 && (sa < 0) != (sb < 0))
+            r = r + b;
+          r &= inst.mask;
+          break;
+        }
+
+        default:
+          throw triton::exceptions::Ast("AstProgram::execute(): Invalid opcode.");
+      }
+
+      return r;
+    }
+
+
+    triton::uint64 AstProgram::evaluate(const triton::uint64* values) {
+      triton::uint64* s = this->slots.data();
+
+      for (triton::usize index = 0; index < this->variableSlots.size(); index++)
+        s[this->variableSlots[index]] = values[index] & this->variableMasks[index];
+
+      for (const Instruction& inst : this->instructions)
+        s[inst.dst] = AstProgram::execute(inst, s[inst.src[0]], s[inst.src[1]], s[inst.src[2]]);
+
+      return s[this->result];
+    }
+
+
+    std::vector<triton::uint64> AstProgram::evaluateBatch(const std::vector<std::vector<triton::uint64>>& assignments) {
+      std::vector<triton::uint64> values(this->variables.size() * assignments.size());
+      std::vector<triton::uint64> results(assignments.size());
+      triton::usize count = assignments.size();
+
+      /* Values are given variable by variable to the lanes */
+      for (triton::usize j = 0; j < count; j++) {
+        if (assignments[j].size() != this->variables.size())
+          throw triton::exceptions::Ast("AstProgram::evaluateBatch(): Expects one value per variable in each assignment.");
+        for (triton::usize i = 0; i < this->variables.size(); i++)
+          values[i * count + j] = assignments[j][i];
+      }
+
+      this->evaluateBatch(values.data(), count, results.data());
+
+      return results;
+    }
+
+
+    void AstProgram::evaluateBatch(const triton::uint64* values, triton::usize count, triton::uint64* results) {
+      const triton::usize width = AstProgram::lanes;
+
+      /* Constants are broadcast to all lanes once */
+      if (this->laneSlots.size() != this->slots.size() * width) {
+        this->laneSlots.resize(this->slots.size() * width);
+        for (triton::usize index = 0; index < this->slots.size(); index++)
+          std::fill_n(&this->laneSlots[index * width], width, this->slots[index]);
+      }
+
+      triton::uint64* L = this->laneSlots.data();
+
+      for (triton::usize base = 0; base < count; base += width) {
+        triton::usize n = std::min(width, count - base);
+
+        for (triton::usize i = 0; i < this->variableSlots.size(); i++) {
+          triton::uint64* d       = L + this->variableSlots[i] * width;
+          const triton::uint64* v = values + i * count + base;
+          triton::uint64 m        = this->variableMasks[i];
+          for (triton::usize k = 0; k < n; k++) d[k] = v[k] & m;
+        }
+
+        /*
+         *  Each instruction runs over all lanes of the block. Loops are
+         *  branch-free for common operators so that the compiler can
+         *  vectorize them. Other operators go through execute().
+         */
+        for (const Instruction& inst : this->instructions) {
+          triton::uint64* r       = L + inst.dst * width;
+          const triton::uint64* a = L + inst.src[0] * width;
+          const triton::uint64* b = L + inst.src[1] * width;
+          const triton::uint64* c = L + inst.src[2] * width;
+          const triton::uint64 m  = inst.mask;
+          const triton::uint32 sz = inst.size;
+          const triton::uint32 im = inst.imm;
+
+          switch (inst.opcode) {
+            case OP_ADD:     for (triton::usize k = 0; k < n; k++) r[k] = (a[k] + b[k]) & m; break;
+            case OP_AND:     for (triton::usize k = 0; k < n; k++) r[k] = a[k] & b[k]; break;
+            case OP_CONCAT:  for (triton::usize k = 0; k < n; k++) r[k] = (a[k] << im) | b[k]; break;
+            case OP_EQ:      for (triton::usize k = 0; k < n; k++) r[k] = (a[k] == b[k]); break;
+            case OP_EXTRACT: for (triton::usize k = 0; k < n; k++) r[k] = (a[k] >> im) & m; break;
+            case OP_ITE:     for (triton::usize k = 0; k < n; k++) r[k] = a[k] ? b[k] : c[k]; break;
+            case OP_LSHR:    for (triton::usize k = 0; k < n; k++) r[k] = (b[k] >= sz) ? 0 : (a[k] >> b[k]); break;
+            case OP_MUL:     for (triton::usize k = 0; k < n; k++) r[k] = (a[k] * b[k]) & m; break;
+            case OP_NAND:    for (triton::usize k = 0; k < n; k++) r[k] = ~(a[k] & b[k]) & m; break;
+            case OP_NE:      for (triton::usize k = 0; k < n; k++) r[k] = (a[k] != b[k]); break;
+            case OP_NEG:     for (triton::usize k = 0; k < n; k++) r[k] = (0 - a[k]) & m; break;
+            case OP_NOR:     for (triton::usize k = 0; k < n; k++) r[k] = ~(a[k] | b[k]) & m; break;
+            case OP_NOT:     for (triton::usize k = 0; k < n; k++) r[k] = ~a[k] & m; break;
+            case OP_OR:      for (triton::usize k = 0; k < n; k++) r[k] = a[k] | b[k]; break;
+            case OP_ROL:     for (triton::usize k = 0; k < n; k++) r[k] = ((a[k] << im) | (a[k] >> (sz - im))) & m; break;
+            case OP_SHL:     for (triton::usize k = 0; k < n; k++) r[k] = (b[k] >= sz) ? 0 : ((a[k] << b[k]) & m); break;
+            case OP_SUB:     for (triton::usize k = 0; k < n; k++) r[k] = (a[k] - b[k]) & m; break;
+            case OP_UGE:     for (triton::usize k = 0; k < n; k++) r[k] = (a[k] >= b[k]); break;
+            case OP_UGT:     for (triton::usize k = 0; k < n; k++) r[k] = (a[k] >  b[k]); break;
+            case OP_ULE:     for (triton::usize k = 0; k < n; k++) r[k] = (a[k] <= b[k]); break;
+            case OP_ULT:     for (triton::usize k = 0; k < n; k++) r[k] = (a[k] <  b[k]); break;
+            case OP_XNOR:    for (triton::usize k = 0; k < n; k++) r[k] = ~(a[k] ^ b[k]) & m; break;
+            case OP_XOR:     for (triton::usize k = 0; k < n; k++) r[k] = a[k] ^ b[k]; break;
+            default:         for (triton::usize k = 0; k < n; k++) r[k] = AstProgram::execute(inst, a[k], b[k], c[k]); break;
+          }
+        }
+
+        std::copy(L + this->result * width, L + this->result * width + n, results + base);
+      }
+    }
+
+  };
+};
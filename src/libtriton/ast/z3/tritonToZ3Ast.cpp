@@ -5,6 +5,8 @@
 **  This program is under the terms of the Apache License 2.0.
 */
 
+#include <algorithm>
+#include <unordered_set>
 #include <vector>
 
 #include <triton/cpuSize.hpp>
@@ -18,9 +20,11 @@
 namespace triton {
   namespace ast {
 
-    TritonToZ3Ast::TritonToZ3Ast(bool eval)
+    TritonToZ3Ast::TritonToZ3Ast(bool eval, bool cache)
       : context() {
-      this->isEval = eval;
+      this->isEval     = eval;
+      this->isCached   = (cache && !eval);
+      this->cacheSwept = 0;
     }
 
 
@@ -28,6 +32,8 @@ namespace triton {
       /* See #828: Release ownership before calling container destructor */
       this->symbols.clear();
       this->variables.clear();
+      /* Cached expressions must be released before the context */
+      this->cache.clear();
     }
 
 
@@ -50,6 +56,9 @@ namespace triton {
 
 
     z3::expr TritonToZ3Ast::convert(const triton::ast::SharedAbstractNode& node) {
+      if (this->isCached)
+        return this->convertCached(node);
+
       std::unordered_map<triton::ast::SharedAbstractNode, z3::expr> results;
 
       auto nodes = triton::ast::childrenExtraction(node, true /* unroll*/, true /* revert */);
@@ -62,6 +71,98 @@ namespace triton {
     }
 
 
+    z3::expr TritonToZ3Ast::convertCached(const triton::ast::SharedAbstractNode& node) {
+      std::unordered_map<triton::ast::SharedAbstractNode, z3::expr> results;
+      std::unordered_set<const triton::ast::AbstractNode*> scoped;
+      std::vector<std::pair<triton::ast::SharedAbstractNode, bool>> worklist;
+
+      if (node == nullptr)
+        throw triton::exceptions::AstTranslations("TritonToZ3Ast::convert(): node cannot be null.");
+
+      /*
+       * Post-order walk which stops at nodes already in the cache, so a
+       * sub-tree (and the references it contains) is only unrolled the
+       * first time it is converted.
+       */
+      worklist.push_back(std::make_pair(node, false));
+      while (!worklist.empty()) {
+        auto n = worklist.back().first;
+        bool expanded = worklist.back().second;
+        worklist.pop_back();
+
+        if (results.find(n) != results.end())
+          continue;
+
+        if (!expanded) {
+          /* A node modified in place (e.g. setChild) is translated again */
+          auto it = this->cache.find(n.get());
+          if (it != this->cache.end() && !it->second.node.expired() && it->second.hash == n->getHash() && it->second.size == n->getBitvectorSize()) {
+            results.insert(std::make_pair(n, it->second.expr));
+            continue;
+          }
+
+          worklist.push_back(std::make_pair(n, true));
+          if (n->getType() == REFERENCE_NODE)
+            worklist.push_back(std::make_pair(reinterpret_cast<triton::ast::ReferenceNode*>(n.get())->getSymbolicExpression()->getAst(), false));
+          const auto& children = n->getChildren();
+          for (auto child = children.rbegin(); child != children.rend(); ++child)
+            worklist.push_back(std::make_pair(*child, false));
+          continue;
+        }
+
+        z3::expr expr = this->do_convert(n, &results);
+        results.insert(std::make_pair(n, expr));
+
+        /* Nodes depending on let symbols are only valid inside their let */
+        bool local = (n->getType() == STRING_NODE);
+        for (auto&& child : n->getChildren())
+          local |= (scoped.find(child.get()) != scoped.end());
+        if (n->getType() == REFERENCE_NODE)
+          local |= (scoped.find(reinterpret_cast<triton::ast::ReferenceNode*>(n.get())->getSymbolicExpression()->getAst().get()) != scoped.end());
+
+        if (local) {
+          scoped.insert(n.get());
+          continue;
+        }
+
+        /* The entry may belong to a dead node which had the same address */
+        CacheEntry entry = {triton::ast::WeakAbstractNode(n), n->getHash(), n->getBitvectorSize(), expr};
+        auto ret = this->cache.insert(std::make_pair(n.get(), entry));
+        if (!ret.second)
+          ret.first->second = entry;
+      }
+
+      /* Sweep dead entries each time the cache doubled since the last sweep */
+      if (this->cache.size() > std::max<triton::usize>(this->cacheSwept * 2, 4096)) {
+        for (auto it = this->cache.begin(); it != this->cache.end();) {
+          if (it->second.node.expired())
+            it = this->cache.erase(it);
+          else
+            ++it;
+        }
+        this->cacheSwept = this->cache.size();
+      }
+
+      return results.at(node);
+    }
+
+
+    z3::context& TritonToZ3Ast::getContext(void) {
+      return this->context;
+    }
+
+
+    triton::usize TritonToZ3Ast::getCacheSize(void) const {
+      return this->cache.size();
+    }
+
+
+    void TritonToZ3Ast::clearCache(void) {
+      this->cache.clear();
+      this->cacheSwept = 0;
+    }
+
+
     z3::expr TritonToZ3Ast::do_convert(const triton::ast::SharedAbstractNode& node, std::unordered_map<triton::ast::SharedAbstractNode, z3::expr>* results) {
       if (node == nullptr)
         throw triton::exceptions::AstTranslations("TritonToZ3Ast::do_convert(): node cannot be null.");
@@ -140,6 +140,12 @@ namespace triton {
         initSolverNamespace(solverDict);
         PyObject* idSolverClass = xPyClass_New(nullptr, solverDict, xPyString_FromString("SOLVER"));
 
+        /* Create the SOLVER_POLICY namespace ======================================================== */
+
+        PyObject* solverPolicyDict = xPyDict_New();
+        initSolverPolicyNamespace(solverPolicyDict);
+        PyObject* idSolverPolicyClass = xPyClass_New(nullptr, solverPolicyDict, xPyString_FromString("SOLVER_POLICY"));
+
         /* Create the SOLVER_STATE namespace ========================================================= */
 
         PyObject* solverStateDict = xPyDict_New();
@@ -189,6 +195,7 @@ namespace triton {
         PyModule_AddObject(triton::bindings::python::tritonModule, "REG",                 idRegClass);
         PyModule_AddObject(triton::bindings::python::tritonModule, "SHIFT",               idShiftsClass);
         PyModule_AddObject(triton::bindings::python::tritonModule, "SOLVER",              idSolverClass);
+        PyModule_AddObject(triton::bindings::python::tritonModule, "SOLVER_POLICY",       idSolverPolicyClass);
         PyModule_AddObject(triton::bindings::python::tritonModule, "SOLVER_STATE",        idSolverStateClass);
         PyModule_AddObject(triton::bindings::python::tritonModule, "SYMBOLIC",            idSymbolicClass);
         #if defined(__unix__) || defined(__APPLE__)
@@ -32,6 +32,7 @@ to wrap more generic concepts.
 
 - \ref py_AstContext_page
 - \ref py_AstNode_page
+- \ref py_AstProgram_page
 - \ref py_BitsVector_page
 - \ref py_Immediate_page
 - \ref py_Instruction_page
@@ -60,6 +61,7 @@ to wrap more generic concepts.
 - \ref py_REG_page
 - \ref py_SHIFT_page
 - \ref py_SOLVER_page
+- \ref py_SOLVER_POLICY_page
 - \ref py_SOLVER_STATE_page
 - \ref py_SYMBOLIC_page
 - \ref py_SYSCALL_page
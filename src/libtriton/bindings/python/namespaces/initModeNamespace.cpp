@@ -34,9 +34,23 @@ The MODE namespace contains all kinds of modes.
 - **MODE.ALIGNED_MEMORY**<br>
 Enabled, Triton will keep a map of aligned memory to reduce the symbolic memory explosion of `LOAD` and `STORE` accesses.
 
+- **MODE.AST_HASH_CONSING**<br>
+Enabled, Triton will share structurally identical nodes (same type, size, payload and children) instead of allocating duplicates.
+Two identical sub-trees built separately are then the same node.
+
+- **MODE.AST_LAZY_EVALUATION**<br>
+Enabled, updating the value of a symbolic variable does not re-evaluate all the nodes which use it. Updates only
+bump an evaluation epoch and a node is re-evaluated (and memoized) when `evaluate()` is called on it or on one
+of its ancestors. A batch of updates thus costs O(1).
+
 - **MODE.AST_OPTIMIZATIONS**<br>
 Enabled, Triton will reduces the depth of the trees using classical arithmetic optimisations.
 
+- **MODE.AST_SLAB_ALLOCATOR**<br>
+Enabled, Triton will allocate AST nodes from slab pools owned by the AST context. Nodes built one after the
+other are contiguous in memory, freed nodes are recycled without going back to the global heap and slabs are
+released in bulk when the context and its nodes die.
+
 - **MODE.CONCRETIZE_UNDEFINED_REGISTERS**<br>
 Enabled, Triton will concretize every register tagged as undefined (see #750).
 
@@ -49,6 +63,9 @@ Enabled, Triton will perform symbolic execution only on symbolized expressions.
 - **MODE.ONLY_ON_TAINTED**<br>
 Enabled, Triton will perform symbolic execution only on tainted instructions.
 
+- **MODE.PC_DEDUPLICATION**<br>
+Enabled, Triton will skip a path constraint if its taken predicate is equal to the one of a path constraint already pushed by the same branch instruction (e.g. the iterations of a loop).
+
 - **MODE.PC_TRACKING_SYMBOLIC**<br>
 Enabled, Triton will track path constraints only if they are symbolized. This mode is enabled by default.
 
@@ -67,11 +84,15 @@ namespace triton {
 
       void initModeNamespace(PyObject* modeDict) {
         xPyDict_SetItemString(modeDict, "ALIGNED_MEMORY",                 PyLong_FromUint32(triton::modes::ALIGNED_MEMORY));
+        xPyDict_SetItemString(modeDict, "AST_HASH_CONSING",               PyLong_FromUint32(triton::modes::AST_HASH_CONSING));
+        xPyDict_SetItemString(modeDict, "AST_LAZY_EVALUATION",            PyLong_FromUint32(triton::modes::AST_LAZY_EVALUATION));
         xPyDict_SetItemString(modeDict, "AST_OPTIMIZATIONS",              PyLong_FromUint32(triton::modes::AST_OPTIMIZATIONS));
+        xPyDict_SetItemString(modeDict, "AST_SLAB_ALLOCATOR",             PyLong_FromUint32(triton::modes::AST_SLAB_ALLOCATOR));
         xPyDict_SetItemString(modeDict, "CONCRETIZE_UNDEFINED_REGISTERS", PyLong_FromUint32(triton::modes::CONCRETIZE_UNDEFINED_REGISTERS));
         xPyDict_SetItemString(modeDict, "CONSTANT_FOLDING",               PyLong_FromUint32(triton::modes::CONSTANT_FOLDING));
         xPyDict_SetItemString(modeDict, "ONLY_ON_SYMBOLIZED",             PyLong_FromUint32(triton::modes::ONLY_ON_SYMBOLIZED));
         xPyDict_SetItemString(modeDict, "ONLY_ON_TAINTED",                PyLong_FromUint32(triton::modes::ONLY_ON_TAINTED));
+        xPyDict_SetItemString(modeDict, "PC_DEDUPLICATION",               PyLong_FromUint32(triton::modes::PC_DEDUPLICATION));
         xPyDict_SetItemString(modeDict, "PC_TRACKING_SYMBOLIC",           PyLong_FromUint32(triton::modes::PC_TRACKING_SYMBOLIC));
         xPyDict_SetItemString(modeDict, "SYMBOLIZE_INDEX_ROTATION",       PyLong_FromUint32(triton::modes::SYMBOLIZE_INDEX_ROTATION));
         xPyDict_SetItemString(modeDict, "TAINT_THROUGH_POINTERS",         PyLong_FromUint32(triton::modes::TAINT_THROUGH_POINTERS));
@@ -25,6 +25,8 @@ The SOLVER namespace contains all kinds of solver status.
 \section SOLVER_py_api Python API - Items of the SOLVER namespace
 <hr>
 
+- **SOLVER.LOCAL_SEARCH**
+- **SOLVER.SMTLIB**
 - **SOLVER.Z3**
 
 */
@@ -38,6 +40,8 @@ namespace triton {
       void initSolverNamespace(PyObject* solverDict) {
         PyDict_Clear(solverDict);
 
+        xPyDict_SetItemString(solverDict, "LOCAL_SEARCH", PyLong_FromUint32(triton::engines::solver::SOLVER_LOCAL_SEARCH));
+        xPyDict_SetItemString(solverDict, "SMTLIB", PyLong_FromUint32(triton::engines::solver::SOLVER_SMTLIB));
         xPyDict_SetItemString(solverDict, "Z3", PyLong_FromUint32(triton::engines::solver::SOLVER_Z3));
       }
 
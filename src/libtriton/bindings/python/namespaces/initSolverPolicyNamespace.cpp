@@ -0,0 +1,50 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the Apache License 2.0.
+*/
+
+#include <triton/pythonBindings.hpp>
+#include <triton/pythonUtils.hpp>
+#include <triton/pythonXFunctions.hpp>
+#include <triton/solverEnums.hpp>
+
+
+
+/*! \page py_SOLVER_POLICY_page SOLVER_POLICY
+    \brief [**python api**] All information about the SOLVER_POLICY Python namespace.
+
+\tableofcontents
+
+\section SOLVER_POLICY_py_description Description
+<hr>
+
+The SOLVER_POLICY namespace contains all kinds of path constraints given to the solver by path-aware queries.
+
+\section SOLVER_POLICY_py_api Python API - Items of the SOLVER_POLICY namespace
+<hr>
+
+- **SOLVER_POLICY.FULL**: the full path predicate.
+- **SOLVER_POLICY.LAST**: the query alone.
+- **SOLVER_POLICY.NESTED**: the path constraints sharing variables with the query.
+
+*/
+
+
+
+namespace triton {
+  namespace bindings {
+    namespace python {
+
+      void initSolverPolicyNamespace(PyObject* solverPolicyDict) {
+        PyDict_Clear(solverPolicyDict);
+
+        xPyDict_SetItemString(solverPolicyDict, "FULL",   PyLong_FromUint32(triton::engines::solver::POLICY_FULL));
+        xPyDict_SetItemString(solverPolicyDict, "LAST",   PyLong_FromUint32(triton::engines::solver::POLICY_LAST));
+        xPyDict_SetItemString(solverPolicyDict, "NESTED", PyLong_FromUint32(triton::engines::solver::POLICY_NESTED));
+      }
+
+    }; /* python namespace */
+  }; /* bindings namespace */
+}; /* triton namespace */
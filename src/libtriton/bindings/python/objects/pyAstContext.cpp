@@ -9,6 +9,7 @@
 #include <triton/pythonUtils.hpp>
 #include <triton/pythonXFunctions.hpp>
 #include <triton/astContext.hpp>
+#include <triton/astProgram.hpp>
 #include <triton/config.hpp>
 #include <triton/exceptions.hpp>
 #include <triton/register.hpp>
@@ -184,6 +185,9 @@ e.g: `(bvxnor node1 node2)`.
 Creates a `bvxor` node.<br>
 e.g: `(bvxor node1 epxr2)`.
 
+- <b>\ref py_AstProgram_page compile(\ref py_AstNode_page node)</b><br>
+Compiles a node into a linear program which evaluates it on native integers. Only bit-vectors up to 64 bits are supported.
+
 - <b>\ref py_AstNode_page concat([\ref py_AstNode_page, ...])</b><br>
 Concatenates several nodes.
 
@@ -1141,6 +1145,19 @@ namespace triton {
       }
 
 
+      static PyObject* AstContext_compile(PyObject* self, PyObject* node) {
+        if (!PyAstNode_Check(node))
+          return PyErr_Format(PyExc_TypeError, "compile(): Expects a AstNode as argument.");
+
+        try {
+          return PyAstProgram(triton::ast::AstProgram(PyAstNode_AsAstNode(node)));
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
       static PyObject* AstContext_compound(PyObject* self, PyObject* exprsList) {
         std::vector<triton::ast::SharedAbstractNode> exprs;
 
@@ -1704,6 +1721,7 @@ namespace triton {
         {"bvurem",          AstContext_bvurem,          METH_VARARGS,     ""},
         {"bvxnor",          AstContext_bvxnor ,         METH_VARARGS,     ""},
         {"bvxor",           AstContext_bvxor,           METH_VARARGS,     ""},
+        {"compile",         AstContext_compile,         METH_O,           ""},
         {"compound",        AstContext_compound,        METH_O,           ""},
         {"concat",          AstContext_concat,          METH_O,           ""},
         {"declare",         AstContext_declare,         METH_O,           ""},
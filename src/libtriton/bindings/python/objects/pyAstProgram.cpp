@@ -0,0 +1,268 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the Apache License 2.0.
+*/
+
+#include <triton/pythonObjects.hpp>
+#include <triton/pythonUtils.hpp>
+#include <triton/pythonXFunctions.hpp>
+#include <triton/astProgram.hpp>
+#include <triton/exceptions.hpp>
+
+
+
+/*! \page py_AstProgram_page AstProgram
+    \brief [**python api**] All information about the AstProgram Python object.
+
+\tableofcontents
+
+\section py_AstProgram_description Description
+<hr>
+
+This object is used to represent an AST compiled into a linear program. Evaluating a program
+does not touch the concrete values of symbolic variables, values are given as a list ordered
+as `getVariables()`, that is by variable id. Only bit-vectors up to 64 bits are supported.
+
+~~~~~~~~~~~~~{.py}
+>>> from triton import TritonContext, ARCH
+
+>>> ctxt = TritonContext()
+>>> ctxt.setArchitecture(ARCH.X86_64)
+>>> astCtxt = ctxt.getAstContext()
+
+>>> x = astCtxt.variable(ctxt.newSymbolicVariable(32))
+>>> y = astCtxt.variable(ctxt.newSymbolicVariable(32))
+>>> prog = astCtxt.compile(astCtxt.bvadd(astCtxt.bvmul(x, astCtxt.bv(3, 32)), y))
+>>> [str(v) for v in prog.getVariables()]
+['SymVar_0:32', 'SymVar_1:32']
+>>> prog.evaluate([2, 1])
+7
+>>> prog.evaluateBatch([[0, 0], [1, 2], [3, 4]])
+[0, 5, 13]
+
+~~~~~~~~~~~~~
+
+\section AstProgram_py_api Python API - Methods of the AstProgram class
+<hr>
+
+- <b>integer evaluate([integer, ...])</b><br>
+Evaluates the program. The i-th value of the list is the value of the i-th variable.
+
+- <b>[integer, ...] evaluateBatch([[integer, ...], ...])</b><br>
+Evaluates the program on several assignments and returns one result per assignment. Each assignment
+is a list of values ordered as `getVariables()`. This is much faster than several calls to `evaluate()`.
+
+- <b>integer getBitvectorSize(void)</b><br>
+Returns the size (in bits) of the result.
+
+- <b>integer getNumberOfInstructions(void)</b><br>
+Returns the number of instructions of the program.
+
+- <b>[\ref py_SymbolicVariable_page, ...] getVariables(void)</b><br>
+Returns the symbolic variables, in the order expected by `evaluate()`.
+
+*/
+
+
+
+namespace triton {
+  namespace bindings {
+    namespace python {
+
+      //! AstProgram destructor.
+      void AstProgram_dealloc(PyObject* self) {
+        std::cout << std::flush;
+        delete PyAstProgram_AsAstProgram(self);
+        Py_TYPE(self)->tp_free((PyObject*)self);
+      }
+
+
+      static PyObject* AstProgram_evaluate(PyObject* self, PyObject* valuesList) {
+        std::vector<triton::uint64> values;
+
+        if (valuesList == nullptr || !PyList_Check(valuesList))
+          return PyErr_Format(PyExc_TypeError, "AstProgram::evaluate(): Expects a list of integers as argument.");
+
+        for (Py_ssize_t i = 0; i < PyList_Size(valuesList); i++) {
+          PyObject* item = PyList_GetItem(valuesList, i);
+
+          if (!PyLong_Check(item) && !PyInt_Check(item))
+            return PyErr_Format(PyExc_TypeError, "AstProgram::evaluate(): Each element from the list must be an integer.");
+
+          values.push_back(PyLong_AsUint64(item));
+        }
+
+        try {
+          return PyLong_FromUint64(PyAstProgram_AsAstProgram(self)->evaluate(values));
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* AstProgram_evaluateBatch(PyObject* self, PyObject* assignmentsList) {
+        std::vector<std::vector<triton::uint64>> assignments;
+
+        if (assignmentsList == nullptr || !PyList_Check(assignmentsList))
+          return PyErr_Format(PyExc_TypeError, "AstProgram::evaluateBatch(): Expects a list of lists of integers as argument.");
+
+        for (Py_ssize_t i = 0; i < PyList_Size(assignmentsList); i++) {
+          PyObject* valuesList = PyList_GetItem(assignmentsList, i);
+          std::vector<triton::uint64> values;
+
+          if (!PyList_Check(valuesList))
+            return PyErr_Format(PyExc_TypeError, "AstProgram::evaluateBatch(): Each element from the list must be a list of integers.");
+
+          for (Py_ssize_t j = 0; j < PyList_Size(valuesList); j++) {
+            PyObject* item = PyList_GetItem(valuesList, j);
+
+            if (!PyLong_Check(item) && !PyInt_Check(item))
+              return PyErr_Format(PyExc_TypeError, "AstProgram::evaluateBatch(): Each element from the list must be a list of integers.");
+
+            values.push_back(PyLong_AsUint64(item));
+          }
+
+          assignments.push_back(std::move(values));
+        }
+
+        try {
+          std::vector<triton::uint64> results = PyAstProgram_AsAstProgram(self)->evaluateBatch(assignments);
+          PyObject* ret = xPyList_New(results.size());
+
+          for (triton::usize index = 0; index < results.size(); index++)
+            PyList_SetItem(ret, index, PyLong_FromUint64(results[index]));
+
+          return ret;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* AstProgram_getBitvectorSize(PyObject* self, PyObject* noarg) {
+        try {
+          return PyLong_FromUint32(PyAstProgram_AsAstProgram(self)->getBitvectorSize());
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* AstProgram_getNumberOfInstructions(PyObject* self, PyObject* noarg) {
+        try {
+          return PyLong_FromUsize(PyAstProgram_AsAstProgram(self)->getNumberOfInstructions());
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* AstProgram_getVariables(PyObject* self, PyObject* noarg) {
+        try {
+          const auto& variables = PyAstProgram_AsAstProgram(self)->getVariables();
+          PyObject* ret = xPyList_New(variables.size());
+
+          for (triton::usize index = 0; index < variables.size(); index++)
+            PyList_SetItem(ret, index, PySymbolicVariable(variables[index]));
+
+          return ret;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      //! AstProgram methods.
+      PyMethodDef AstProgram_callbacks[] = {
+        {"evaluate",                AstProgram_evaluate,                METH_O,         ""},
+        {"evaluateBatch",           AstProgram_evaluateBatch,           METH_O,         ""},
+        {"getBitvectorSize",        AstProgram_getBitvectorSize,        METH_NOARGS,    ""},
+        {"getNumberOfInstructions", AstProgram_getNumberOfInstructions, METH_NOARGS,    ""},
+        {"getVariables",            AstProgram_getVariables,            METH_NOARGS,    ""},
+        {nullptr,                   nullptr,                            0,              nullptr}
+      };
+
+
+      PyTypeObject AstProgram_Type = {
+        PyVarObject_HEAD_INIT(&PyType_Type, 0)
+        "AstProgram",                               /* tp_name */
+        sizeof(AstProgram_Object),                  /* tp_basicsize */
+        0,                                          /* tp_itemsize */
+        (destructor)AstProgram_dealloc,             /* tp_dealloc */
+        0,                                          /* tp_print or tp_vectorcall_offset */
+        0,                                          /* tp_getattr */
+        0,                                          /* tp_setattr */
+        0,                                          /* tp_compare */
+        0,                                          /* tp_repr */
+        0,                                          /* tp_as_number */
+        0,                                          /* tp_as_sequence */
+        0,                                          /* tp_as_mapping */
+        0,                                          /* tp_hash */
+        0,                                          /* tp_call */
+        0,                                          /* tp_str */
+        0,                                          /* tp_getattro */
+        0,                                          /* tp_setattro */
+        0,                                          /* tp_as_buffer */
+        Py_TPFLAGS_DEFAULT,                         /* tp_flags */
+        "AstProgram objects",                       /* tp_doc */
+        0,                                          /* tp_traverse */
+        0,                                          /* tp_clear */
+        0,                                          /* tp_richcompare */
+        0,                                          /* tp_weaklistoffset */
+        0,                                          /* tp_iter */
+        0,                                          /* tp_iternext */
+        AstProgram_callbacks,                       /* tp_methods */
+        0,                                          /* tp_members */
+        0,                                          /* tp_getset */
+        0,                                          /* tp_base */
+        0,                                          /* tp_dict */
+        0,                                          /* tp_descr_get */
+        0,                                          /* tp_descr_set */
+        0,                                          /* tp_dictoffset */
+        0,                                          /* tp_init */
+        0,                                          /* tp_alloc */
+        0,                                          /* tp_new */
+        0,                                          /* tp_free */
+        0,                                          /* tp_is_gc */
+        0,                                          /* tp_bases */
+        0,                                          /* tp_mro */
+        0,                                          /* tp_cache */
+        0,                                          /* tp_subclasses */
+        0,                                          /* tp_weaklist */
+        0,                                          /* tp_del */
+        #if IS_PY3
+          0,                                        /* tp_version_tag */
+          0,                                        /* tp_finalize */
+          #if IS_PY3_8
+            0,                                      /* tp_vectorcall */
+            #if !IS_PY3_9
+              0,                                    /* bpo-37250: kept for backwards compatibility in CPython 3.8 only */
+            #endif
+          #endif
+        #else
+          0                                         /* tp_version_tag */
+        #endif
+      };
+
+
+      PyObject* PyAstProgram(const triton::ast::AstProgram& prog) {
+        AstProgram_Object* object;
+
+        PyType_Ready(&AstProgram_Type);
+        object = PyObject_NEW(AstProgram_Object, &AstProgram_Type);
+        if (object != NULL)
+          object->prog = new triton::ast::AstProgram(prog);
+
+        return (PyObject*)object;
+      }
+
+    }; /* python namespace */
+  }; /* bindings namespace */
+}; /* triton namespace */
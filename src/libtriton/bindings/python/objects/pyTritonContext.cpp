@@ -13,6 +13,8 @@
 #include <triton/exceptions.hpp>
 #include <triton/register.hpp>
 
+#include <algorithm>
+
 
 
 /*! \page py_TritonContext_page TritonContext
@@ -42,6 +44,11 @@ libTriton offers Python bindings on top of its C++ API which allow you to build
 - <b>void addCallback(\ref py_CALLBACK_page kind, function cb)</b><br>
 Adds a callback at specific internal points. Your callback will be called each time the point is reached.
 
+- <b>void addSimplificationRule(string rule)</b><br>
+Adds a rewrite rule applied by the symbolic simplification without any Python callback. A rule is written as `pattern -> replacement`
+in SMT-LIB prefix form (e.g. `(bvxor x x) -> 0`) or with Python's operators (e.g. `(a & ~b) | (~a & b) -> a ^ b`). Identifiers are
+pattern variables and constants without explicit size (`(_ bvX size)` or `#x..`) take the size of their context.
+
 - <b>void assignSymbolicExpressionToMemory(\ref py_SymbolicExpression_page symExpr, \ref py_MemoryAccess_page mem)</b><br>
 Assigns a \ref py_SymbolicExpression_page to a \ref py_MemoryAccess_page area. **Be careful**, use this function only if you know what you are doing.
 The symbolic expression (`symExpr`) must be aligned to the memory access.
@@ -68,6 +75,12 @@ Clears concrete values assigned to the memory cells from `addr` to `addr + size`
 - <b>void clearPathConstraints(void)</b><br>
 Clears the current path predicate.
 
+- <b>void clearSimplificationRules(void)</b><br>
+Removes all rewrite rules.
+
+- <b>void clearSolverCache(void)</b><br>
+Removes all answers from the solver cache and resets its hit and miss counters.
+
 - <b>void concretizeAllMemory(void)</b><br>
 Concretizes all symbolic memory references.
 
@@ -110,6 +123,16 @@ Enables or disables the taint engine.
 - <b>integer evaluateAstViaZ3(\ref py_AstNode_page node)</b><br>
 Evaluates an AST via Z3 and returns the symbolic value.
 
+- <b>[dict, ...] flipPathConstraints(callback=None, threads=0, timeout=0)</b><br>
+Computes a model for each branch not taken by the current path, in parallel. For each branch not taken, the query is the branch
+constraint under the path constraints which precede it. Queries are solved on `threads` worker threads (0 for one per core), each
+owning its own z3 context, with a `timeout` (in milliseconds) per query, 0 for the solver timeout. Each answer is a dictionary
+{'index': integer, 'srcAddr': integer, 'dstAddr': integer, 'status': \ref py_SOLVER_STATE_page, 'solvingTime': integer,
+'strategy': \ref py_SOLVER_POLICY_page, 'model': {integer symVarId : \ref py_SolverModel_page model}} where `index` is the index of
+the path constraint and `strategy` the path constraints which gave the answer (See: setSolverPolicy()). If `callback` is
+defined, it is called with each answer as soon as it completes and the function returns None. Otherwise, answers are returned
+as a list sorted by path index.
+
 - <b>[\ref py_Register_page, ...] getAllRegisters(void)</b><br>
 Returns the list of all registers. Each item of this list is a \ref py_Register_page.
 
@@ -146,6 +169,13 @@ Returns the size in bytes of the General Purpose Registers.
 - <b>\ref py_AstNode_page getImmediateAst(\ref py_Immediate_page imm)</b><br>
 Returns the AST corresponding to the \ref py_Immediate_page.
 
+- <b>[\ref py_PathConstraint_page, ...] getLoggedPathConstraints(integer start, integer end)</b><br>
+Reads back the path constraints moved to the log (see setPathConstraintLog()) from a given range. They are older than the path
+constraints returned by getPathConstraints().
+
+- <b>integer getMaxSimplificationIterations(void)</b><br>
+Returns the maximum number of times simplification rules and callbacks are applied on a node.
+
 - <b>\ref py_AstNode_page getMemoryAst(\ref py_MemoryAccess_page mem)</b><br>
 Returns the AST corresponding to the \ref py_MemoryAccess_page with the SSA form.
 
@@ -153,8 +183,17 @@ Returns the AST corresponding to the \ref py_MemoryAccess_page with the SSA form
 Computes and returns a model as a dictionary of {integer symVarId : \ref py_SolverModel_page model} from a symbolic constraint.
 If status is True, returns a tuple of (dict model, \ref py_SOLVER_STATE_page status, integer solvingTime).
 
-- <b>[dict, ...] getModels(\ref py_AstNode_page node, integer limit, status=False, timeout=0)</b><br>
+- <b>dict getModelOnPath(\ref py_AstNode_page node, integer prefix, status=False, timeout=0, strategy=False)</b><br>
+Computes and returns a model as a dictionary of {integer symVarId : \ref py_SolverModel_page model} from a symbolic constraint and the
+first `prefix` path constraints. The query is solved by an incremental solver session which keeps the path constraints already asserted
+by previous queries, so flipping the branches of a path one after the other only translates each path constraint once.
+If status is True, returns a tuple of (dict model, \ref py_SOLVER_STATE_page status, integer solvingTime). If strategy is True,
+returns a tuple of (dict model, \ref py_SOLVER_STATE_page status, integer solvingTime, \ref py_SOLVER_POLICY_page strategy)
+where `strategy` tells which path constraints gave the answer (See: setSolverPolicy()).
+
+- <b>[dict, ...] getModels(\ref py_AstNode_page node, integer limit, status=False, timeout=0, variables=[])</b><br>
 Computes and returns several models from a symbolic constraint. The `limit` is the number of models returned.
+If `variables` is a non-empty list of \ref py_SymbolicVariable_page, models only hold these variables and differ by at least one of them.
 If status is True, returns a tuple of ([dict model, ...], \ref py_SOLVER_STATE_page status, integer solvingTime).
 
 - <b>\ref py_Register_page getParentRegister(\ref py_Register_page reg)</b><br>
@@ -172,6 +211,13 @@ Returns the current path predicate as an AST of logical conjunction of each take
 - <b>integer getPathPredicateSize(void)</b><br>
 Returns the size of the path predicate (number of constraints).
 
+- <b>\ref py_AstNode_page getPathPredicateSlice(\ref py_AstNode_page node, integer prefix=None)</b><br>
+Returns the conjunction of `node` and of the path constraints which are not independent from it. Path constraints are partitioned
+into clusters of constraints sharing symbolic variables, and only the cluster of `node` is kept, so a model of the slice only
+constrains the variables of this cluster and the other ones keep their concrete values. If `prefix` is defined, only the first
+`prefix` path constraints are considered. E.g: `getPathPredicateSlice(astCtxt.lnot(pc[i].getTakenPredicate()), i)` flips the
+i-th branch.
+
 - <b>[\ref py_AstNode_page, ...] getPredicatesToReachAddress(integer addr)</b><br>
 Returns path predicates which may reach the targeted address.
 
@@ -184,6 +230,24 @@ Returns the \ref py_Register_page class corresponding to a string.
 - <b>\ref py_AstNode_page getRegisterAst(\ref py_Register_page reg)</b><br>
 Returns the AST corresponding to the \ref py_Register_page with the SSA form.
 
+- <b>[string, ...] getSimplificationRules(void)</b><br>
+Returns all rewrite rules.
+
+- <b>integer getSizeOfLoggedPathConstraints(void)</b><br>
+Returns the number of path constraints moved to the log (see setPathConstraintLog()).
+
+- <b>integer getSolverCacheHits(void)</b><br>
+Returns the number of queries answered by the solver cache.
+
+- <b>integer getSolverCacheMisses(void)</b><br>
+Returns the number of queries forwarded by the solver cache to the solver.
+
+- <b>integer getSolverFastPathHits(void)</b><br>
+Returns the number of queries answered by the solver fast path.
+
+- <b>\ref py_SOLVER_POLICY_page getSolverPolicy(void)</b><br>
+Returns the weakest path constraints given to the solver by getModelOnPath(), isSatOnPath() and flipPathConstraints().
+
 - <b>\ref py_SymbolicExpression_page getSymbolicExpression(integer symExprId)</b><br>
 Returns the symbolic expression corresponding to an id.
 
@@ -271,6 +335,12 @@ Returns true if the register is valid.
 - <b>bool isSat(\ref py_AstNode_page node)</b><br>
 Returns true if an expression is satisfiable.
 
+- <b>bool isSatOnPath(\ref py_AstNode_page node, integer prefix)</b><br>
+Returns true if an expression and the first `prefix` path constraints are satisfiable, using the incremental solver session.
+
+- <b>bool isSolverFastPathEnabled(void)</b><br>
+Returns true if the solver fast path is enabled.
+
 - <b>bool isSymbolicEngineEnabled(void)</b><br>
 Returns true if the symbolic execution engine is enabled.
 
@@ -283,6 +353,11 @@ Returns true if the taint engine is enabled.
 - <b>bool isThumb(void)</b><br>
 Returns true if execution mode is Thumb (only valid for ARM32).
 
+- <b>void mapConcreteMemoryFile(integer baseAddr, string path, integer offset, integer size)</b><br>
+Maps `size` bytes of a file from `offset` at `baseAddr`, without copying them. The file is memory-mapped read-only and its
+pages are shared with the other processes mapping it, a page is only copied when it is written (copy-on-write). The mapped
+memory is concretized.
+
 - <b>\ref py_SymbolicExpression_page newSymbolicExpression(\ref py_AstNode_page node, string comment)</b><br>
 Returns a new symbolic expression. Note that if there are simplification passes recorded, simplifications will be applied.
 
@@ -307,6 +382,9 @@ Removes a recorded callback.
 - <b>void reset(void)</b><br>
 Resets everything.
 
+- <b>void resetSolverSession(void)</b><br>
+Destroys the incremental solver session used by getModelOnPath() and isSatOnPath().
+
 - <b>void setArchitecture(\ref py_ARCH_page arch)</b><br>
 Initializes an architecture. This function must be called before any call to the rest of the API.
 
@@ -336,15 +414,50 @@ the symbolic state (if it exists). You should probably use the concretize functi
 - <b>void setConcreteVariableValue(\ref py_SymbolicVariable_page symVar, integer value)</b><br>
 Sets the concrete value of a symbolic variable.
 
+- <b>void setMaxPathConstraintsPerSite(integer limit)</b><br>
+Sets the maximum number of path constraints pushed per branch instruction (0 by default, unlimited). Once a branch reaches
+the limit (e.g. in a loop), its next path constraints are not recorded, which weakens the path predicate but bounds its size.
+
+- <b>void setMaxSimplificationIterations(integer iterations)</b><br>
+Sets the maximum number of times simplification callbacks are applied on a node until it does not change anymore (1 by default).
+
 - <b>void setMode(\ref py_MODE_page mode, bool flag)</b><br>
 Enables or disables a specific mode.
 
+- <b>void setPathConstraintLog(string path, integer window)</b><br>
+Enables the log of path constraints into the file at `path`. Once 2 * `window` path constraints are in memory, the oldest ones are
+written to the log and released, keeping `window` of them. The path predicate only covers the path constraints in memory, the
+logged ones are read back with getLoggedPathConstraints(). An empty path disables the log.
+
 - <b>void setSolver(\ref py_SOLVER_page solver)</b><br>
 Defines an SMT solver
 
+- <b>void setSolverCacheCapacity(integer entries)</b><br>
+Defines the max number of answers kept by the solver cache, 0 (the default) disables the cache. When enabled, getModel(), getModels()
+and isSat() first look for the query in the cache. A query is seen as the set of its conjuncts. The same query gets the cached answer,
+a query containing the conjuncts of a cached UNSAT query is UNSAT and a query containing the conjuncts of a cached SAT query is SAT if
+the cached model, evaluated concretely, also satisfies it.
+
+- <b>void setSolverCommands([[string, ...], ...] commands)</b><br>
+Defines the commands of the SOLVER.SMTLIB solver, e.g. `[['z3', '-in'], ['cvc5', '--lang', 'smt2', '--incremental']]`. Each command is
+a long-running process reading SMT-LIB2 on its standard input. Queries are raced between the commands, the first `sat` or `unsat` answer
+wins. Processes are killed on timeout and their memory is limited by setSolverMemoryLimit().
+
+- <b>void setSolverFastPath(bool flag)</b><br>
+Enables or disables the solver fast path (disabled by default). When enabled, getModel(), getModels() and isSat() answer trivial
+queries without the solver: conjunctions of comparisons between a constant and an affine term over a single variable of at most
+64 bits, such as `(= ((_ extract 7 0) SymVar_0) (_ bv65 8))`, an unsigned or signed range check, or a linear equation over one byte.
+Models are enumerated in ascending order. Other queries are given to the solver.
+
 - <b>void setSolverMemoryLimit(integer megabytes)</b><br>
 Defines a solver memory consumption limit (in megabytes)
 
+- <b>void setSolverPolicy(\ref py_SOLVER_POLICY_page policy)</b><br>
+Defines the weakest path constraints given to the solver by getModelOnPath(), isSatOnPath() and flipPathConstraints(), SOLVER_POLICY.FULL
+by default. A query without model under the full path predicate is retried, as allowed by the policy, with the path constraints sharing
+variables with the query (SOLVER_POLICY.NESTED, only if the full query was not UNSAT as both are then equisatisfiable), then with the query
+alone (SOLVER_POLICY.LAST). Models of weaker queries may not follow the path and must be checked by running the input.
+
 - <b>void setSolverTimeout(integer ms)</b><br>
 Defines a solver timeout (in milliseconds)
 
@@ -682,6 +795,22 @@ namespace triton {
       }
 
 
+      static PyObject* TritonContext_addSimplificationRule(PyObject* self, PyObject* rule) {
+        if (rule == nullptr || !PyStr_Check(rule))
+          return PyErr_Format(PyExc_TypeError, "TritonContext::addSimplificationRule(): Expects a string as argument.");
+
+        try {
+          PyTritonContext_AsTritonContext(self)->addSimplificationRule(PyStr_AsString(rule));
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        Py_INCREF(Py_None);
+        return Py_None;
+      }
+
+
       static PyObject* TritonContext_assignSymbolicExpressionToMemory(PyObject* self, PyObject* args) {
         PyObject* se  = nullptr;
         PyObject* mem = nullptr;
@@ -848,6 +977,32 @@ namespace triton {
       }
 
 
+      static PyObject* TritonContext_clearSimplificationRules(PyObject* self, PyObject* noarg) {
+        try {
+          PyTritonContext_AsTritonContext(self)->clearSimplificationRules();
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        Py_INCREF(Py_None);
+        return Py_None;
+      }
+
+
+      static PyObject* TritonContext_clearSolverCache(PyObject* self, PyObject* noarg) {
+        try {
+          PyTritonContext_AsTritonContext(self)->clearSolverCache();
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        Py_INCREF(Py_None);
+        return Py_None;
+      }
+
+
       static PyObject* TritonContext_concretizeAllMemory(PyObject* self, PyObject* noarg) {
         try {
           PyTritonContext_AsTritonContext(self)->concretizeAllMemory();
@@ -1162,6 +1317,113 @@ namespace triton {
       }
 
 
+      static PyObject* TritonContext_flipPathConstraints(PyObject* self, PyObject* args, PyObject* kwargs) {
+        triton::uint32 threads_c = 0;
+        triton::uint32 timeout_c = 0;
+
+        PyObject* callback = nullptr;
+        PyObject* threads  = nullptr;
+        PyObject* timeout  = nullptr;
+
+        static char* keywords[] = {
+          (char*)"callback",
+          (char*)"threads",
+          (char*)"timeout",
+          nullptr
+        };
+
+        /* Extract Keywords */
+        if (PyArg_ParseTupleAndKeywords(args, kwargs, "|OOO", keywords, &callback, &threads, &timeout) == false) {
+          return PyErr_Format(PyExc_TypeError, "TritonContext::flipPathConstraints(): Invalid keyword argument.");
+        }
+
+        if (callback == Py_None) {
+          callback = nullptr;
+        }
+
+        if (callback != nullptr && !PyCallable_Check(callback)) {
+          return PyErr_Format(PyExc_TypeError, "TritonContext::flipPathConstraints(): Expects a function as callback keyword.");
+        }
+
+        if (threads != nullptr && (!PyLong_Check(threads) && !PyInt_Check(threads))) {
+          return PyErr_Format(PyExc_TypeError, "TritonContext::flipPathConstraints(): Expects an integer as threads keyword.");
+        }
+
+        if (timeout != nullptr && (!PyLong_Check(timeout) && !PyInt_Check(timeout))) {
+          return PyErr_Format(PyExc_TypeError, "TritonContext::flipPathConstraints(): Expects an integer as timeout keyword.");
+        }
+
+        if (threads != nullptr) {
+          threads_c = PyLong_AsUint32(threads);
+        }
+
+        if (timeout != nullptr) {
+          timeout_c = PyLong_AsUint32(timeout);
+        }
+
+        auto toDict = [](const triton::engines::solver::ParallelSolver::Result& result) {
+          PyObject* model = xPyDict_New();
+          for (auto it = result.model.begin(); it != result.model.end(); it++) {
+            xPyDict_SetItem(model, PyLong_FromUsize(it->first), PySolverModel(it->second));
+          }
+
+          PyObject* dict = xPyDict_New();
+          xPyDict_SetItem(dict, xPyString_FromString("index"),       PyLong_FromUsize(result.index));
+          xPyDict_SetItem(dict, xPyString_FromString("srcAddr"),     PyLong_FromUint64(result.srcAddr));
+          xPyDict_SetItem(dict, xPyString_FromString("dstAddr"),     PyLong_FromUint64(result.dstAddr));
+          xPyDict_SetItem(dict, xPyString_FromString("status"),      PyLong_FromUint32(result.status));
+          xPyDict_SetItem(dict, xPyString_FromString("solvingTime"), PyLong_FromUint32(result.solvingTime));
+          xPyDict_SetItem(dict, xPyString_FromString("strategy"),    PyLong_FromUint32(result.strategy));
+          xPyDict_SetItem(dict, xPyString_FromString("model"),       model);
+          return dict;
+        };
+
+        try {
+          /* Answers are streamed to the Python callback, which runs on this thread */
+          if (callback != nullptr) {
+            PyTritonContext_AsTritonContext(self)->flipPathConstraints([&](const triton::engines::solver::ParallelSolver::Result& result) {
+              PyObject* cbArgs = triton::bindings::python::xPyTuple_New(1);
+              PyTuple_SetItem(cbArgs, 0, toDict(result));
+
+              /* Call the callback */
+              PyObject* ret = PyObject_CallObject(callback, cbArgs);
+              Py_DECREF(cbArgs);
+
+              /* Check the call */
+              if (ret == nullptr) {
+                throw triton::exceptions::PyCallbacks();
+              }
+              Py_DECREF(ret);
+            }, threads_c, timeout_c);
+
+            Py_INCREF(Py_None);
+            return Py_None;
+          }
+
+          std::vector<triton::engines::solver::ParallelSolver::Result> results;
+          PyTritonContext_AsTritonContext(self)->flipPathConstraints([&](const triton::engines::solver::ParallelSolver::Result& result) {
+            results.push_back(result);
+          }, threads_c, timeout_c);
+
+          std::stable_sort(results.begin(), results.end(), [](const triton::engines::solver::ParallelSolver::Result& a, const triton::engines::solver::ParallelSolver::Result& b) {
+            return a.index < b.index;
+          });
+
+          PyObject* ret = xPyList_New(results.size());
+          for (triton::usize index = 0; index < results.size(); index++) {
+            PyList_SetItem(ret, index, toDict(results[index]));
+          }
+          return ret;
+        }
+        catch (const triton::exceptions::PyCallbacks&) {
+          return nullptr;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
       static PyObject* TritonContext_getAllRegisters(PyObject* self, PyObject* noarg) {
         PyObject* ret = nullptr;
 
@@ -1349,6 +1611,55 @@ namespace triton {
       }
 
 
+      static PyObject* TritonContext_getLoggedPathConstraints(PyObject* self, PyObject* args) {
+        PyObject* start = nullptr;
+        PyObject* end   = nullptr;
+        PyObject* ret   = nullptr;
+
+        /* Extract arguments */
+        if (PyArg_ParseTuple(args, "|OO", &start, &end) == false) {
+          return PyErr_Format(PyExc_TypeError, "TritonContext::getLoggedPathConstraints(): Invalid number of arguments");
+        }
+
+        if (start == nullptr || (!PyLong_Check(start) && !PyInt_Check(start)))
+          return PyErr_Format(PyExc_TypeError, "TritonContext::getLoggedPathConstraints(): Expects an integer as first argument.");
+
+        if (end == nullptr || (!PyLong_Check(end) && !PyInt_Check(end)))
+          return PyErr_Format(PyExc_TypeError, "TritonContext::getLoggedPathConstraints(): Expects an integer as second argument.");
+
+        try {
+          triton::uint32 index = 0;
+          auto pc = PyTritonContext_AsTritonContext(self)->getLoggedPathConstraints(PyLong_AsUsize(start), PyLong_AsUsize(end));
+
+          ret = xPyList_New(pc.size());
+          for (auto it = pc.begin(); it != pc.end(); it++) {
+            PyList_SetItem(ret, index++, PyPathConstraint(*it));
+          }
+        }
+        catch (const triton::exceptions::PyCallbacks&) {
+          return nullptr;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        return ret;
+      }
+
+
+      static PyObject* TritonContext_getMaxSimplificationIterations(PyObject* self, PyObject* noarg) {
+        try {
+          return PyLong_FromUsize(PyTritonContext_AsTritonContext(self)->getMaxSimplificationIterations());
+        }
+        catch (const triton::exceptions::PyCallbacks&) {
+          return nullptr;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
       static PyObject* TritonContext_getMemoryAst(PyObject* self, PyObject* mem) {
         if (!PyMemoryAccess_Check(mem))
           return PyErr_Format(PyExc_TypeError, "TritonContext::getMemoryAst(): Expects an MemoryAccess as argument.");
@@ -1429,6 +1740,92 @@ namespace triton {
       }
 
 
+      static PyObject* TritonContext_getModelOnPath(PyObject* self, PyObject* args, PyObject* kwargs) {
+        triton::engines::solver::status_e status;
+        triton::engines::solver::policy_e strategy;
+        triton::uint32 solvingTime = 0;
+        triton::uint32 timeout_c = 0;
+
+        PyObject* dict    = nullptr;
+        PyObject* node    = nullptr;
+        PyObject* prefix  = nullptr;
+        PyObject* wb      = nullptr;
+        PyObject* timeout = nullptr;
+        PyObject* ws      = nullptr;
+
+        static char* keywords[] = {
+          (char*)"node",
+          (char*)"prefix",
+          (char*)"status",
+          (char*)"timeout",
+          (char*)"strategy",
+          nullptr
+        };
+
+        /* Extract Keywords */
+        if (PyArg_ParseTupleAndKeywords(args, kwargs, "|OOOOO", keywords, &node, &prefix, &wb, &timeout, &ws) == false) {
+          return PyErr_Format(PyExc_TypeError, "TritonContext::getModelOnPath(): Invalid keyword argument.");
+        }
+
+        if (node == nullptr || !PyAstNode_Check(node)) {
+          return PyErr_Format(PyExc_TypeError, "TritonContext::getModelOnPath(): Expects a AstNode as first argument.");
+        }
+
+        if (prefix == nullptr || (!PyLong_Check(prefix) && !PyInt_Check(prefix))) {
+          return PyErr_Format(PyExc_TypeError, "TritonContext::getModelOnPath(): Expects an integer as second argument.");
+        }
+
+        if (wb != nullptr && !PyBool_Check(wb)) {
+          return PyErr_Format(PyExc_TypeError, "TritonContext::getModelOnPath(): Expects a boolean as status keyword.");
+        }
+
+        if (timeout != nullptr && (!PyLong_Check(timeout) && !PyInt_Check(timeout))) {
+          return PyErr_Format(PyExc_TypeError, "TritonContext::getModelOnPath(): Expects a integer as timeout keyword.");
+        }
+
+        if (ws != nullptr && !PyBool_Check(ws)) {
+          return PyErr_Format(PyExc_TypeError, "TritonContext::getModelOnPath(): Expects a boolean as strategy keyword.");
+        }
+
+        if (timeout != nullptr) {
+          timeout_c = PyLong_AsUint32(timeout);
+        }
+
+        try {
+          dict = triton::bindings::python::xPyDict_New();
+          auto model = PyTritonContext_AsTritonContext(self)->getModelOnPath(PyAstNode_AsAstNode(node), PyLong_AsUsize(prefix), &status, timeout_c, &solvingTime, &strategy);
+          for (auto it = model.begin(); it != model.end(); it++) {
+            xPyDict_SetItem(dict, PyLong_FromUsize(it->first), PySolverModel(it->second));
+          }
+        }
+        catch (const triton::exceptions::PyCallbacks&) {
+          return nullptr;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        if (ws != nullptr && PyLong_AsBool(ws) == true) {
+          PyObject* tuple = triton::bindings::python::xPyTuple_New(4);
+          PyTuple_SetItem(tuple, 0, dict);
+          PyTuple_SetItem(tuple, 1, PyLong_FromUint32(status));
+          PyTuple_SetItem(tuple, 2, PyLong_FromUint32(solvingTime));
+          PyTuple_SetItem(tuple, 3, PyLong_FromUint32(strategy));
+          return tuple;
+        }
+
+        if (wb != nullptr && PyLong_AsBool(wb) == true) {
+          PyObject* tuple = triton::bindings::python::xPyTuple_New(3);
+          PyTuple_SetItem(tuple, 0, dict);
+          PyTuple_SetItem(tuple, 1, PyLong_FromUint32(status));
+          PyTuple_SetItem(tuple, 2, PyLong_FromUint32(solvingTime));
+          return tuple;
+        }
+
+        return dict;
+      }
+
+
       static PyObject* TritonContext_getModels(PyObject* self, PyObject* args, PyObject* kwargs) {
         triton::engines::solver::status_e status;
         triton::uint32 solvingTime = 0;
@@ -1439,17 +1836,20 @@ namespace triton {
         PyObject* limit   = nullptr;
         PyObject* wb      = nullptr;
         PyObject* timeout = nullptr;
+        PyObject* vars    = nullptr;
+        std::vector<triton::engines::symbolic::SharedSymbolicVariable> variables;
 
         static char* keywords[] = {
           (char*)"node",
           (char*)"limit",
           (char*)"status",
           (char*)"timeout",
+          (char*)"variables",
           nullptr
         };
 
         /* Extract Keywords */
-        if (PyArg_ParseTupleAndKeywords(args, kwargs, "|OOOO", keywords, &node, &limit, &wb, &timeout) == false) {
+        if (PyArg_ParseTupleAndKeywords(args, kwargs, "|OOOOO", keywords, &node, &limit, &wb, &timeout, &vars) == false) {
           return PyErr_Format(PyExc_TypeError, "TritonContext::getModel(): Invalid keyword argument.");
         }
 
@@ -1473,8 +1873,19 @@ namespace triton {
           timeout_c = PyLong_AsUint32(timeout);
         }
 
+        if (vars != nullptr) {
+          if (!PyList_Check(vars))
+            return PyErr_Format(PyExc_TypeError, "TritonContext::getModels(): Expects a list of SymbolicVariable as variables keyword.");
+          for (Py_ssize_t i = 0; i < PyList_Size(vars); i++) {
+            PyObject* item = PyList_GetItem(vars, i);
+            if (!PySymbolicVariable_Check(item))
+              return PyErr_Format(PyExc_TypeError, "TritonContext::getModels(): Expects a list of SymbolicVariable as variables keyword.");
+            variables.push_back(PySymbolicVariable_AsSymbolicVariable(item));
+          }
+        }
+
         try {
-          auto models = PyTritonContext_AsTritonContext(self)->getModels(PyAstNode_AsAstNode(node), PyLong_AsUint32(limit), &status, timeout_c, &solvingTime);
+          auto models = PyTritonContext_AsTritonContext(self)->getModels(PyAstNode_AsAstNode(node), PyLong_AsUint32(limit), variables, &status, timeout_c, &solvingTime);
           triton::uint32 index = 0;
 
           ret = xPyList_New(models.size());
@@ -1581,6 +1992,36 @@ namespace triton {
       }
 
 
+      static PyObject* TritonContext_getPathPredicateSlice(PyObject* self, PyObject* args) {
+        PyObject* node   = nullptr;
+        PyObject* prefix = nullptr;
+
+        /* Extract arguments */
+        if (PyArg_ParseTuple(args, "|OO", &node, &prefix) == false) {
+          return PyErr_Format(PyExc_TypeError, "TritonContext::getPathPredicateSlice(): Invalid number of arguments");
+        }
+
+        if (node == nullptr || !PyAstNode_Check(node))
+          return PyErr_Format(PyExc_TypeError, "TritonContext::getPathPredicateSlice(): Expects a AstNode as first argument.");
+
+        if (prefix != nullptr && prefix != Py_None && (!PyLong_Check(prefix) && !PyInt_Check(prefix)))
+          return PyErr_Format(PyExc_TypeError, "TritonContext::getPathPredicateSlice(): Expects an integer as second argument.");
+
+        try {
+          triton::usize size = PyTritonContext_AsTritonContext(self)->getSizeOfPathConstraints();
+          if (prefix != nullptr && prefix != Py_None)
+            size = PyLong_AsUsize(prefix);
+          return PyAstNode(PyTritonContext_AsTritonContext(self)->getPathPredicateSlice(PyAstNode_AsAstNode(node), size));
+        }
+        catch (const triton::exceptions::PyCallbacks&) {
+          return nullptr;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
       static PyObject* TritonContext_getPredicatesToReachAddress(PyObject* self, PyObject* addr) {
         PyObject* ret = nullptr;
 
@@ -1650,6 +2091,72 @@ namespace triton {
       }
 
 
+      static PyObject* TritonContext_getSimplificationRules(PyObject* self, PyObject* noarg) {
+        try {
+          auto rules = PyTritonContext_AsTritonContext(self)->getSimplificationRules();
+          PyObject* ret = xPyList_New(rules.size());
+
+          for (triton::usize index = 0; index < rules.size(); index++)
+            PyList_SetItem(ret, index, xPyString_FromString(rules[index].c_str()));
+
+          return ret;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* TritonContext_getSizeOfLoggedPathConstraints(PyObject* self, PyObject* noarg) {
+        try {
+          return PyLong_FromUsize(PyTritonContext_AsTritonContext(self)->getSizeOfLoggedPathConstraints());
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* TritonContext_getSolverCacheHits(PyObject* self, PyObject* noarg) {
+        try {
+          return PyLong_FromUsize(PyTritonContext_AsTritonContext(self)->getSolverCacheHits());
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* TritonContext_getSolverCacheMisses(PyObject* self, PyObject* noarg) {
+        try {
+          return PyLong_FromUsize(PyTritonContext_AsTritonContext(self)->getSolverCacheMisses());
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* TritonContext_getSolverFastPathHits(PyObject* self, PyObject* noarg) {
+        try {
+          return PyLong_FromUsize(PyTritonContext_AsTritonContext(self)->getSolverFastPathHits());
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* TritonContext_getSolverPolicy(PyObject* self, PyObject* noarg) {
+        try {
+          return PyLong_FromUint32(PyTritonContext_AsTritonContext(self)->getSolverPolicy());
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
       static PyObject* TritonContext_getSymbolicExpression(PyObject* self, PyObject* symExprId) {
         if (!PyLong_Check(symExprId) && !PyInt_Check(symExprId))
           return PyErr_Format(PyExc_TypeError, "TritonContext::getSymbolicExpression(): Expects an integer as argument.");
@@ -2123,6 +2630,50 @@ namespace triton {
       }
 
 
+      static PyObject* TritonContext_isSatOnPath(PyObject* self, PyObject* args) {
+        PyObject* node   = nullptr;
+        PyObject* prefix = nullptr;
+
+        /* Extract arguments */
+        if (PyArg_ParseTuple(args, "|OO", &node, &prefix) == false) {
+          return PyErr_Format(PyExc_TypeError, "TritonContext::isSatOnPath(): Invalid number of arguments");
+        }
+
+        if (node == nullptr || !PyAstNode_Check(node))
+          return PyErr_Format(PyExc_TypeError, "TritonContext::isSatOnPath(): Expects a AstNode as first argument.");
+
+        if (prefix == nullptr || (!PyLong_Check(prefix) && !PyInt_Check(prefix)))
+          return PyErr_Format(PyExc_TypeError, "TritonContext::isSatOnPath(): Expects an integer as second argument.");
+
+        try {
+          if (PyTritonContext_AsTritonContext(self)->isSatOnPath(PyAstNode_AsAstNode(node), PyLong_AsUsize(prefix)) == true)
+            Py_RETURN_TRUE;
+          Py_RETURN_FALSE;
+        }
+        catch (const triton::exceptions::PyCallbacks&) {
+          return nullptr;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* TritonContext_isSolverFastPathEnabled(PyObject* self, PyObject* noarg) {
+        try {
+          if (PyTritonContext_AsTritonContext(self)->isSolverFastPathEnabled() == true)
+            Py_RETURN_TRUE;
+          Py_RETURN_FALSE;
+        }
+        catch (const triton::exceptions::PyCallbacks&) {
+          return nullptr;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
       static PyObject* TritonContext_isSymbolicEngineEnabled(PyObject* self, PyObject* noarg) {
         try {
           if (PyTritonContext_AsTritonContext(self)->isSymbolicEngineEnabled() == true)
@@ -2202,6 +2753,44 @@ namespace triton {
         }
       }
 
+
+      static PyObject* TritonContext_mapConcreteMemoryFile(PyObject* self, PyObject* args) {
+        PyObject* baseAddr = nullptr;
+        PyObject* path     = nullptr;
+        PyObject* offset   = nullptr;
+        PyObject* size     = nullptr;
+
+        /* Extract arguments */
+        if (PyArg_ParseTuple(args, "|OOOO", &baseAddr, &path, &offset, &size) == false) {
+          return PyErr_Format(PyExc_TypeError, "TritonContext::mapConcreteMemoryFile(): Invalid number of arguments");
+        }
+
+        if (baseAddr == nullptr || (!PyLong_Check(baseAddr) && !PyInt_Check(baseAddr)))
+          return PyErr_Format(PyExc_TypeError, "TritonContext::mapConcreteMemoryFile(): Expects an integer as first argument.");
+
+        if (path == nullptr || !PyStr_Check(path))
+          return PyErr_Format(PyExc_TypeError, "TritonContext::mapConcreteMemoryFile(): Expects a string as second argument.");
+
+        if (offset == nullptr || (!PyLong_Check(offset) && !PyInt_Check(offset)))
+          return PyErr_Format(PyExc_TypeError, "TritonContext::mapConcreteMemoryFile(): Expects an integer as third argument.");
+
+        if (size == nullptr || (!PyLong_Check(size) && !PyInt_Check(size)))
+          return PyErr_Format(PyExc_TypeError, "TritonContext::mapConcreteMemoryFile(): Expects an integer as fourth argument.");
+
+        try {
+          PyTritonContext_AsTritonContext(self)->mapConcreteMemoryFile(PyLong_AsUint64(baseAddr), PyStr_AsString(path), PyLong_AsUint64(offset), PyLong_AsUsize(size));
+        }
+        catch (const triton::exceptions::PyCallbacks&) {
+          return nullptr;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        Py_INCREF(Py_None);
+        return Py_None;
+      }
+
       static PyObject* TritonContext_newSymbolicExpression(PyObject* self, PyObject* args) {
         PyObject* node          = nullptr;
         PyObject* comment       = nullptr;
@@ -2431,6 +3020,22 @@ namespace triton {
       }
 
 
+      static PyObject* TritonContext_resetSolverSession(PyObject* self, PyObject* noarg) {
+        try {
+          PyTritonContext_AsTritonContext(self)->resetSolverSession();
+        }
+        catch (const triton::exceptions::PyCallbacks&) {
+          return nullptr;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        Py_INCREF(Py_None);
+        return Py_None;
+      }
+
+
       static PyObject* TritonContext_setArchitecture(PyObject* self, PyObject* arg) {
         if (!PyLong_Check(arg) && !PyInt_Check(arg))
           return PyErr_Format(PyExc_TypeError, "TritonContext::setArchitecture(): Expects an ARCH as argument.");
@@ -2668,6 +3273,38 @@ namespace triton {
       }
 
 
+      static PyObject* TritonContext_setMaxPathConstraintsPerSite(PyObject* self, PyObject* limit) {
+        if (limit == nullptr || (!PyLong_Check(limit) && !PyInt_Check(limit)))
+          return PyErr_Format(PyExc_TypeError, "TritonContext::setMaxPathConstraintsPerSite(): Expects an integer as argument.");
+
+        try {
+          PyTritonContext_AsTritonContext(self)->setMaxPathConstraintsPerSite(PyLong_AsUsize(limit));
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        Py_INCREF(Py_None);
+        return Py_None;
+      }
+
+
+      static PyObject* TritonContext_setMaxSimplificationIterations(PyObject* self, PyObject* iterations) {
+        if (iterations == nullptr || (!PyLong_Check(iterations) && !PyInt_Check(iterations)))
+          return PyErr_Format(PyExc_TypeError, "TritonContext::setMaxSimplificationIterations(): Expects an integer as argument.");
+
+        try {
+          PyTritonContext_AsTritonContext(self)->setMaxSimplificationIterations(PyLong_AsUsize(iterations));
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        Py_INCREF(Py_None);
+        return Py_None;
+      }
+
+
       static PyObject* TritonContext_setMode(PyObject* self, PyObject* args) {
         PyObject* mode = nullptr;
         PyObject* flag = nullptr;
@@ -2698,6 +3335,36 @@ namespace triton {
       }
 
 
+      static PyObject* TritonContext_setPathConstraintLog(PyObject* self, PyObject* args) {
+        PyObject* path   = nullptr;
+        PyObject* window = nullptr;
+
+        /* Extract arguments */
+        if (PyArg_ParseTuple(args, "|OO", &path, &window) == false) {
+          return PyErr_Format(PyExc_TypeError, "TritonContext::setPathConstraintLog(): Invalid number of arguments");
+        }
+
+        if (path == nullptr || !PyStr_Check(path))
+          return PyErr_Format(PyExc_TypeError, "TritonContext::setPathConstraintLog(): Expects a string as first argument.");
+
+        if (window == nullptr || (!PyLong_Check(window) && !PyInt_Check(window)))
+          return PyErr_Format(PyExc_TypeError, "TritonContext::setPathConstraintLog(): Expects an integer as second argument.");
+
+        try {
+          PyTritonContext_AsTritonContext(self)->setPathConstraintLog(PyStr_AsString(path), PyLong_AsUsize(window));
+        }
+        catch (const triton::exceptions::PyCallbacks&) {
+          return nullptr;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        Py_INCREF(Py_None);
+        return Py_None;
+      }
+
+
       static PyObject* TritonContext_setSolver(PyObject* self, PyObject* solver) {
         if (solver == nullptr || (!PyLong_Check(solver) && !PyInt_Check(solver)))
           return PyErr_Format(PyExc_TypeError, "TritonContext::setSolver(): Expects a SOLVER as argument.");
@@ -2714,6 +3381,72 @@ namespace triton {
       }
 
 
+      static PyObject* TritonContext_setSolverCacheCapacity(PyObject* self, PyObject* entries) {
+        if (entries == nullptr || (!PyLong_Check(entries) && !PyInt_Check(entries)))
+          return PyErr_Format(PyExc_TypeError, "TritonContext::setSolverCacheCapacity(): Expects an integer as argument.");
+
+        try {
+          PyTritonContext_AsTritonContext(self)->setSolverCacheCapacity(PyLong_AsUsize(entries));
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        Py_INCREF(Py_None);
+        return Py_None;
+      }
+
+
+      static PyObject* TritonContext_setSolverCommands(PyObject* self, PyObject* commands) {
+        std::vector<std::vector<std::string>> cmds;
+
+        if (commands == nullptr || !PyList_Check(commands))
+          return PyErr_Format(PyExc_TypeError, "TritonContext::setSolverCommands(): Expects a list of lists of strings as argument.");
+
+        for (Py_ssize_t i = 0; i < PyList_Size(commands); i++) {
+          PyObject* command = PyList_GetItem(commands, i);
+          if (!PyList_Check(command))
+            return PyErr_Format(PyExc_TypeError, "TritonContext::setSolverCommands(): Expects a list of lists of strings as argument.");
+          cmds.push_back(std::vector<std::string>());
+          for (Py_ssize_t j = 0; j < PyList_Size(command); j++) {
+            PyObject* arg = PyList_GetItem(command, j);
+            if (!PyStr_Check(arg))
+              return PyErr_Format(PyExc_TypeError, "TritonContext::setSolverCommands(): Expects a list of lists of strings as argument.");
+            cmds.back().push_back(PyStr_AsString(arg));
+          }
+        }
+
+        try {
+          PyTritonContext_AsTritonContext(self)->setSolverCommands(cmds);
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        Py_INCREF(Py_None);
+        return Py_None;
+      }
+
+
+      static PyObject* TritonContext_setSolverFastPath(PyObject* self, PyObject* flag) {
+        if (!PyBool_Check(flag))
+          return PyErr_Format(PyExc_TypeError, "TritonContext::setSolverFastPath(): Expects an boolean as argument.");
+
+        try {
+          PyTritonContext_AsTritonContext(self)->setSolverFastPath(PyLong_AsBool(flag));
+        }
+        catch (const triton::exceptions::PyCallbacks&) {
+          return nullptr;
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        Py_INCREF(Py_None);
+        return Py_None;
+      }
+
+
       static PyObject* TritonContext_setSolverMemoryLimit(PyObject* self, PyObject* megabytes) {
         if (megabytes == nullptr || (!PyLong_Check(megabytes) && !PyInt_Check(megabytes)))
           return PyErr_Format(PyExc_TypeError, "TritonContext::setSolverMemoryLimit(): Expects an integer as argument.");
@@ -2730,6 +3463,22 @@ namespace triton {
       }
 
 
+      static PyObject* TritonContext_setSolverPolicy(PyObject* self, PyObject* policy) {
+        if (policy == nullptr || (!PyLong_Check(policy) && !PyInt_Check(policy)))
+          return PyErr_Format(PyExc_TypeError, "TritonContext::setSolverPolicy(): Expects a SOLVER_POLICY as argument.");
+
+        try {
+          PyTritonContext_AsTritonContext(self)->setSolverPolicy(static_cast<triton::engines::solver::policy_e>(PyLong_AsUint32(policy)));
+        }
+        catch (const triton::exceptions::Exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        Py_INCREF(Py_None);
+        return Py_None;
+      }
+
+
       static PyObject* TritonContext_setSolverTimeout(PyObject* self, PyObject* ms) {
         if (ms == nullptr || (!PyLong_Check(ms) && !PyInt_Check(ms)))
           return PyErr_Format(PyExc_TypeError, "TritonContext::setSolverTimeout(): Expects an integer as argument.");
@@ -3196,6 +3945,7 @@ namespace triton {
       //! TritonContext methods.
       PyMethodDef TritonContext_callbacks[] = {
         {"addCallback",                         (PyCFunction)TritonContext_addCallback,                               METH_VARARGS,                  ""},
+        {"addSimplificationRule",               (PyCFunction)TritonContext_addSimplificationRule,                     METH_O,                        ""},
         {"assignSymbolicExpressionToMemory",    (PyCFunction)TritonContext_assignSymbolicExpressionToMemory,          METH_VARARGS,                  ""},
         {"assignSymbolicExpressionToRegister",  (PyCFunction)TritonContext_assignSymbolicExpressionToRegister,        METH_VARARGS,                  ""},
         {"buildSemantics",                      (PyCFunction)TritonContext_buildSemantics,                            METH_O,                        ""},
@@ -3203,6 +3953,8 @@ namespace triton {
         {"clearModes",                          (PyCFunction)TritonContext_clearModes,                                METH_NOARGS,                   ""},
         {"clearConcreteMemoryValue",            (PyCFunction)TritonContext_clearConcreteMemoryValue,                  METH_VARARGS,                  ""},
         {"clearPathConstraints",                (PyCFunction)TritonContext_clearPathConstraints,                      METH_NOARGS,                   ""},
+        {"clearSimplificationRules",            (PyCFunction)TritonContext_clearSimplificationRules,                  METH_NOARGS,                   ""},
+        {"clearSolverCache",                    (PyCFunction)TritonContext_clearSolverCache,                          METH_NOARGS,                   ""},
         {"concretizeAllMemory",                 (PyCFunction)TritonContext_concretizeAllMemory,                       METH_NOARGS,                   ""},
         {"concretizeAllRegister",               (PyCFunction)TritonContext_concretizeAllRegister,                     METH_NOARGS,                   ""},
         {"concretizeMemory",                    (PyCFunction)TritonContext_concretizeMemory,                          METH_O,                        ""},
@@ -3214,6 +3966,7 @@ namespace triton {
         {"enableSymbolicEngine",                (PyCFunction)TritonContext_enableSymbolicEngine,                      METH_O,                        ""},
         {"enableTaintEngine",                   (PyCFunction)TritonContext_enableTaintEngine,                         METH_O,                        ""},
         {"evaluateAstViaZ3",                    (PyCFunction)TritonContext_evaluateAstViaZ3,                          METH_O,                        ""},
+        {"flipPathConstraints",                 (PyCFunction)(void*)(PyCFunctionWithKeywords)TritonContext_flipPathConstraints, METH_VARARGS | METH_KEYWORDS, ""},
         {"getAllRegisters",                     (PyCFunction)TritonContext_getAllRegisters,                           METH_NOARGS,                   ""},
         {"getArchitecture",                     (PyCFunction)TritonContext_getArchitecture,                           METH_NOARGS,                   ""},
         {"getAstContext",                       (PyCFunction)TritonContext_getAstContext,                             METH_NOARGS,                   ""},
@@ -3225,17 +3978,27 @@ namespace triton {
         {"getGprBitSize",                       (PyCFunction)TritonContext_getGprBitSize,                             METH_NOARGS,                   ""},
         {"getGprSize",                          (PyCFunction)TritonContext_getGprSize,                                METH_NOARGS,                   ""},
         {"getImmediateAst",                     (PyCFunction)TritonContext_getImmediateAst,                           METH_O,                        ""},
+        {"getLoggedPathConstraints",            (PyCFunction)TritonContext_getLoggedPathConstraints,                  METH_VARARGS,                  ""},
+        {"getMaxSimplificationIterations",      (PyCFunction)TritonContext_getMaxSimplificationIterations,            METH_NOARGS,                   ""},
         {"getMemoryAst",                        (PyCFunction)TritonContext_getMemoryAst,                              METH_O,                        ""},
         {"getModel",                            (PyCFunction)(void*)(PyCFunctionWithKeywords)TritonContext_getModel,  METH_VARARGS | METH_KEYWORDS,  ""},
+        {"getModelOnPath",                      (PyCFunction)(void*)(PyCFunctionWithKeywords)TritonContext_getModelOnPath, METH_VARARGS | METH_KEYWORDS, ""},
         {"getModels",                           (PyCFunction)(void*)(PyCFunctionWithKeywords)TritonContext_getModels, METH_VARARGS | METH_KEYWORDS,  ""},
         {"getParentRegister",                   (PyCFunction)TritonContext_getParentRegister,                         METH_O,                        ""},
         {"getParentRegisters",                  (PyCFunction)TritonContext_getParentRegisters,                        METH_NOARGS,                   ""},
         {"getPathConstraints",                  (PyCFunction)TritonContext_getPathConstraints,                        METH_NOARGS,                   ""},
         {"getPathPredicate",                    (PyCFunction)TritonContext_getPathPredicate,                          METH_NOARGS,                   ""},
         {"getPathPredicateSize",                (PyCFunction)TritonContext_getPathPredicateSize,                      METH_NOARGS,                   ""},
+        {"getPathPredicateSlice",               (PyCFunction)TritonContext_getPathPredicateSlice,                     METH_VARARGS,                  ""},
         {"getPredicatesToReachAddress",         (PyCFunction)TritonContext_getPredicatesToReachAddress,               METH_O,                        ""},
         {"getRegister",                         (PyCFunction)TritonContext_getRegister,                               METH_O,                        ""},
         {"getRegisterAst",                      (PyCFunction)TritonContext_getRegisterAst,                            METH_O,                        ""},
+        {"getSimplificationRules",              (PyCFunction)TritonContext_getSimplificationRules,                    METH_NOARGS,                   ""},
+        {"getSizeOfLoggedPathConstraints",      (PyCFunction)TritonContext_getSizeOfLoggedPathConstraints,            METH_NOARGS,                   ""},
+        {"getSolverCacheHits",                  (PyCFunction)TritonContext_getSolverCacheHits,                        METH_NOARGS,                   ""},
+        {"getSolverCacheMisses",                (PyCFunction)TritonContext_getSolverCacheMisses,                      METH_NOARGS,                   ""},
+        {"getSolverFastPathHits",               (PyCFunction)TritonContext_getSolverFastPathHits,                     METH_NOARGS,                   ""},
+        {"getSolverPolicy",                     (PyCFunction)TritonContext_getSolverPolicy,                           METH_NOARGS,                   ""},
         {"getSymbolicExpression",               (PyCFunction)TritonContext_getSymbolicExpression,                     METH_O,                        ""},
         {"getSymbolicExpressions",              (PyCFunction)TritonContext_getSymbolicExpressions,                    METH_NOARGS,                   ""},
         {"getSymbolicMemory",                   (PyCFunction)TritonContext_getSymbolicMemory,                         METH_VARARGS,                  ""},
@@ -3259,10 +4022,13 @@ namespace triton {
         {"isRegisterTainted",                   (PyCFunction)TritonContext_isRegisterTainted,                         METH_O,                        ""},
         {"isRegisterValid",                     (PyCFunction)TritonContext_isRegisterValid,                           METH_O,                        ""},
         {"isSat",                               (PyCFunction)TritonContext_isSat,                                     METH_O,                        ""},
+        {"isSatOnPath",                         (PyCFunction)TritonContext_isSatOnPath,                               METH_VARARGS,                  ""},
+        {"isSolverFastPathEnabled",             (PyCFunction)TritonContext_isSolverFastPathEnabled,                   METH_NOARGS,                   ""},
         {"isSymbolicEngineEnabled",             (PyCFunction)TritonContext_isSymbolicEngineEnabled,                   METH_NOARGS,                   ""},
         {"isSymbolicExpressionExists",          (PyCFunction)TritonContext_isSymbolicExpressionExists,                METH_O,                        ""},
         {"isTaintEngineEnabled",                (PyCFunction)TritonContext_isTaintEngineEnabled,                      METH_NOARGS,                   ""},
         {"isThumb",                             (PyCFunction)TritonContext_isThumb,                                   METH_NOARGS,                   ""},
+        {"mapConcreteMemoryFile",               (PyCFunction)TritonContext_mapConcreteMemoryFile,                     METH_VARARGS,                  ""},
         {"newSymbolicExpression",               (PyCFunction)TritonContext_newSymbolicExpression,                     METH_VARARGS,                  ""},
         {"newSymbolicVariable",                 (PyCFunction)TritonContext_newSymbolicVariable,                       METH_VARARGS,                  ""},
         {"popPathConstraint",                   (PyCFunction)TritonContext_popPathConstraint,                         METH_NOARGS,                   ""},
@@ -3271,15 +4037,23 @@ namespace triton {
         {"pushPathConstraint",                  (PyCFunction)TritonContext_pushPathConstraint,                        METH_O,                        ""},
         {"removeCallback",                      (PyCFunction)TritonContext_removeCallback,                            METH_VARARGS,                  ""},
         {"reset",                               (PyCFunction)TritonContext_reset,                                     METH_NOARGS,                   ""},
+        {"resetSolverSession",                  (PyCFunction)TritonContext_resetSolverSession,                        METH_NOARGS,                   ""},
         {"setArchitecture",                     (PyCFunction)TritonContext_setArchitecture,                           METH_O,                        ""},
         {"setAstRepresentationMode",            (PyCFunction)TritonContext_setAstRepresentationMode,                  METH_O,                        ""},
         {"setConcreteMemoryAreaValue",          (PyCFunction)TritonContext_setConcreteMemoryAreaValue,                METH_VARARGS,                  ""},
         {"setConcreteMemoryValue",              (PyCFunction)TritonContext_setConcreteMemoryValue,                    METH_VARARGS,                  ""},
         {"setConcreteRegisterValue",            (PyCFunction)TritonContext_setConcreteRegisterValue,                  METH_VARARGS,                  ""},
         {"setConcreteVariableValue",            (PyCFunction)TritonContext_setConcreteVariableValue,                  METH_VARARGS,                  ""},
+        {"setMaxPathConstraintsPerSite",        (PyCFunction)TritonContext_setMaxPathConstraintsPerSite,              METH_O,                        ""},
+        {"setMaxSimplificationIterations",      (PyCFunction)TritonContext_setMaxSimplificationIterations,            METH_O,                        ""},
         {"setMode",                             (PyCFunction)TritonContext_setMode,                                   METH_VARARGS,                  ""},
+        {"setPathConstraintLog",                (PyCFunction)TritonContext_setPathConstraintLog,                      METH_VARARGS,                  ""},
         {"setSolver",                           (PyCFunction)TritonContext_setSolver,                                 METH_O,                        ""},
+        {"setSolverCacheCapacity",              (PyCFunction)TritonContext_setSolverCacheCapacity,                    METH_O,                        ""},
+        {"setSolverCommands",                   (PyCFunction)TritonContext_setSolverCommands,                         METH_O,                        ""},
+        {"setSolverFastPath",                   (PyCFunction)TritonContext_setSolverFastPath,                         METH_O,                        ""},
         {"setSolverMemoryLimit",                (PyCFunction)TritonContext_setSolverMemoryLimit,                      METH_O,                        ""},
+        {"setSolverPolicy",                     (PyCFunction)TritonContext_setSolverPolicy,                           METH_O,                        ""},
         {"setSolverTimeout",                    (PyCFunction)TritonContext_setSolverTimeout,                          METH_O,                        ""},
         {"setTaintMemory",                      (PyCFunction)TritonContext_setTaintMemory,                            METH_VARARGS,                  ""},
         {"setTaintRegister",                    (PyCFunction)TritonContext_setTaintRegister,                          METH_VARARGS,                  ""},
@@ -0,0 +1,465 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the Apache License 2.0.
+*/
+
+#include <algorithm>
+#include <bitset>
+#include <chrono>
+#include <new>
+#include <random>
+#include <set>
+
+#include <triton/exceptions.hpp>
+#include <triton/localSearchSolver.hpp>
+#include <triton/symbolicExpression.hpp>
+
+
+
+namespace triton {
+  namespace engines {
+    namespace solver {
+
+      /* The number of significant bits of a value */
+      static triton::uint64 bitLength(triton::uint64 value) {
+        triton::uint64 length = 0;
+        while (value) {
+          value >>= 1;
+          length++;
+        }
+        return length;
+      }
+
+
+      LocalSearchSolver::LocalSearchSolver() {
+        this->timeout        = 0;
+        this->maxEvaluations = 0x40000;
+      }
+
+
+      triton::usize LocalSearchSolver::addProgram(Query& query, const triton::ast::SharedAbstractNode& node) const {
+        std::unique_ptr<triton::ast::AstProgram> program(new(std::nothrow) triton::ast::AstProgram(node));
+        if (program == nullptr)
+          throw triton::exceptions::SolverEngine("LocalSearchSolver::addProgram(): Not enough memory.");
+
+        std::vector<triton::usize> inputs;
+        for (auto&& var : program->getVariables()) {
+          auto it = query.indexes.find(var->getId());
+          if (it == query.indexes.end()) {
+            it = query.indexes.emplace(var->getId(), query.variables.size()).first;
+            query.variables.push_back(var);
+            query.masks.push_back(triton::ast::mask64(var->getSize()));
+          }
+          inputs.push_back(it->second);
+        }
+
+        if (query.buffer.size() < inputs.size())
+          query.buffer.resize(inputs.size());
+
+        query.programs.push_back(std::move(program));
+        query.inputs.push_back(std::move(inputs));
+
+        return query.programs.size() - 1;
+      }
+
+
+      triton::usize LocalSearchSolver::addObjective(Query& query, const triton::ast::SharedAbstractNode& node, bool negate) const {
+        Objective objective;
+        bool strict = false;
+        bool swap   = false;
+
+        objective.sign = 0;
+
+        switch (node->getType()) {
+          case triton::ast::REFERENCE_NODE:
+            return this->addObjective(query, reinterpret_cast<triton::ast::ReferenceNode*>(node.get())->getSymbolicExpression()->getAst(), negate);
+
+          case triton::ast::LNOT_NODE:
+            return this->addObjective(query, node->getChildren()[0], !negate);
+
+          /* De Morgan, a negated conjunction is a disjunction of negations */
+          case triton::ast::LAND_NODE:
+          case triton::ast::LOR_NODE:
+            objective.kind = ((node->getType() == triton::ast::LAND_NODE) != negate) ? OBJ_AND : OBJ_OR;
+            for (auto&& child : node->getChildren())
+              objective.children.push_back(this->addObjective(query, child, negate));
+            query.objectives.push_back(std::move(objective));
+            return query.objectives.size() - 1;
+
+          case triton::ast::EQUAL_NODE:
+          case triton::ast::DISTINCT_NODE:
+            if (node->getChildren()[0]->isLogical())
+              break;
+            objective.kind = ((node->getType() == triton::ast::EQUAL_NODE) != negate) ? OBJ_EQ : OBJ_NE;
+            objective.programs.push_back(this->addProgram(query, node->getChildren()[0]));
+            objective.programs.push_back(this->addProgram(query, node->getChildren()[1]));
+            query.objectives.push_back(std::move(objective));
+            return query.objectives.size() - 1;
+
+          /* Every inequality is a (strict or not) lower-than, with swapped operands for the greater-than */
+          case triton::ast::BVSGE_NODE:
+          case triton::ast::BVSGT_NODE:
+          case triton::ast::BVSLE_NODE:
+          case triton::ast::BVSLT_NODE:
+          case triton::ast::BVUGE_NODE:
+          case triton::ast::BVUGT_NODE:
+          case triton::ast::BVULE_NODE:
+          case triton::ast::BVULT_NODE: {
+            auto type = node->getType();
+            strict = (type == triton::ast::BVSGT_NODE || type == triton::ast::BVSLT_NODE || type == triton::ast::BVUGT_NODE || type == triton::ast::BVULT_NODE);
+            swap   = (type == triton::ast::BVSGE_NODE || type == triton::ast::BVSGT_NODE || type == triton::ast::BVUGE_NODE || type == triton::ast::BVUGT_NODE);
+
+            /* !(x < y) is (y <= x) and !(x <= y) is (y < x) */
+            if (negate) {
+              strict = !strict;
+              swap   = !swap;
+            }
+
+            objective.kind = strict ? OBJ_ULT : OBJ_ULE;
+            objective.programs.push_back(this->addProgram(query, node->getChildren()[swap ? 1 : 0]));
+            objective.programs.push_back(this->addProgram(query, node->getChildren()[swap ? 0 : 1]));
+
+            /* Flipping the sign bits maps the signed order onto the unsigned one (operands are at most 64 bits once their programs are added) */
+            if (type == triton::ast::BVSGE_NODE || type == triton::ast::BVSGT_NODE || type == triton::ast::BVSLE_NODE || type == triton::ast::BVSLT_NODE)
+              objective.sign = 1ULL << (node->getChildren()[0]->getBitvectorSize() - 1);
+            query.objectives.push_back(std::move(objective));
+            return query.objectives.size() - 1;
+          }
+
+          default:
+            break;
+        }
+
+        /* Any other predicate only tells whether it holds */
+        objective.kind = negate ? OBJ_FALSE : OBJ_TRUE;
+        objective.programs.push_back(this->addProgram(query, node));
+        query.objectives.push_back(std::move(objective));
+
+        return query.objectives.size() - 1;
+      }
+
+
+      triton::uint64 LocalSearchSolver::evaluate(Query& query, triton::usize program, const std::vector<triton::uint64>& values) const {
+        const std::vector<triton::usize>& inputs = query.inputs[program];
+
+        for (triton::usize index = 0; index < inputs.size(); index++)
+          query.buffer[index] = values[inputs[index]];
+
+        return query.programs[program]->evaluate(query.buffer.data());
+      }
+
+
+      triton::uint64 LocalSearchSolver::getFitness(Query& query, triton::usize objective, const std::vector<triton::uint64>& values) const {
+        const Objective& obj = query.objectives[objective];
+        triton::uint64 fitness = 0;
+        triton::uint64 lhs = 0;
+        triton::uint64 rhs = 0;
+
+        switch (obj.kind) {
+          case OBJ_AND:
+            for (auto child : obj.children)
+              fitness += this->getFitness(query, child, values);
+            return fitness;
+
+          case OBJ_OR:
+            fitness = static_cast<triton::uint64>(-1);
+            for (auto child : obj.children) {
+              fitness = std::min(fitness, this->getFitness(query, child, values));
+              if (fitness == 0)
+                break;
+            }
+            return fitness;
+
+          case OBJ_TRUE:
+            return this->evaluate(query, obj.programs[0], values) ? 0 : 1;
+
+          case OBJ_FALSE:
+            return this->evaluate(query, obj.programs[0], values) ? 1 : 0;
+
+          default:
+            break;
+        }
+
+        lhs = this->evaluate(query, obj.programs[0], values) ^ obj.sign;
+        rhs = this->evaluate(query, obj.programs[1], values) ^ obj.sign;
+
+        switch (obj.kind) {
+          case OBJ_EQ:
+            return std::bitset<64>(lhs ^ rhs).count();
+
+          case OBJ_NE:
+            return (lhs == rhs) ? 1 : 0;
+
+          case OBJ_ULT:
+            return (lhs < rhs) ? 0 : 1 + bitLength(lhs - rhs);
+
+          case OBJ_ULE:
+            return (lhs <= rhs) ? 0 : bitLength(lhs - rhs);
+
+          default:
+            throw triton::exceptions::SolverEngine("LocalSearchSolver::getFitness(): Invalid objective.");
+        }
+      }
+
+
+      std::vector<std::unordered_map<triton::usize, SolverModel>> LocalSearchSolver::getModels(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, triton::engines::solver::status_e* status, triton::uint32 timeout, triton::uint32* solvingTime) const {
+        std::vector<std::unordered_map<triton::usize, SolverModel>> ret;
+        triton::engines::solver::status_e st = triton::engines::solver::UNKNOWN;
+        triton::ast::SharedAbstractNode onode = node;
+        auto start = std::chrono::system_clock::now();
+        Query query;
+        triton::usize root  = 0;
+        triton::usize check = 0;
+
+        if (onode == nullptr)
+          throw triton::exceptions::SolverEngine("LocalSearchSolver::getModels(): node cannot be null.");
+
+        if (node->getType() == triton::ast::ASSERT_NODE)
+          onode = node->getChildren()[0];
+
+        if (onode->isLogical() == false)
+          throw triton::exceptions::SolverEngine("LocalSearchSolver::getModels(): Must be a logical node.");
+
+        if (timeout == 0)
+          timeout = this->timeout;
+
+        auto elapsed = [&start](void) -> triton::uint32 {
+          return static_cast<triton::uint32>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - start).count());
+        };
+
+        auto done = [&](void) {
+          if (status)
+            *status = st;
+          if (solvingTime)
+            *solvingTime = elapsed();
+          return ret;
+        };
+
+        /* Queries which cannot be evaluated concretely are unknown */
+        try {
+          root  = this->addObjective(query, onode, false);
+          check = this->addProgram(query, onode);
+        }
+        catch (const triton::exceptions::Ast&) {
+          return done();
+        }
+
+        auto toModel = [&query](const std::vector<triton::uint64>& values) {
+          std::unordered_map<triton::usize, SolverModel> model;
+          for (triton::usize index = 0; index < query.variables.size(); index++)
+            model[query.variables[index]->getId()] = SolverModel(query.variables[index], values[index]);
+          return model;
+        };
+
+        /* A query without variable is a constant */
+        if (query.variables.empty()) {
+          if (this->evaluate(query, check, {})) {
+            st = triton::engines::solver::SAT;
+            if (limit)
+              ret.push_back(toModel({}));
+          }
+          else {
+            st = triton::engines::solver::UNSAT;
+          }
+          return done();
+        }
+
+        /* The search starts from the concrete values of the variables */
+        std::vector<triton::uint64> values(query.variables.size(), 0);
+        for (auto&& var : triton::ast::search(onode, triton::ast::VARIABLE_NODE)) {
+          auto it = query.indexes.find(reinterpret_cast<triton::ast::VariableNode*>(var.get())->getSymbolicVariable()->getId());
+          if (it != query.indexes.end())
+            values[it->second] = var->evaluate64() & query.masks[it->second];
+        }
+
+        /* The constants of the query, often compared with the variables */
+        for (auto&& bv : triton::ast::search(onode, triton::ast::BV_NODE)) {
+          if (query.dictionary.size() >= 64)
+            break;
+          if (bv->getBitvectorSize() <= 64)
+            query.dictionary.push_back(bv->evaluate64());
+        }
+        std::sort(query.dictionary.begin(), query.dictionary.end());
+        query.dictionary.erase(std::unique(query.dictionary.begin(), query.dictionary.end()), query.dictionary.end());
+
+        std::set<std::vector<triton::uint64>> found;
+        std::mt19937_64 random(0x5eed);
+        triton::usize evaluations = 0;
+        triton::usize offset = 0;
+        bool timedOut = false;
+
+        auto exhausted = [&](void) {
+          return timedOut || evaluations >= this->maxEvaluations;
+        };
+
+        /* Models already found are penalised, so the search moves to other ones */
+        auto fitness = [&](const std::vector<triton::uint64>& v) -> triton::uint64 {
+          if ((++evaluations & 0xff) == 0 && timeout && elapsed() >= timeout)
+            timedOut = true;
+          triton::uint64 f = this->getFitness(query, root, v);
+          if (f == 0 && (this->evaluate(query, check, v) == 0 || found.count(v)))
+            f = 1;
+          return f;
+        };
+
+        /* Tries a value of a variable, keeps it if it is better */
+        auto tryValue = [&](std::vector<triton::uint64>& v, triton::usize i, triton::uint64 value, triton::uint64& best) {
+          triton::uint64 old = v[i];
+          v[i] = value & query.masks[i];
+          triton::uint64 f = fitness(v);
+          if (f < best) {
+            best = f;
+            return true;
+          }
+          v[i] = old;
+          return false;
+        };
+
+        /* First improvement among the neighbours, returns false on a local optimum */
+        auto climb = [&](std::vector<triton::uint64>& v, triton::uint64& best) {
+          triton::usize n = v.size();
+          offset++;
+          for (triton::usize k = 0; k < n && !exhausted(); k++) {
+            triton::usize i = (offset + k) % n;
+            triton::uint64 mask = query.masks[i];
+            triton::uint64 old = v[i];
+
+            /* Steps along the gradient, doubled while they improve */
+            for (triton::uint64 dir : {static_cast<triton::uint64>(1), mask}) {
+              if (tryValue(v, i, old + dir, best)) {
+                for (triton::uint64 step = (dir << 1) & mask; step && !exhausted(); step = (step << 1) & mask) {
+                  if (!tryValue(v, i, v[i] + step, best))
+                    break;
+                }
+                return true;
+              }
+            }
+
+            for (triton::uint64 bit = 0; bit < bitLength(mask) && !exhausted(); bit++) {
+              if (tryValue(v, i, old ^ (1ULL << bit), best))
+                return true;
+            }
+
+            /* Constants as whole values, and their low byte at each byte position */
+            for (auto value : query.dictionary) {
+              if (exhausted())
+                break;
+              if (tryValue(v, i, value, best))
+                return true;
+              for (triton::uint64 shift = 0; shift < bitLength(mask) && !exhausted(); shift += 8) {
+                if (tryValue(v, i, (old & ~(0xffULL << shift)) | ((value & 0xff) << shift), best))
+                  return true;
+              }
+            }
+          }
+          return false;
+        };
+
+        /* Random mutations of a few variables */
+        auto havoc = [&](std::vector<triton::uint64>& v) {
+          triton::usize count = 1 + random() % std::min<triton::usize>(v.size(), 3);
+          for (triton::usize j = 0; j < count; j++) {
+            triton::usize i = random() % v.size();
+            switch (random() % 4) {
+              case 0:
+                v[i] = random();
+                break;
+              case 1:
+                if (!query.dictionary.empty()) {
+                  v[i] = query.dictionary[random() % query.dictionary.size()];
+                  break;
+                }
+                /* Falls through */
+              case 2:
+                v[i] ^= 1ULL << (random() % bitLength(query.masks[i]));
+                break;
+              default:
+                v[i] += (random() % 33) - 16;
+                break;
+            }
+            v[i] &= query.masks[i];
+          }
+        };
+
+        std::vector<triton::uint64> elite = values;
+        triton::uint64 eliteFitness = fitness(values);
+        triton::uint64 best = eliteFitness;
+
+        while (!exhausted()) {
+          if (best == 0) {
+            found.insert(values);
+            st = triton::engines::solver::SAT;
+            if (ret.size() < limit)
+              ret.push_back(toModel(values));
+            if (ret.size() >= limit)
+              break;
+            best = fitness(values);
+          }
+
+          if (best <= eliteFitness) {
+            elite = values;
+            eliteFitness = best;
+          }
+
+          /* Restarts from a mutation of the best assignment seen */
+          if (!climb(values, best)) {
+            values = elite;
+            havoc(values);
+            best = fitness(values);
+          }
+        }
+
+        if (st != triton::engines::solver::SAT && timedOut)
+          st = triton::engines::solver::TIMEOUT;
+
+        return done();
+      }
+
+
+      std::unordered_map<triton::usize, SolverModel> LocalSearchSolver::getModel(const triton::ast::SharedAbstractNode& node, triton::engines::solver::status_e* status, triton::uint32 timeout, triton::uint32* solvingTime) const {
+        std::unordered_map<triton::usize, SolverModel> ret;
+        std::vector<std::unordered_map<triton::usize, SolverModel>> allModels;
+
+        allModels = this->getModels(node, 1, status, timeout, solvingTime);
+        if (allModels.size() > 0)
+          ret = allModels.front();
+
+        return ret;
+      }
+
+
+      bool LocalSearchSolver::isSat(const triton::ast::SharedAbstractNode& node, triton::engines::solver::status_e* status, triton::uint32 timeout, triton::uint32* solvingTime) const {
+        triton::engines::solver::status_e st = triton::engines::solver::UNKNOWN;
+
+        this->getModels(node, 1, &st, timeout, solvingTime);
+        if (status)
+          *status = st;
+
+        return st == triton::engines::solver::SAT;
+      }
+
+
+      std::string LocalSearchSolver::getName(void) const {
+        return "LocalSearch";
+      }
+
+
+      void LocalSearchSolver::setTimeout(triton::uint32 ms) {
+        this->timeout = ms;
+      }
+
+
+      void LocalSearchSolver::setMemoryLimit(triton::uint32) {
+        /* The search runs in process and allocates little, there is no limit to apply */
+      }
+
+
+      void LocalSearchSolver::setMaxEvaluations(triton::usize count) {
+        this->maxEvaluations = count;
+      }
+
+    };
+  };
+};
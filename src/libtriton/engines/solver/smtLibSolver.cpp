@@ -0,0 +1,572 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the Apache License 2.0.
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <map>
+#include <new>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+  #include <fcntl.h>
+  #include <poll.h>
+  #include <signal.h>
+  #include <sys/resource.h>
+  #include <sys/socket.h>
+  #include <sys/wait.h>
+  #include <unistd.h>
+#endif
+
+#include <triton/astContext.hpp>
+#include <triton/astEnums.hpp>
+#include <triton/exceptions.hpp>
+#include <triton/smtLibSolver.hpp>
+#include <triton/symbolicExpression.hpp>
+
+
+
+namespace triton {
+  namespace engines {
+    namespace solver {
+
+      SmtLibSolver::SmtLibSolver() {
+        this->commands    = {{"z3", "-in"}};
+        this->poolSize    = 4;
+        this->timeout     = 0;
+        this->memoryLimit = 0;
+      }
+
+
+      SmtLibSolver::~SmtLibSolver() {
+        this->clear();
+      }
+
+
+      std::unique_ptr<SmtLibSolver::Process> SmtLibSolver::acquire(triton::usize command) const {
+        {
+          std::lock_guard<std::mutex> lock(this->mutex);
+          for (auto it = this->pool.begin(); it != this->pool.end(); it++) {
+            if ((*it)->command == command) {
+              std::unique_ptr<Process> process = std::move(*it);
+              this->pool.erase(it);
+              return process;
+            }
+          }
+        }
+        return this->spawn(command);
+      }
+
+
+      void SmtLibSolver::release(std::unique_ptr<Process> process) const {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        auto idle = std::count_if(this->pool.begin(), this->pool.end(), [&process](const std::unique_ptr<Process>& p) { return p->command == process->command; });
+        if (static_cast<triton::usize>(idle) < this->poolSize && process->command < this->commands.size())
+          this->pool.push_back(std::move(process));
+        else
+          this->kill(*process);
+      }
+
+
+      void SmtLibSolver::clear(void) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        for (auto&& process : this->pool)
+          this->kill(*process);
+        this->pool.clear();
+      }
+
+
+      std::unique_ptr<SmtLibSolver::Process> SmtLibSolver::spawn(triton::usize command) const {
+        #if defined(__unix__) || defined(__APPLE__)
+        std::unique_ptr<Process> process(new(std::nothrow) Process());
+        if (process == nullptr)
+          throw triton::exceptions::SolverEngine("SmtLibSolver::spawn(): Not enough memory.");
+
+        /* The argv is built before the fork, the child must not allocate */
+        std::vector<char*> argv;
+        for (auto&& arg : this->commands[command])
+          argv.push_back(const_cast<char*>(arg.c_str()));
+        argv.push_back(nullptr);
+
+        /* A socket pair rather than pipes, so writing to a dead solver does not raise SIGPIPE */
+        int fds[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+          throw triton::exceptions::SolverEngine("SmtLibSolver::spawn(): Cannot create a socket pair.");
+        fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+        fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+        #if defined(SO_NOSIGPIPE)
+        int on = 1;
+        setsockopt(fds[0], SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+        #endif
+
+        rlim_t limit = static_cast<rlim_t>(this->memoryLimit) * 1024 * 1024;
+        pid_t pid = fork();
+        if (pid < 0) {
+          close(fds[0]);
+          close(fds[1]);
+          throw triton::exceptions::SolverEngine("SmtLibSolver::spawn(): Cannot fork.");
+        }
+
+        if (pid == 0) {
+          int null = open("/dev/null", O_WRONLY);
+          dup2(fds[1], 0);
+          dup2(fds[1], 1);
+          if (null >= 0)
+            dup2(null, 2);
+          if (limit) {
+            struct rlimit rl = {limit, limit};
+            setrlimit(RLIMIT_AS, &rl);
+          }
+          execvp(argv[0], argv.data());
+          _exit(127);
+        }
+
+        close(fds[1]);
+        process->command = command;
+        process->pid     = pid;
+        process->fd      = fds[0];
+
+        if (!this->send(*process, "(set-option :print-success false)\n(set-option :produce-models true)\n")) {
+          this->kill(*process);
+          throw triton::exceptions::SolverEngine("SmtLibSolver::spawn(): Cannot start " + this->commands[command][0] + ".");
+        }
+
+        return process;
+        #else
+        throw triton::exceptions::SolverEngine("SmtLibSolver::spawn(): Only available on Unix-like systems.");
+        #endif
+      }
+
+
+      SmtLibSolver::Process::~Process() {
+        /* A query which throws must not leave its processes running */
+        SmtLibSolver::kill(*this);
+      }
+
+
+      void SmtLibSolver::kill(Process& process) {
+        #if defined(__unix__) || defined(__APPLE__)
+        if (process.fd >= 0)
+          close(process.fd);
+        if (process.pid > 0) {
+          ::kill(process.pid, SIGKILL);
+          waitpid(process.pid, nullptr, 0);
+        }
+        #endif
+        process.fd  = -1;
+        process.pid = -1;
+      }
+
+
+      bool SmtLibSolver::send(Process& process, const std::string& text) const {
+        #if defined(__unix__) || defined(__APPLE__)
+        #if defined(MSG_NOSIGNAL)
+        const int flags = MSG_NOSIGNAL;
+        #else
+        const int flags = 0;
+        #endif
+        const char* data = text.data();
+        triton::usize size = text.size();
+
+        while (size) {
+          ssize_t count = ::send(process.fd, data, size, flags);
+          if (count < 0 && errno == EINTR)
+            continue;
+          if (count <= 0)
+            return false;
+          data += count;
+          size -= count;
+        }
+
+        return true;
+        #else
+        return false;
+        #endif
+      }
+
+
+      triton::sint32 SmtLibSolver::receive(const std::vector<Process*>& processes, Deadline deadline, bool hasDeadline, std::string& answer) const {
+        #if defined(__unix__) || defined(__APPLE__)
+        while (true) {
+          /* Answers already received, empty lines are skipped */
+          for (triton::usize index = 0; index < processes.size(); index++) {
+            std::string& buffer = processes[index]->buffer;
+            for (auto pos = buffer.find('\n'); pos != std::string::npos; pos = buffer.find('\n')) {
+              std::string line = buffer.substr(0, pos);
+              buffer.erase(0, pos + 1);
+              line.erase(line.find_last_not_of(" \r\t") + 1);
+              if (!line.empty()) {
+                answer = line;
+                return static_cast<triton::sint32>(index);
+              }
+            }
+          }
+
+          int wait = -1;
+          if (hasDeadline) {
+            auto now = std::chrono::steady_clock::now();
+            if (now >= deadline)
+              return -1;
+            wait = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count()) + 1;
+          }
+
+          std::vector<struct pollfd> fds;
+          for (auto&& process : processes)
+            fds.push_back({process->fd, POLLIN, 0});
+
+          int ready = poll(fds.data(), fds.size(), wait);
+          if (ready < 0 && errno == EINTR)
+            continue;
+          if (ready < 0)
+            throw triton::exceptions::SolverEngine("SmtLibSolver::receive(): Cannot poll the solvers.");
+
+          for (triton::usize index = 0; index < fds.size(); index++) {
+            if (fds[index].revents == 0)
+              continue;
+            char chunk[4096];
+            ssize_t count = read(fds[index].fd, chunk, sizeof(chunk));
+            if (count <= 0) {
+              answer.clear();
+              return static_cast<triton::sint32>(index);
+            }
+            processes[index]->buffer.append(chunk, count);
+          }
+        }
+        #else
+        return -1;
+        #endif
+      }
+
+
+      bool SmtLibSolver::receiveExpression(Process& process, Deadline deadline, bool hasDeadline, std::string& expr) const {
+        std::vector<Process*> processes = {&process};
+        std::string line;
+
+        expr.clear();
+        while (true) {
+          if (this->receive(processes, deadline, hasDeadline, line) < 0 || line.empty())
+            return false;
+
+          expr += line + "\n";
+          triton::sint32 depth = 0;
+          for (char c : expr)
+            depth += (c == '(') - (c == ')');
+          if (depth <= 0)
+            return true;
+        }
+      }
+
+
+      std::string SmtLibSolver::getScript(const triton::ast::SharedAbstractNode& node, std::unordered_map<std::string, triton::engines::symbolic::SharedSymbolicVariable>& variables) const {
+        triton::ast::SharedAstContext actx = node->getContext();
+        std::map<triton::usize, triton::ast::SharedAbstractNode> references;
+        std::ostringstream stream;
+
+        for (auto&& n : triton::ast::search(node, triton::ast::VARIABLE_NODE)) {
+          const auto& var = reinterpret_cast<triton::ast::VariableNode*>(n.get())->getSymbolicVariable();
+          variables[var->getAlias().empty() ? var->getName() : var->getAlias()] = var;
+        }
+
+        /* References are defined in SSA order, each one only uses the previous ones */
+        for (auto&& n : triton::ast::search(node, triton::ast::REFERENCE_NODE)) {
+          const auto& expr = reinterpret_cast<triton::ast::ReferenceNode*>(n.get())->getSymbolicExpression();
+          references[expr->getId()] = expr->getAst();
+        }
+
+        triton::uint32 mode = actx->getRepresentationMode();
+        actx->setRepresentationMode(triton::ast::representations::SMT_REPRESENTATION);
+
+        try {
+          stream << "(push 1)\n";
+
+          for (auto&& var : variables)
+            stream << "(declare-fun " << var.first << " () (_ BitVec " << var.second->getSize() << "))\n";
+
+          for (auto&& ref : references) {
+            stream << "(define-fun ref!" << ref.first << " () ";
+            if (ref.second->isLogical())
+              stream << "Bool ";
+            else
+              stream << "(_ BitVec " << ref.second->getBitvectorSize() << ") ";
+            actx->print(stream, ref.second.get());
+            stream << ")\n";
+          }
+
+          stream << "(assert ";
+          actx->print(stream, node.get());
+          stream << ")\n(check-sat)\n";
+        }
+        catch (...) {
+          actx->setRepresentationMode(mode);
+          throw;
+        }
+
+        actx->setRepresentationMode(mode);
+        return stream.str();
+      }
+
+
+      std::unordered_map<triton::usize, SolverModel> SmtLibSolver::parseModel(const std::string& values, const std::unordered_map<std::string, triton::engines::symbolic::SharedSymbolicVariable>& variables) const {
+        std::unordered_map<triton::usize, SolverModel> model;
+        std::vector<std::string> tokens;
+        std::string token;
+
+        for (char c : values) {
+          if (c == '(' || c == ')' || isspace(static_cast<unsigned char>(c))) {
+            if (!token.empty())
+              tokens.push_back(token);
+            token.clear();
+          }
+          else {
+            token += c;
+          }
+        }
+
+        /* Pairs of a name and a value, written #x.., #b.. or (_ bvN size) */
+        for (triton::usize index = 0; index + 1 < tokens.size(); index++) {
+          auto it = variables.find(tokens[index]);
+          if (it == variables.end())
+            continue;
+
+          const std::string& value = tokens[index + 1];
+          triton::uint512 number = 0;
+
+          if (value.compare(0, 2, "#x") == 0) {
+            number = triton::uint512("0x" + value.substr(2));
+          }
+          else if (value.compare(0, 2, "#b") == 0) {
+            for (char bit : value.substr(2))
+              number = (number << 1) | (bit == '1');
+          }
+          else if (value == "_" && index + 2 < tokens.size() && tokens[index + 2].compare(0, 2, "bv") == 0) {
+            number = triton::uint512(tokens[index + 2].substr(2));
+          }
+          else {
+            throw triton::exceptions::SolverEngine("SmtLibSolver::parseModel(): Unexpected value " + value + ".");
+          }
+
+          model[it->second->getId()] = SolverModel(it->second, number);
+        }
+
+        return model;
+      }
+
+
+      std::vector<std::unordered_map<triton::usize, SolverModel>> SmtLibSolver::getModels(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, triton::engines::solver::status_e* status, triton::uint32 timeout, triton::uint32* solvingTime) const {
+        std::vector<std::unordered_map<triton::usize, SolverModel>> ret;
+        std::unordered_map<std::string, triton::engines::symbolic::SharedSymbolicVariable> variables;
+        std::vector<std::unique_ptr<Process>> processes;
+        triton::engines::solver::status_e st = triton::engines::solver::UNKNOWN;
+        triton::ast::SharedAbstractNode onode = node;
+
+        if (onode == nullptr)
+          throw triton::exceptions::SolverEngine("SmtLibSolver::getModels(): node cannot be null.");
+
+        if (node->getType() == triton::ast::ASSERT_NODE)
+          onode = node->getChildren()[0];
+
+        if (onode->isLogical() == false)
+          throw triton::exceptions::SolverEngine("SmtLibSolver::getModels(): Must be a logical node.");
+
+        if (this->commands.empty())
+          throw triton::exceptions::SolverEngine("SmtLibSolver::getModels(): No solver command.");
+
+        std::string script = this->getScript(onode, variables);
+
+        if (timeout == 0)
+          timeout = this->timeout;
+
+        auto start = std::chrono::steady_clock::now();
+        Deadline deadline = start + std::chrono::milliseconds(timeout);
+        bool hasDeadline = (timeout != 0);
+
+        /* A dead process means its memory limit was reached, or it crashed */
+        auto failure = [this](void) {
+          return this->memoryLimit ? triton::engines::solver::OUTOFMEM : triton::engines::solver::UNKNOWN;
+        };
+
+        /* The query is sent to a process of each command */
+        std::vector<Process*> running;
+        for (triton::usize command = 0; command < this->commands.size(); command++) {
+          processes.push_back(this->acquire(command));
+          if (!this->send(*processes.back(), script)) {
+            this->kill(*processes.back());
+            processes.pop_back();
+            st = failure();
+            continue;
+          }
+          running.push_back(processes.back().get());
+        }
+
+        /* The first sat or unsat answer wins */
+        Process* winner = nullptr;
+        while (!running.empty() && winner == nullptr) {
+          std::string answer;
+          triton::sint32 index = this->receive(running, deadline, hasDeadline, answer);
+
+          if (index < 0) {
+            st = triton::engines::solver::TIMEOUT;
+            break;
+          }
+
+          Process* process = running[index];
+          running.erase(running.begin() + index);
+
+          if (answer == "sat" || answer == "unsat") {
+            st = (answer == "sat") ? triton::engines::solver::SAT : triton::engines::solver::UNSAT;
+            winner = process;
+          }
+          else if (answer.empty()) {
+            this->kill(*process);
+            if (st == triton::engines::solver::UNKNOWN)
+              st = failure();
+          }
+          else if (answer.compare(0, 6, "(error") == 0) {
+            throw triton::exceptions::SolverEngine("SmtLibSolver::getModels(): " + answer);
+          }
+          else {
+            if (answer == "timeout")
+              st = triton::engines::solver::TIMEOUT;
+            if (!this->send(*process, "(pop 1)\n"))
+              this->kill(*process);
+          }
+        }
+
+        /* The losers are still solving */
+        for (auto process : running)
+          this->kill(*process);
+
+        /* The winner enumerates the models, blocking the previous ones */
+        std::ostringstream names;
+        for (auto&& var : variables)
+          names << " " << var.first;
+
+        while (winner && st == triton::engines::solver::SAT && limit >= 1) {
+          std::string values;
+          std::string answer;
+
+          if (variables.empty())
+            break;
+
+          if (!this->send(*winner, "(get-value (" + names.str() + "))\n") || !this->receiveExpression(*winner, deadline, hasDeadline, values)) {
+            this->kill(*winner);
+            break;
+          }
+
+          if (values.compare(0, 6, "(error") == 0)
+            throw triton::exceptions::SolverEngine("SmtLibSolver::getModels(): " + values);
+
+          auto model = this->parseModel(values, variables);
+          if (model.empty())
+            break;
+
+          std::ostringstream block;
+          block << "(assert (or";
+          for (auto&& var : variables) {
+            auto it = model.find(var.second->getId());
+            if (it != model.end())
+              block << " (not (= " << var.first << " (_ bv" << it->second.getValue() << " " << var.second->getSize() << ")))";
+          }
+          block << "))\n(check-sat)\n";
+
+          ret.push_back(std::move(model));
+
+          if (--limit == 0)
+            break;
+
+          std::vector<Process*> alone = {winner};
+          if (!this->send(*winner, block.str()) || this->receive(alone, deadline, hasDeadline, answer) < 0 || answer.empty()) {
+            this->kill(*winner);
+            break;
+          }
+
+          if (answer != "sat")
+            break;
+        }
+
+        if (winner && winner->fd >= 0 && !this->send(*winner, "(pop 1)\n"))
+          this->kill(*winner);
+
+        /* Processes which answered go back to the pool */
+        for (auto&& process : processes) {
+          if (process->fd >= 0)
+            this->release(std::move(process));
+        }
+
+        if (status)
+          *status = st;
+
+        if (solvingTime)
+          *solvingTime = static_cast<triton::uint32>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+
+        return ret;
+      }
+
+
+      std::unordered_map<triton::usize, SolverModel> SmtLibSolver::getModel(const triton::ast::SharedAbstractNode& node, triton::engines::solver::status_e* status, triton::uint32 timeout, triton::uint32* solvingTime) const {
+        std::unordered_map<triton::usize, SolverModel> ret;
+        std::vector<std::unordered_map<triton::usize, SolverModel>> allModels;
+
+        allModels = this->getModels(node, 1, status, timeout, solvingTime);
+        if (allModels.size() > 0)
+          ret = allModels.front();
+
+        return ret;
+      }
+
+
+      bool SmtLibSolver::isSat(const triton::ast::SharedAbstractNode& node, triton::engines::solver::status_e* status, triton::uint32 timeout, triton::uint32* solvingTime) const {
+        triton::engines::solver::status_e st = triton::engines::solver::UNKNOWN;
+
+        this->getModels(node, 0, &st, timeout, solvingTime);
+        if (status)
+          *status = st;
+
+        return st == triton::engines::solver::SAT;
+      }
+
+
+      std::string SmtLibSolver::getName(void) const {
+        return "SMT-LIB";
+      }
+
+
+      void SmtLibSolver::setTimeout(triton::uint32 ms) {
+        this->timeout = ms;
+      }
+
+
+      void SmtLibSolver::setMemoryLimit(triton::uint32 mem) {
+        /* The limit is set when a process starts */
+        this->memoryLimit = mem;
+        this->clear();
+      }
+
+
+      const std::vector<std::vector<std::string>>& SmtLibSolver::getCommands(void) const {
+        return this->commands;
+      }
+
+
+      void SmtLibSolver::setCommands(const std::vector<std::vector<std::string>>& commands) {
+        for (auto&& command : commands) {
+          if (command.empty())
+            throw triton::exceptions::SolverEngine("SmtLibSolver::setCommands(): A command cannot be empty.");
+        }
+        this->commands = commands;
+        this->clear();
+      }
+
+
+      void SmtLibSolver::setPoolSize(triton::usize size) {
+        this->poolSize = size;
+        this->clear();
+      }
+
+    };
+  };
+};
@@ -0,0 +1,312 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the Apache License 2.0.
+*/
+
+#include <algorithm>
+#include <iterator>
+
+#include <triton/astContext.hpp>
+#include <triton/astProgram.hpp>
+#include <triton/exceptions.hpp>
+#include <triton/solverCache.hpp>
+#include <triton/symbolicVariable.hpp>
+
+
+
+namespace triton {
+  namespace engines {
+    namespace solver {
+
+      SolverCache::SolverCache() {
+        this->capacity = 0;
+        this->hits     = 0;
+        this->misses   = 0;
+      }
+
+
+      bool SolverCache::isEnabled(void) const {
+        return (this->capacity != 0);
+      }
+
+
+      /* Returns true if both conjuncts are the same, a hash match is confirmed structurally */
+      static bool isSameConjunct(const std::pair<triton::uint64, triton::ast::SharedAbstractNode>& conjunct1, const std::pair<triton::uint64, triton::ast::SharedAbstractNode>& conjunct2) {
+        if (conjunct1.first != conjunct2.first)
+          return false;
+        return conjunct1.second->getContext()->isStructurallyIdentical(conjunct1.second, conjunct2.second);
+      }
+
+
+      /* Orders conjuncts by hash */
+      static bool isLowerConjunct(const std::pair<triton::uint64, triton::ast::SharedAbstractNode>& conjunct1, const std::pair<triton::uint64, triton::ast::SharedAbstractNode>& conjunct2) {
+        return conjunct1.first < conjunct2.first;
+      }
+
+
+      std::vector<SolverCache::Conjunct> SolverCache::getKey(const triton::ast::SharedAbstractNode& node, triton::uint64& digest) const {
+        std::vector<Conjunct> conjuncts;
+        std::vector<Conjunct> key;
+        std::vector<triton::ast::SharedAbstractNode> worklist;
+
+        worklist.push_back(node);
+        while (!worklist.empty()) {
+          auto n = worklist.back();
+          worklist.pop_back();
+
+          /* The order and the nesting of conjunctions do not matter */
+          if (n->getType() == triton::ast::LAND_NODE) {
+            for (auto&& child : n->getChildren())
+              worklist.push_back(child);
+            continue;
+          }
+
+          conjuncts.push_back(std::make_pair(n->getHash(), n));
+        }
+
+        std::sort(conjuncts.begin(), conjuncts.end(), isLowerConjunct);
+
+        /* Duplicated conjuncts are removed, distinct conjuncts with the same hash are kept */
+        for (auto&& conjunct : conjuncts) {
+          bool duplicated = false;
+          for (auto it = key.rbegin(); it != key.rend() && it->first == conjunct.first; ++it) {
+            if (isSameConjunct(*it, conjunct)) {
+              duplicated = true;
+              break;
+            }
+          }
+          if (!duplicated)
+            key.push_back(std::move(conjunct));
+        }
+
+        digest = 0xcbf29ce484222325;
+        for (auto&& conjunct : key)
+          digest = (digest ^ conjunct.first) * 0x100000001b3;
+
+        return key;
+      }
+
+
+      bool SolverCache::includes(const std::vector<Conjunct>& set, const std::vector<Conjunct>& subset) const {
+        if (subset.size() > set.size())
+          return false;
+
+        for (auto&& conjunct : subset) {
+          auto range = std::equal_range(set.begin(), set.end(), conjunct, isLowerConjunct);
+          if (std::none_of(range.first, range.second, [&](const Conjunct& other) { return isSameConjunct(other, conjunct); }))
+            return false;
+        }
+
+        return true;
+      }
+
+
+      std::unordered_map<triton::usize, SolverModel> SolverCache::extendModel(const triton::ast::SharedAbstractNode& node, const std::vector<const Entry*>& candidates) const {
+        try {
+          triton::ast::AstProgram program(node);
+          const auto& variables = program.getVariables();
+
+          /* Variables not constrained by a cached query are set to zero */
+          std::vector<std::vector<triton::uint64>> assignments;
+          for (auto&& entry : candidates) {
+            const auto& model = entry->models.front();
+            std::vector<triton::uint64> values;
+            for (auto&& var : variables) {
+              auto it = model.find(var->getId());
+              values.push_back(it != model.end() ? static_cast<triton::uint64>(it->second.getValue()) : 0);
+            }
+            assignments.push_back(std::move(values));
+          }
+
+          auto results = program.evaluateBatch(assignments);
+          for (triton::usize i = 0; i < results.size(); i++) {
+            if (results[i] == 0)
+              continue;
+            std::unordered_map<triton::usize, SolverModel> model;
+            for (triton::usize j = 0; j < variables.size(); j++)
+              model[variables[j]->getId()] = SolverModel(variables[j], assignments[i][j]);
+            return model;
+          }
+        }
+        catch (const triton::exceptions::Exception&) {
+          /* The query cannot be evaluated natively (e.g. bit-vectors wider than 64 bits) */
+        }
+
+        return {};
+      }
+
+
+      /* Removes an entry from one of the indexes */
+      template <typename Index, typename Iterator>
+      static void eraseIndex(Index& index, triton::uint64 hash, const Iterator& entry) {
+        auto range = index.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it) {
+          if (it->second == entry) {
+            index.erase(it);
+            return;
+          }
+        }
+      }
+
+
+      void SolverCache::forget(std::list<Entry>::iterator entry) {
+        eraseIndex(this->index, entry->digest, entry);
+        eraseIndex(this->subsets, entry->key.front().first, entry);
+        this->entries.erase(entry);
+      }
+
+
+      void SolverCache::record(Entry&& entry) {
+        auto range = this->index.equal_range(entry.digest);
+        for (auto it = range.first; it != range.second; ++it) {
+          const auto& key = it->second->key;
+          if (key.size() == entry.key.size() && this->includes(key, entry.key)) {
+            this->forget(it->second);
+            break;
+          }
+        }
+
+        this->entries.push_back(std::move(entry));
+        auto last = std::prev(this->entries.end());
+        this->index.emplace(last->digest, last);
+        this->subsets.emplace(last->key.front().first, last);
+
+        while (this->entries.size() > this->capacity)
+          this->forget(this->entries.begin());
+      }
+
+
+      bool SolverCache::lookup(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, std::vector<std::unordered_map<triton::usize, SolverModel>>& models, triton::engines::solver::status_e& status) {
+        triton::ast::SharedAbstractNode query = node;
+        triton::uint64 digest = 0;
+
+        if (!this->isEnabled() || query == nullptr)
+          return false;
+
+        if (query->getType() == triton::ast::ASSERT_NODE)
+          query = query->getChildren()[0];
+
+        /* Invalid queries are left to the solver */
+        if (query->isLogical() == false)
+          return false;
+
+        auto key = this->getKey(query, digest);
+
+        /* Same query */
+        auto range = this->index.equal_range(digest);
+        for (auto it = range.first; it != range.second; ++it) {
+          const Entry& entry = *it->second;
+          if (entry.key.size() != key.size() || !this->includes(key, entry.key))
+            continue;
+          /* The cached query must have asked for enough models or found all of them */
+          if (entry.status == triton::engines::solver::UNSAT || limit == 0 || entry.limit >= limit || entry.models.size() < entry.limit) {
+            models.assign(entry.models.begin(), entry.models.begin() + std::min<triton::usize>(limit, entry.models.size()));
+            status = entry.status;
+            this->hits++;
+            return true;
+          }
+          break;
+        }
+
+        /* Queries whose conjuncts are a subset of this one, indexed by one of its hashes */
+        std::vector<const Entry*> candidates;
+        for (triton::usize i = 0; i < key.size(); i++) {
+          if (i != 0 && key[i].first == key[i - 1].first)
+            continue;
+
+          auto subsets = this->subsets.equal_range(key[i].first);
+          for (auto it = subsets.first; it != subsets.second; ++it) {
+            const Entry& entry = *it->second;
+            if (!this->includes(key, entry.key))
+              continue;
+
+            if (entry.status == triton::engines::solver::UNSAT) {
+              models.clear();
+              status = triton::engines::solver::UNSAT;
+              this->hits++;
+              this->record(Entry{std::move(key), digest, triton::engines::solver::UNSAT, limit, {}});
+              return true;
+            }
+
+            if (limit <= 1 && !entry.models.empty())
+              candidates.push_back(&entry);
+          }
+        }
+
+        if (!candidates.empty()) {
+          auto model = this->extendModel(query, candidates);
+          if (!model.empty()) {
+            models.clear();
+            if (limit)
+              models.push_back(model);
+            status = triton::engines::solver::SAT;
+            this->hits++;
+            this->record(Entry{std::move(key), digest, triton::engines::solver::SAT, 1, {model}});
+            return true;
+          }
+        }
+
+        this->misses++;
+        return false;
+      }
+
+
+      void SolverCache::insert(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, const std::vector<std::unordered_map<triton::usize, SolverModel>>& models, triton::engines::solver::status_e status) {
+        triton::ast::SharedAbstractNode query = node;
+        triton::uint64 digest = 0;
+
+        if (!this->isEnabled() || query == nullptr)
+          return;
+
+        /* Timeouts and unknown answers may change with another budget */
+        if (status != triton::engines::solver::SAT && status != triton::engines::solver::UNSAT)
+          return;
+
+        if (query->getType() == triton::ast::ASSERT_NODE)
+          query = query->getChildren()[0];
+
+        auto key = this->getKey(query, digest);
+        this->record(Entry{std::move(key), digest, status, limit, models});
+      }
+
+
+      void SolverCache::clear(void) {
+        this->entries.clear();
+        this->index.clear();
+        this->subsets.clear();
+        this->hits   = 0;
+        this->misses = 0;
+      }
+
+
+      triton::usize SolverCache::getCapacity(void) const {
+        return this->capacity;
+      }
+
+
+      void SolverCache::setCapacity(triton::usize capacity) {
+        this->capacity = capacity;
+        while (this->entries.size() > this->capacity)
+          this->forget(this->entries.begin());
+      }
+
+
+      triton::usize SolverCache::getSize(void) const {
+        return this->entries.size();
+      }
+
+
+      triton::usize SolverCache::getHits(void) const {
+        return this->hits;
+      }
+
+
+      triton::usize SolverCache::getMisses(void) const {
+        return this->misses;
+      }
+
+    };
+  };
+};
@@ -5,6 +5,8 @@
 **  This program is under the terms of the Apache License 2.0.
 */
 
+#include <chrono>
+#include <triton/astContext.hpp>
 #include <triton/config.hpp>
 #include <triton/exceptions.hpp>
 #include <triton/solverEngine.hpp>
@@ -16,7 +18,10 @@ namespace triton {
     namespace solver {
 
       SolverEngine::SolverEngine() {
-        this->kind = triton::engines::solver::SOLVER_INVALID;
+        this->kind        = triton::engines::solver::SOLVER_INVALID;
+        this->timeout     = 0;
+        this->memoryLimit = 0;
+        this->policy      = triton::engines::solver::POLICY_FULL;
         #ifdef TRITON_Z3_INTERFACE
         /* By default we initialized the z3 solver */
         this->setSolver(triton::engines::solver::SOLVER_Z3);
@@ -48,6 +53,20 @@ namespace triton {
             break;
           #endif
 
+          case triton::engines::solver::SOLVER_LOCAL_SEARCH:
+            /* init the new instance */
+            this->solver.reset(new(std::nothrow) triton::engines::solver::LocalSearchSolver());
+            if (this->solver == nullptr)
+              throw triton::exceptions::SolverEngine("SolverEngine::setSolver(): Not enough memory.");
+            break;
+
+          case triton::engines::solver::SOLVER_SMTLIB:
+            /* init the new instance */
+            this->solver.reset(new(std::nothrow) triton::engines::solver::SmtLibSolver());
+            if (this->solver == nullptr)
+              throw triton::exceptions::SolverEngine("SolverEngine::setSolver(): Not enough memory.");
+            break;
+
           default:
             throw triton::exceptions::SolverEngine("SolverEngine::setSolver(): Solver not supported.");
             break;
@@ -55,6 +74,7 @@ namespace triton {
 
         /* Setup global variables */
         this->kind = kind;
+        this->cache.clear();
       }
 
 
@@ -67,6 +87,7 @@ namespace triton {
 
         /* Setup global variables */
         this->kind = triton::engines::solver::SOLVER_CUSTOM;
+        this->cache.clear();
       }
 
 
@@ -80,21 +101,216 @@ namespace triton {
       std::unordered_map<triton::usize, SolverModel> SolverEngine::getModel(const triton::ast::SharedAbstractNode& node, triton::engines::solver::status_e* status, triton::uint32 timeout, triton::uint32* solvingTime) const {
         if (!this->solver)
           return std::unordered_map<triton::usize, SolverModel>{};
-        return this->solver->getModel(node, status, timeout, solvingTime);
+
+        std::vector<std::unordered_map<triton::usize, SolverModel>> models;
+        triton::engines::solver::status_e st = triton::engines::solver::UNKNOWN;
+
+        if (this->trivial.solve(node, 1, models, st) || this->cache.lookup(node, 1, models, st)) {
+          if (status) *status = st;
+          if (solvingTime) *solvingTime = 0;
+          return models.empty() ? std::unordered_map<triton::usize, SolverModel>{} : models.front();
+        }
+
+        if (!this->cache.isEnabled())
+          return this->solver->getModel(node, status, timeout, solvingTime);
+
+        auto model = this->solver->getModel(node, &st, timeout, solvingTime);
+        if (!model.empty())
+          models.push_back(model);
+        this->cache.insert(node, 1, models, st);
+
+        if (status) *status = st;
+        return model;
       }
 
 
       std::vector<std::unordered_map<triton::usize, SolverModel>> SolverEngine::getModels(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, triton::engines::solver::status_e* status, triton::uint32 timeout, triton::uint32* solvingTime) const {
         if (!this->solver)
           return std::vector<std::unordered_map<triton::usize, SolverModel>>{};
-        return this->solver->getModels(node, limit, status, timeout, solvingTime);
+
+        std::vector<std::unordered_map<triton::usize, SolverModel>> models;
+        triton::engines::solver::status_e st = triton::engines::solver::UNKNOWN;
+
+        if (this->trivial.solve(node, limit, models, st) || this->cache.lookup(node, limit, models, st)) {
+          if (status) *status = st;
+          if (solvingTime) *solvingTime = 0;
+          return models;
+        }
+
+        if (!this->cache.isEnabled())
+          return this->solver->getModels(node, limit, status, timeout, solvingTime);
+
+        models = this->solver->getModels(node, limit, &st, timeout, solvingTime);
+        this->cache.insert(node, limit, models, st);
+
+        if (status) *status = st;
+        return models;
+      }
+
+
+      std::vector<std::unordered_map<triton::usize, SolverModel>> SolverEngine::getModels(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, const std::vector<triton::engines::symbolic::SharedSymbolicVariable>& variables, triton::engines::solver::status_e* status, triton::uint32 timeout, triton::uint32* solvingTime) const {
+        std::vector<std::unordered_map<triton::usize, SolverModel>> models;
+        triton::engines::solver::status_e st = triton::engines::solver::UNKNOWN;
+        triton::uint32 total = 0;
+
+        if (!this->solver)
+          return models;
+
+        if (variables.empty())
+          return this->getModels(node, limit, status, timeout, solvingTime);
+
+        #ifdef TRITON_Z3_INTERFACE
+        if (this->kind == triton::engines::solver::SOLVER_Z3)
+          return static_cast<const triton::engines::solver::Z3Solver*>(this->solver.get())->getModels(node, limit, variables, status, timeout, solvingTime);
+        #endif
+
+        /* Other solvers are asked one model at a time, blocking the projected values found */
+        if (node == nullptr)
+          throw triton::exceptions::SolverEngine("SolverEngine::getModels(): node cannot be null.");
+
+        triton::ast::SharedAstContext actx = node->getContext();
+        triton::ast::SharedAbstractNode query = (node->getType() == triton::ast::ASSERT_NODE) ? node->getChildren()[0] : node;
+
+        /* The timeout bounds the whole enumeration, each query gets what is left of it */
+        if (timeout == 0)
+          timeout = this->timeout;
+        auto start = std::chrono::steady_clock::now();
+
+        while (models.size() < limit) {
+          triton::uint32 time = 0;
+          triton::uint32 left = 0;
+
+          if (timeout) {
+            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+            if (elapsed >= timeout) {
+              st = triton::engines::solver::TIMEOUT;
+              break;
+            }
+            left = timeout - static_cast<triton::uint32>(elapsed);
+          }
+
+          auto model = this->solver->getModel(query, &st, left, &time);
+          total += time;
+
+          if (st != triton::engines::solver::SAT)
+            break;
+
+          /* A variable absent from the model is unconstrained, it takes 0 and is blocked like the others */
+          std::unordered_map<triton::usize, SolverModel> projected;
+          std::vector<triton::ast::SharedAbstractNode> args;
+          for (auto&& var : variables) {
+            auto it = model.find(var->getId());
+            SolverModel value = (it != model.end()) ? it->second : SolverModel(var, 0);
+            args.push_back(actx->distinct(actx->variable(var), actx->bv(value.getValue(), var->getSize())));
+            projected[var->getId()] = std::move(value);
+          }
+
+          models.push_back(std::move(projected));
+          query = actx->land(query, (args.size() == 1) ? args[0] : actx->lor(args));
+        }
+
+        /* The last query may have no model while the previous ones had */
+        if (!models.empty())
+          st = triton::engines::solver::SAT;
+
+        if (status) *status = st;
+        if (solvingTime) *solvingTime = total;
+        return models;
       }
 
 
       bool SolverEngine::isSat(const triton::ast::SharedAbstractNode& node, triton::engines::solver::status_e* status, triton::uint32 timeout, triton::uint32* solvingTime) const {
         if (!this->solver)
           return false;
-        return this->solver->isSat(node, status, timeout, solvingTime);
+
+        std::vector<std::unordered_map<triton::usize, SolverModel>> models;
+        triton::engines::solver::status_e st = triton::engines::solver::UNKNOWN;
+
+        if (this->trivial.solve(node, 0, models, st) || this->cache.lookup(node, 0, models, st)) {
+          if (status) *status = st;
+          if (solvingTime) *solvingTime = 0;
+          return (st == triton::engines::solver::SAT);
+        }
+
+        if (!this->cache.isEnabled())
+          return this->solver->isSat(node, status, timeout, solvingTime);
+
+        bool sat = this->solver->isSat(node, &st, timeout, solvingTime);
+        this->cache.insert(node, 0, models, st);
+
+        if (status) *status = st;
+        return sat;
+      }
+
+
+      #ifdef TRITON_Z3_INTERFACE
+      triton::engines::solver::Z3Session& SolverEngine::getSession(void) {
+        if (!this->session) {
+          this->session.reset(new(std::nothrow) triton::engines::solver::Z3Session());
+          if (this->session == nullptr)
+            throw triton::exceptions::SolverEngine("SolverEngine::getSession(): Not enough memory.");
+          this->session->setTimeout(this->timeout);
+          this->session->setMemoryLimit(this->memoryLimit);
+        }
+        return *this->session;
+      }
+      #endif
+
+
+      void SolverEngine::resetSession(void) {
+        #ifdef TRITON_Z3_INTERFACE
+        this->session.reset();
+        #endif
+      }
+
+
+      void SolverEngine::flipPathConstraints(const std::vector<triton::engines::symbolic::PathConstraint>& pcs, const std::vector<triton::usize>& stamps, const triton::engines::solver::ParallelSolver::Callback& callback, triton::uint32 threads, triton::uint32 timeout) const {
+        #ifdef TRITON_Z3_INTERFACE
+        if (this->kind == triton::engines::solver::SOLVER_Z3) {
+          triton::engines::solver::ParallelSolver solver(threads, timeout ? timeout : this->timeout, this->memoryLimit, this->policy);
+          solver.flip(pcs, stamps, callback);
+          return;
+        }
+        #endif
+        throw triton::exceptions::SolverEngine("SolverEngine::flipPathConstraints(): Solver instance must be a SOLVER_Z3.");
+      }
+
+
+      triton::engines::solver::SolverCache& SolverEngine::getCache(void) {
+        return this->cache;
+      }
+
+
+      triton::engines::solver::TrivialSolver& SolverEngine::getTrivialSolver(void) {
+        return this->trivial;
+      }
+
+
+      triton::engines::solver::policy_e SolverEngine::getPolicy(void) const {
+        return this->policy;
+      }
+
+
+      void SolverEngine::setPolicy(triton::engines::solver::policy_e policy) {
+        switch (policy) {
+          case triton::engines::solver::POLICY_FULL:
+          case triton::engines::solver::POLICY_NESTED:
+          case triton::engines::solver::POLICY_LAST:
+            this->policy = policy;
+            break;
+
+          default:
+            throw triton::exceptions::SolverEngine("SolverEngine::setPolicy(): Invalid policy.");
+        }
+      }
+
+
+      void SolverEngine::setCommands(const std::vector<std::vector<std::string>>& commands) {
+        if (this->kind != triton::engines::solver::SOLVER_SMTLIB)
+          throw triton::exceptions::SolverEngine("SolverEngine::setCommands(): Solver instance must be a SOLVER_SMTLIB.");
+
+        static_cast<triton::engines::solver::SmtLibSolver*>(this->solver.get())->setCommands(commands);
+        this->cache.clear();
       }
 
 
@@ -106,16 +322,28 @@ namespace triton {
 
 
       void SolverEngine::setTimeout(triton::uint32 ms) {
+        this->timeout = ms;
         if (this->solver) {
           this->solver->setTimeout(ms);
         }
+        #ifdef TRITON_Z3_INTERFACE
+        if (this->session) {
+          this->session->setTimeout(ms);
+        }
+        #endif
       }
 
 
       void SolverEngine::setMemoryLimit(triton::uint32 limit) {
+        this->memoryLimit = limit;
         if (this->solver) {
           this->solver->setMemoryLimit(limit);
         }
+        #ifdef TRITON_Z3_INTERFACE
+        if (this->session) {
+          this->session->setMemoryLimit(limit);
+        }
+        #endif
       }
 
     };
@@ -0,0 +1,556 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the Apache License 2.0.
+*/
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+#include <triton/exceptions.hpp>
+#include <triton/symbolicExpression.hpp>
+#include <triton/trivialSolver.hpp>
+
+
+
+namespace triton {
+  namespace engines {
+    namespace solver {
+
+      //! The max number of candidate values checked per variable.
+      static const triton::usize TRIVIAL_SOLVER_BUDGET = 0x10000;
+
+      //! The max depth of a term.
+      static const triton::uint32 TRIVIAL_SOLVER_DEPTH = 64;
+
+
+      static triton::uint64 maskOf(triton::uint32 size) {
+        return (size >= 64) ? static_cast<triton::uint64>(-1) : ((static_cast<triton::uint64>(1) << size) - 1);
+      }
+
+
+      static triton::uint64 toUint64(const triton::uint512& value) {
+        return static_cast<triton::uint64>(value & static_cast<triton::uint64>(-1));
+      }
+
+
+      /* Returns the inverse of an odd number modulo 2^64 (Newton iteration) */
+      static triton::uint64 inverseOf(triton::uint64 odd) {
+        triton::uint64 inv = odd;
+        for (triton::uint32 i = 0; i < 5; i++)
+          inv *= 2 - odd * inv;
+        return inv;
+      }
+
+
+      TrivialSolver::TrivialSolver() {
+        this->enabled = false;
+        this->hits    = 0;
+      }
+
+
+      bool TrivialSolver::isEnabled(void) const {
+        return this->enabled;
+      }
+
+
+      void TrivialSolver::setEnabled(bool flag) {
+        this->enabled = flag;
+      }
+
+
+      triton::usize TrivialSolver::getHits(void) const {
+        return this->hits;
+      }
+
+
+      bool TrivialSolver::getTerm(triton::ast::AbstractNode* node, Term& term, triton::uint32 depth) const {
+        if (depth > TRIVIAL_SOLVER_DEPTH || node->getBitvectorSize() > 64)
+          return false;
+
+        term.size = node->getBitvectorSize();
+
+        /* Constants */
+        if (node->isSymbolized() == false) {
+          term.variable = nullptr;
+          term.a = 0;
+          term.b = toUint64(node->evaluate());
+          return true;
+        }
+
+        auto& children = node->getChildren();
+        triton::uint64 mask = maskOf(term.size);
+
+        switch (node->getType()) {
+          case triton::ast::VARIABLE_NODE:
+            term.variable = reinterpret_cast<triton::ast::VariableNode*>(node)->getSymbolicVariable();
+            term.a = 1;
+            term.b = 0;
+            return true;
+
+          case triton::ast::REFERENCE_NODE:
+            return this->getTerm(reinterpret_cast<triton::ast::ReferenceNode*>(node)->getSymbolicExpression()->getAst().get(), term, depth + 1);
+
+          /* Only low bits keep the term affine */
+          case triton::ast::EXTRACT_NODE: {
+            if (reinterpret_cast<triton::ast::IntegerNode*>(children[1].get())->getInteger() != 0)
+              return false;
+            Term sub;
+            if (!this->getTerm(children[2].get(), sub, depth + 1))
+              return false;
+            term.variable = sub.variable;
+            term.a = sub.a & mask;
+            term.b = sub.b & mask;
+            return true;
+          }
+
+          /* Only a term equal to its variable can be extended */
+          case triton::ast::ZX_NODE: {
+            Term sub;
+            if (!this->getTerm(children[1].get(), sub, depth + 1))
+              return false;
+            if (sub.variable == nullptr || sub.a != 1 || sub.b != 0 || sub.size < sub.variable->getSize())
+              return false;
+            term.variable = sub.variable;
+            term.a = 1;
+            term.b = 0;
+            return true;
+          }
+
+          /* Constant high bits over a term equal to its variable */
+          case triton::ast::CONCAT_NODE: {
+            Term sub;
+            triton::uint64 high = 0;
+            for (triton::usize index = 0; index + 1 < children.size(); index++) {
+              if (children[index]->isSymbolized())
+                return false;
+              high = (high << children[index]->getBitvectorSize()) | toUint64(children[index]->evaluate());
+            }
+            if (!this->getTerm(children.back().get(), sub, depth + 1))
+              return false;
+            if (sub.variable == nullptr || sub.a != 1 || sub.b != 0 || sub.size < sub.variable->getSize())
+              return false;
+            term.variable = sub.variable;
+            term.a = 1;
+            term.b = (high << sub.size) & mask;
+            return true;
+          }
+
+          case triton::ast::BVNEG_NODE:
+          case triton::ast::BVNOT_NODE: {
+            Term sub;
+            if (!this->getTerm(children[0].get(), sub, depth + 1))
+              return false;
+            term.variable = sub.variable;
+            term.a = (0 - sub.a) & mask;
+            term.b = (0 - sub.b - (node->getType() == triton::ast::BVNOT_NODE ? 1 : 0)) & mask;
+            return true;
+          }
+
+          case triton::ast::BVADD_NODE:
+          case triton::ast::BVSUB_NODE:
+          case triton::ast::BVMUL_NODE:
+          case triton::ast::BVSHL_NODE: {
+            Term lhs, rhs;
+            if (!this->getTerm(children[0].get(), lhs, depth + 1) || !this->getTerm(children[1].get(), rhs, depth + 1))
+              return false;
+
+            if (lhs.variable && rhs.variable && lhs.variable->getId() != rhs.variable->getId())
+              return false;
+
+            term.variable = lhs.variable ? lhs.variable : rhs.variable;
+
+            switch (node->getType()) {
+              case triton::ast::BVADD_NODE:
+                term.a = (lhs.a + rhs.a) & mask;
+                term.b = (lhs.b + rhs.b) & mask;
+                return true;
+
+              case triton::ast::BVSUB_NODE:
+                term.a = (lhs.a - rhs.a) & mask;
+                term.b = (lhs.b - rhs.b) & mask;
+                return true;
+
+              case triton::ast::BVMUL_NODE:
+                if (lhs.variable && rhs.variable)
+                  return false;
+                if (rhs.variable)
+                  std::swap(lhs, rhs);
+                term.a = (lhs.a * rhs.b) & mask;
+                term.b = (lhs.b * rhs.b) & mask;
+                return true;
+
+              default:
+                if (rhs.variable)
+                  return false;
+                if (rhs.b >= term.size) {
+                  term.a = 0;
+                  term.b = 0;
+                  return true;
+                }
+                term.a = (lhs.a << rhs.b) & mask;
+                term.b = (lhs.b << rhs.b) & mask;
+                return true;
+            }
+          }
+
+          default:
+            return false;
+        }
+      }
+
+
+      bool TrivialSolver::getAtom(triton::ast::AbstractNode* node, bool negate, std::vector<Atom>& atoms, bool& unsat) const {
+        /* Constant comparisons */
+        if (node->isSymbolized() == false) {
+          if ((node->evaluate() != 0) == negate)
+            unsat = true;
+          return true;
+        }
+
+        triton::ast::ast_e type = node->getType();
+        switch (type) {
+          case triton::ast::LNOT_NODE:
+            return this->getAtom(node->getChildren()[0].get(), !negate, atoms, unsat);
+
+          case triton::ast::EQUAL_NODE:
+          case triton::ast::DISTINCT_NODE:
+          case triton::ast::BVUGE_NODE:
+          case triton::ast::BVUGT_NODE:
+          case triton::ast::BVULE_NODE:
+          case triton::ast::BVULT_NODE:
+          case triton::ast::BVSGE_NODE:
+          case triton::ast::BVSGT_NODE:
+          case triton::ast::BVSLE_NODE:
+          case triton::ast::BVSLT_NODE:
+            break;
+
+          default:
+            return false;
+        }
+
+        Term lhs, rhs;
+        auto& children = node->getChildren();
+        if (!this->getTerm(children[0].get(), lhs, 0) || !this->getTerm(children[1].get(), rhs, 0))
+          return false;
+
+        if (lhs.variable && rhs.variable)
+          return false;
+
+        /* The term is on the left */
+        if (rhs.variable) {
+          std::swap(lhs, rhs);
+          switch (type) {
+            case triton::ast::BVUGE_NODE: type = triton::ast::BVULE_NODE; break;
+            case triton::ast::BVUGT_NODE: type = triton::ast::BVULT_NODE; break;
+            case triton::ast::BVULE_NODE: type = triton::ast::BVUGE_NODE; break;
+            case triton::ast::BVULT_NODE: type = triton::ast::BVUGT_NODE; break;
+            case triton::ast::BVSGE_NODE: type = triton::ast::BVSLE_NODE; break;
+            case triton::ast::BVSGT_NODE: type = triton::ast::BVSLT_NODE; break;
+            case triton::ast::BVSLE_NODE: type = triton::ast::BVSGE_NODE; break;
+            case triton::ast::BVSLT_NODE: type = triton::ast::BVSGT_NODE; break;
+            default: break;
+          }
+        }
+
+        Atom atom;
+        atom.term  = lhs;
+        atom.value = rhs.b;
+
+        triton::uint64 mask = maskOf(lhs.size);
+        triton::uint64 sign = static_cast<triton::uint64>(1) << (lhs.size - 1);
+
+        /* A signed comparison is an unsigned one once both sides are shifted by 2^(n-1) */
+        switch (type) {
+          case triton::ast::BVSGE_NODE: type = triton::ast::BVUGE_NODE; break;
+          case triton::ast::BVSGT_NODE: type = triton::ast::BVUGT_NODE; break;
+          case triton::ast::BVSLE_NODE: type = triton::ast::BVULE_NODE; break;
+          case triton::ast::BVSLT_NODE: type = triton::ast::BVULT_NODE; break;
+          default: sign = 0; break;
+        }
+        atom.term.b = (atom.term.b + sign) & mask;
+        atom.value  = (atom.value ^ sign) & mask;
+
+        if (negate) {
+          switch (type) {
+            case triton::ast::EQUAL_NODE:    type = triton::ast::DISTINCT_NODE; break;
+            case triton::ast::DISTINCT_NODE: type = triton::ast::EQUAL_NODE; break;
+            case triton::ast::BVUGE_NODE:    type = triton::ast::BVULT_NODE; break;
+            case triton::ast::BVUGT_NODE:    type = triton::ast::BVULE_NODE; break;
+            case triton::ast::BVULE_NODE:    type = triton::ast::BVUGT_NODE; break;
+            case triton::ast::BVULT_NODE:    type = triton::ast::BVUGE_NODE; break;
+            default: break;
+          }
+        }
+
+        switch (type) {
+          case triton::ast::EQUAL_NODE:
+            atom.compare = EQ;
+            break;
+
+          case triton::ast::DISTINCT_NODE:
+            atom.compare = NE;
+            break;
+
+          case triton::ast::BVUGE_NODE:
+            atom.compare = UGE;
+            break;
+
+          case triton::ast::BVULE_NODE:
+            atom.compare = ULE;
+            break;
+
+          case triton::ast::BVUGT_NODE:
+            if (atom.value == mask) {
+              unsat = true;
+              return true;
+            }
+            atom.compare = UGE;
+            atom.value++;
+            break;
+
+          default:
+            if (atom.value == 0) {
+              unsat = true;
+              return true;
+            }
+            atom.compare = ULE;
+            atom.value--;
+            break;
+        }
+
+        atoms.push_back(atom);
+        return true;
+      }
+
+
+      bool TrivialSolver::getAtoms(triton::ast::AbstractNode* node, std::vector<Atom>& atoms, bool& unsat) const {
+        if (node->getType() != triton::ast::LAND_NODE)
+          return this->getAtom(node, false, atoms, unsat);
+
+        for (auto&& child : node->getChildren()) {
+          if (!this->getAtoms(child.get(), atoms, unsat))
+            return false;
+          if (unsat)
+            return true;
+        }
+
+        return true;
+      }
+
+
+      bool TrivialSolver::isSatisfied(const Atom& atom, triton::uint64 x) const {
+        triton::uint64 v = (atom.term.a * x + atom.term.b) & maskOf(atom.term.size);
+
+        switch (atom.compare) {
+          case EQ:  return v == atom.value;
+          case NE:  return v != atom.value;
+          case ULE: return v <= atom.value;
+          default:  return v >= atom.value;
+        }
+      }
+
+
+      bool TrivialSolver::getSolutions(const std::vector<const Atom*>& atoms, triton::uint32 size, triton::uint32 limit, std::vector<triton::uint64>& solutions) const {
+        typedef std::pair<triton::uint64, triton::uint64> Interval;
+
+        triton::uint64 maxX  = maskOf(size);
+        triton::uint64 first = 0;
+        triton::uint64 step  = 0;
+        triton::uint32 bits  = 0;
+        bool progression     = false;
+
+        /* Candidates are the values of the variable in these intervals */
+        std::vector<Interval> intervals = {Interval(0, maxX)};
+
+        for (auto&& atom : atoms) {
+          triton::uint64 mask = maskOf(atom->term.size);
+
+          /* The term does not depend on the variable */
+          if (atom->term.a == 0) {
+            if (!this->isSatisfied(*atom, 0))
+              return true;
+            continue;
+          }
+
+          /* a * x == c - b has solutions x0 + k * 2^(n-t), with 2^t the largest power of two dividing a */
+          if (atom->compare == EQ) {
+            triton::uint32 t = 0;
+            while (((atom->term.a >> t) & 1) == 0)
+              t++;
+
+            triton::uint64 d = (atom->value - atom->term.b) & mask;
+            if (t && (d & maskOf(t)))
+              return true;
+
+            triton::uint32 k = atom->term.size - t;
+            if (!progression || k > bits) {
+              progression = true;
+              bits  = k;
+              first = ((d >> t) * inverseOf(atom->term.a >> t)) & maskOf(k);
+              step  = (k >= 64) ? 0 : (static_cast<triton::uint64>(1) << k);
+            }
+          }
+
+          /* A term x + b covering the variable maps a range of values to at most two ranges of the variable */
+          if (atom->term.a == 1 && atom->term.size >= size) {
+            triton::uint64 lo = 0;
+            triton::uint64 hi = mask;
+            switch (atom->compare) {
+              case EQ:  lo = atom->value; hi = atom->value; break;
+              case NE:  lo = (atom->value + 1) & mask; hi = (atom->value - 1) & mask; break;
+              case ULE: hi = atom->value; break;
+              default:  lo = atom->value; break;
+            }
+            lo = (lo - atom->term.b) & mask;
+            hi = (hi - atom->term.b) & mask;
+
+            std::vector<Interval> ranges;
+            if (lo <= hi) {
+              ranges.push_back(Interval(lo, hi));
+            }
+            else {
+              ranges.push_back(Interval(0, hi));
+              ranges.push_back(Interval(lo, mask));
+            }
+
+            std::vector<Interval> next;
+            for (auto&& i : intervals) {
+              for (auto&& r : ranges) {
+                triton::uint64 l = std::max(i.first, r.first);
+                triton::uint64 h = std::min(i.second, r.second);
+                if (l <= h)
+                  next.push_back(Interval(l, h));
+              }
+            }
+            std::sort(next.begin(), next.end());
+            intervals.swap(next);
+
+            if (intervals.empty())
+              return true;
+          }
+        }
+
+        triton::usize budget = TRIVIAL_SOLVER_BUDGET;
+        auto check = [&](triton::uint64 x) -> bool {
+          for (auto&& atom : atoms) {
+            if (!this->isSatisfied(*atom, x))
+              return false;
+          }
+          return true;
+        };
+
+        if (progression) {
+          for (triton::uint64 x = first; x <= maxX; x += step) {
+            if (check(x)) {
+              solutions.push_back(x);
+              if (solutions.size() >= limit)
+                return true;
+            }
+            if (--budget == 0)
+              return false;
+            /* Stops before wrapping */
+            if (step == 0 || x > maxX - step)
+              break;
+          }
+          return true;
+        }
+
+        for (auto&& i : intervals) {
+          for (triton::uint64 x = i.first; ; x++) {
+            if (check(x)) {
+              solutions.push_back(x);
+              if (solutions.size() >= limit)
+                return true;
+            }
+            if (--budget == 0)
+              return false;
+            if (x == i.second)
+              break;
+          }
+        }
+
+        return true;
+      }
+
+
+      bool TrivialSolver::solve(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, std::vector<std::unordered_map<triton::usize, SolverModel>>& models, triton::engines::solver::status_e& status) {
+        triton::ast::SharedAbstractNode query = node;
+        std::vector<Atom> atoms;
+        bool unsat = false;
+
+        if (!this->enabled || query == nullptr)
+          return false;
+
+        if (query->getType() == triton::ast::ASSERT_NODE)
+          query = query->getChildren()[0];
+
+        /* Invalid queries are left to the solver */
+        if (query->isLogical() == false)
+          return false;
+
+        if (!this->getAtoms(query.get(), atoms, unsat))
+          return false;
+
+        if (unsat) {
+          models.clear();
+          status = triton::engines::solver::UNSAT;
+          this->hits++;
+          return true;
+        }
+
+        /* Atoms over distinct variables are independent */
+        std::map<triton::usize, std::vector<const Atom*>> groups;
+        for (auto&& atom : atoms) {
+          if (atom.term.variable == nullptr || atom.term.variable->getSize() > 64)
+            return false;
+          groups[atom.term.variable->getId()].push_back(&atom);
+        }
+
+        /* Queries without variables are left to the solver */
+        if (groups.empty())
+          return false;
+
+        std::vector<triton::engines::symbolic::SharedSymbolicVariable> variables;
+        std::vector<std::vector<triton::uint64>> solutions;
+        for (auto&& group : groups) {
+          const auto& variable = group.second.front()->term.variable;
+          std::vector<triton::uint64> values;
+          if (!this->getSolutions(group.second, variable->getSize(), std::max<triton::uint32>(limit, 1), values))
+            return false;
+          if (values.empty()) {
+            models.clear();
+            status = triton::engines::solver::UNSAT;
+            this->hits++;
+            return true;
+          }
+          variables.push_back(variable);
+          solutions.push_back(std::move(values));
+        }
+
+        /* Models are the combinations of the values of each variable, the last variable first */
+        models.clear();
+        std::vector<triton::usize> indexes(variables.size(), 0);
+        while (models.size() < limit) {
+          std::unordered_map<triton::usize, SolverModel> model;
+          for (triton::usize i = 0; i < variables.size(); i++)
+            model[variables[i]->getId()] = SolverModel(variables[i], solutions[i][indexes[i]]);
+          models.push_back(std::move(model));
+
+          triton::usize i = variables.size();
+          while (i > 0 && ++indexes[i - 1] == solutions[i - 1].size())
+            indexes[--i] = 0;
+          if (i == 0)
+            break;
+        }
+
+        status = triton::engines::solver::SAT;
+        this->hits++;
+        return true;
+      }
+
+    };
+  };
+};
@@ -0,0 +1,279 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the Apache License 2.0.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+
+#include <triton/ast.hpp>
+#include <triton/exceptions.hpp>
+#include <triton/parallelSolver.hpp>
+#include <triton/symbolicVariable.hpp>
+#include <triton/z3Session.hpp>
+
+
+
+namespace triton {
+  namespace engines {
+    namespace solver {
+
+      ParallelSolver::ParallelSolver(triton::uint32 threads, triton::uint32 timeout, triton::uint32 memoryLimit, triton::engines::solver::policy_e policy) {
+        this->threads     = threads;
+        this->timeout     = timeout;
+        this->memoryLimit = memoryLimit;
+        this->policy      = policy;
+      }
+
+
+      void ParallelSolver::flip(const std::vector<triton::engines::symbolic::PathConstraint>& pcs, const std::vector<triton::usize>& stamps, const Callback& callback) const {
+        struct Job {
+          triton::usize index;
+          triton::uint64 srcAddr;
+          triton::uint64 dstAddr;
+          triton::ast::SharedAbstractNode predicate;
+          std::vector<triton::usize> slice;
+        };
+
+        if (pcs.size() != stamps.size())
+          throw triton::exceptions::SolverEngine("ParallelSolver::flip(): Invalid path constraints.");
+
+        /* Jobs are in path order, so each worker extends its session incrementally */
+        std::vector<Job> jobs;
+        for (triton::usize index = 0; index < pcs.size(); index++) {
+          if (!pcs[index].isMultipleBranches())
+            continue;
+          for (auto&& branch : pcs[index].getBranchConstraints()) {
+            if (std::get<0>(branch) == false)
+              jobs.push_back(Job{index, std::get<1>(branch), std::get<2>(branch), std::get<3>(branch), {}});
+          }
+        }
+
+        if (jobs.empty())
+          return;
+
+        /*
+         * The path constraints sharing variables with each branch. Constraints
+         * are added to an union-find over their variables in path order, each
+         * cluster keeping the indexes of its constraints.
+         */
+        if (this->policy != triton::engines::solver::POLICY_FULL) {
+          std::unordered_map<triton::usize, triton::usize> parent;
+          std::unordered_map<triton::usize, std::vector<triton::usize>> members;
+
+          auto find = [&parent](triton::usize var) -> triton::usize {
+            auto it = parent.find(var);
+            if (it == parent.end()) {
+              parent[var] = var;
+              return var;
+            }
+            while (parent[var] != var) {
+              parent[var] = parent[parent[var]];
+              var = parent[var];
+            }
+            return var;
+          };
+
+          auto variablesOf = [](const triton::ast::SharedAbstractNode& node) {
+            std::vector<triton::usize> ids;
+            for (auto&& n : triton::ast::search(node, triton::ast::VARIABLE_NODE))
+              ids.push_back(reinterpret_cast<triton::ast::VariableNode*>(n.get())->getSymbolicVariable()->getId());
+            return ids;
+          };
+
+          triton::usize added = 0;
+          for (auto&& job : jobs) {
+            for (; added < job.index; added++) {
+              auto vars = variablesOf(pcs[added].getTakenPredicate());
+              if (vars.empty())
+                continue;
+              triton::usize root = find(vars[0]);
+              for (triton::usize i = 1; i < vars.size(); i++) {
+                triton::usize other = find(vars[i]);
+                if (other == root)
+                  continue;
+                if (members[root].size() < members[other].size())
+                  std::swap(root, other);
+                members[root].insert(members[root].end(), members[other].begin(), members[other].end());
+                members.erase(other);
+                parent[other] = root;
+              }
+              members[root].push_back(added);
+            }
+
+            std::vector<triton::usize> roots;
+            for (auto var : variablesOf(job.predicate))
+              roots.push_back(find(var));
+            std::sort(roots.begin(), roots.end());
+            roots.erase(std::unique(roots.begin(), roots.end()), roots.end());
+
+            for (auto root : roots) {
+              auto it = members.find(root);
+              if (it != members.end())
+                job.slice.insert(job.slice.end(), it->second.begin(), it->second.end());
+            }
+            std::sort(job.slice.begin(), job.slice.end());
+          }
+        }
+
+        triton::usize count = this->threads;
+        if (count == 0)
+          count = std::max<triton::usize>(std::thread::hardware_concurrency(), 1);
+        count = std::min<triton::usize>(count, jobs.size());
+
+        /*
+         * Sessions are created and destroyed by the calling thread, which also
+         * keeps the ASTs alive, so workers never release the last reference of
+         * a node.
+         */
+        std::vector<std::unique_ptr<Z3Session>> sessions;
+        std::vector<std::unique_ptr<Z3Session>> fallbacks;
+        for (triton::usize id = 0; id < count; id++) {
+          sessions.emplace_back(new(std::nothrow) Z3Session(false));
+          if (sessions.back() == nullptr)
+            throw triton::exceptions::SolverEngine("ParallelSolver::flip(): Not enough memory.");
+          sessions.back()->setTimeout(this->timeout);
+          sessions.back()->setMemoryLimit(this->memoryLimit);
+
+          /* Weaker queries are solved in another session, so the prefix of the worker is kept */
+          if (this->policy != triton::engines::solver::POLICY_FULL) {
+            fallbacks.emplace_back(new(std::nothrow) Z3Session(false));
+            if (fallbacks.back() == nullptr)
+              throw triton::exceptions::SolverEngine("ParallelSolver::flip(): Not enough memory.");
+            fallbacks.back()->setTimeout(this->timeout);
+            fallbacks.back()->setMemoryLimit(this->memoryLimit);
+          }
+        }
+
+        std::atomic<triton::usize> next(0);
+        std::atomic<bool> stop(false);
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::deque<Result> results;
+        triton::usize finished = 0;
+        std::string error;
+
+        auto worker = [&](triton::usize id) {
+          Z3Session& session = *sessions[id];
+          try {
+            for (triton::usize j = next++; j < jobs.size() && !stop; j = next++) {
+              const Job& job = jobs[j];
+              Result result;
+              result.index       = job.index;
+              result.srcAddr     = job.srcAddr;
+              result.dstAddr     = job.dstAddr;
+              result.status      = triton::engines::solver::UNKNOWN;
+              result.solvingTime = 0;
+              result.strategy    = triton::engines::solver::POLICY_FULL;
+
+              session.sync(pcs, stamps, job.index);
+              auto models = session.getModels(job.predicate, 1, &result.status, 0, &result.solvingTime);
+
+              if (models.empty() && job.index > 0 && this->policy != triton::engines::solver::POLICY_FULL) {
+                Z3Session& fallback = *fallbacks[id];
+                triton::uint32 time = 0;
+
+                if (result.status != triton::engines::solver::UNSAT && job.slice.size() < job.index) {
+                  fallback.sync(pcs, stamps, job.slice);
+                  models = fallback.getModels(job.predicate, 1, &result.status, 0, &time);
+                  result.solvingTime += time;
+                  result.strategy = triton::engines::solver::POLICY_NESTED;
+                }
+
+                if (models.empty() && this->policy == triton::engines::solver::POLICY_LAST && !(result.strategy == triton::engines::solver::POLICY_NESTED && job.slice.empty())) {
+                  fallback.sync(pcs, stamps, std::vector<triton::usize>());
+                  models = fallback.getModels(job.predicate, 1, &result.status, 0, &time);
+                  result.solvingTime += time;
+                  result.strategy = triton::engines::solver::POLICY_LAST;
+                }
+              }
+
+              if (!models.empty())
+                result.model = std::move(models.front());
+
+              std::lock_guard<std::mutex> lock(mutex);
+              results.push_back(std::move(result));
+              cond.notify_one();
+            }
+          }
+          catch (const triton::exceptions::Exception& e) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (error.empty())
+              error = e.what();
+            stop = true;
+          }
+          catch (const std::exception& e) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (error.empty())
+              error = e.what();
+            stop = true;
+          }
+          catch (...) {
+            /* An exception escaping a thread would call std::terminate() */
+            std::lock_guard<std::mutex> lock(mutex);
+            if (error.empty())
+              error = "Unknown error.";
+            stop = true;
+          }
+
+          std::lock_guard<std::mutex> lock(mutex);
+          finished++;
+          cond.notify_one();
+        };
+
+        std::vector<std::thread> workers;
+        auto terminate = [&](void) {
+          stop = true;
+          for (auto&& session : sessions)
+            session->interrupt();
+          for (auto&& session : fallbacks)
+            session->interrupt();
+          for (auto&& thread : workers)
+            thread.join();
+        };
+
+        try {
+          for (triton::usize id = 0; id < count; id++)
+            workers.emplace_back(worker, id);
+
+          std::unique_lock<std::mutex> lock(mutex);
+          while (true) {
+            cond.wait(lock, [&](void) { return !results.empty() || finished == workers.size(); });
+            if (results.empty())
+              break;
+
+            Result result = std::move(results.front());
+            results.pop_front();
+
+            /* The callback may take time or throw, workers keep solving meanwhile */
+            lock.unlock();
+            callback(result);
+            lock.lock();
+          }
+        }
+        catch (...) {
+          terminate();
+          throw;
+        }
+
+        for (auto&& thread : workers)
+          thread.join();
+
+        if (!error.empty())
+          throw triton::exceptions::SolverEngine("ParallelSolver::flip(): " + error);
+      }
+
+    };
+  };
+};
@@ -0,0 +1,311 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the Apache License 2.0.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <string>
+
+#include <triton/exceptions.hpp>
+#include <triton/symbolicVariable.hpp>
+#include <triton/z3Session.hpp>
+#include <triton/z3Solver.hpp>
+
+
+
+namespace triton {
+  namespace engines {
+    namespace solver {
+
+      Z3Session::Z3Session(bool cache)
+        : converter(false, cache), solver(converter.getContext()) {
+        this->timeout     = 0;
+        this->memoryLimit = 0;
+      }
+
+
+      void Z3Session::sync(const std::vector<triton::engines::symbolic::PathConstraint>& pcs, const std::vector<triton::usize>& stamps, triton::usize size) {
+        if (size > pcs.size() || pcs.size() != stamps.size())
+          throw triton::exceptions::SolverEngine("Z3Session::sync(): Invalid path constraints.");
+
+        try {
+          /*
+           * Stamps are unique, so if the stamp at an index matches, all the
+           * constraints below also match. Pops scopes until the session is a
+           * prefix of the path, then asserts the missing constraints.
+           */
+          triton::usize common = std::min(this->stamps.size(), size);
+          while (common > 0 && this->stamps[common - 1] != stamps[common - 1])
+            common--;
+
+          if (this->stamps.size() > common) {
+            this->solver.pop(static_cast<triton::uint32>(this->stamps.size() - common));
+            this->stamps.resize(common);
+          }
+
+          for (triton::usize index = common; index < size; index++) {
+            z3::expr expr = this->converter.convert(pcs[index].getTakenPredicate());
+            this->solver.push();
+            this->solver.add(expr);
+            this->stamps.push_back(stamps[index]);
+          }
+        }
+        catch (const z3::exception& e) {
+          /* The solver may be in an unknown state */
+          this->reset();
+          throw triton::exceptions::SolverEngine(std::string("Z3Session::sync(): ") + e.msg());
+        }
+      }
+
+
+      void Z3Session::sync(const std::vector<triton::engines::symbolic::PathConstraint>& pcs, const std::vector<triton::usize>& stamps, const std::vector<triton::usize>& indexes) {
+        if (pcs.size() != stamps.size())
+          throw triton::exceptions::SolverEngine("Z3Session::sync(): Invalid path constraints.");
+
+        for (auto index : indexes) {
+          if (index >= pcs.size())
+            throw triton::exceptions::SolverEngine("Z3Session::sync(): Invalid path constraints.");
+        }
+
+        try {
+          /* Subsets are not prefixes of each other, so the common scopes are searched from the bottom */
+          triton::usize common = 0;
+          while (common < this->stamps.size() && common < indexes.size() && this->stamps[common] == stamps[indexes[common]])
+            common++;
+
+          if (this->stamps.size() > common) {
+            this->solver.pop(static_cast<triton::uint32>(this->stamps.size() - common));
+            this->stamps.resize(common);
+          }
+
+          for (triton::usize i = common; i < indexes.size(); i++) {
+            z3::expr expr = this->converter.convert(pcs[indexes[i]].getTakenPredicate());
+            this->solver.push();
+            this->solver.add(expr);
+            this->stamps.push_back(stamps[indexes[i]]);
+          }
+        }
+        catch (const z3::exception& e) {
+          /* The solver may be in an unknown state */
+          this->reset();
+          throw triton::exceptions::SolverEngine(std::string("Z3Session::sync(): ") + e.msg());
+        }
+      }
+
+
+      std::vector<std::unordered_map<triton::usize, SolverModel>> Z3Session::getModels(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, triton::engines::solver::status_e* status, triton::uint32 timeout, triton::uint32* solvingTime) {
+        std::vector<std::unordered_map<triton::usize, SolverModel>> ret;
+        triton::ast::SharedAbstractNode onode = node;
+
+        if (onode == nullptr)
+          throw triton::exceptions::SolverEngine("Z3Session::getModels(): node cannot be null.");
+
+        /* Z3 does not need an assert() as root node */
+        if (node->getType() == triton::ast::ASSERT_NODE)
+          onode = node->getChildren()[0];
+
+        if (onode->isLogical() == false)
+          throw triton::exceptions::SolverEngine("Z3Session::getModels(): Must be a logical node.");
+
+        z3::context& ctx = this->converter.getContext();
+        bool scope = false;
+
+        try {
+          /* The query and the models already found live in their own scope */
+          z3::expr expr = this->converter.convert(onode);
+          this->solver.push();
+          scope = true;
+          this->solver.add(expr);
+          this->setParameters(timeout);
+
+          /* Get time of solving start */
+          auto start = std::chrono::system_clock::now();
+
+          /* Get first model */
+          z3::check_result res = this->solver.check();
+
+          /* Write back the status code of the first constraint */
+          this->writeBackStatus(res, status);
+
+          /* Check if it is sat */
+          while (res == z3::sat && limit >= 1) {
+            z3::model m = this->solver.get_model();
+
+            /* Traversing the model */
+            std::unordered_map<triton::usize, SolverModel> smodel;
+            z3::expr_vector args(ctx);
+            for (triton::uint32 i = 0; i < m.size(); i++) {
+              z3::func_decl z3Variable = m[i];
+              std::string varName      = z3Variable.name().str();
+              z3::expr exp             = m.get_const_interp(z3Variable);
+
+              /* Map the result */
+              SolverModel trionModel = SolverModel(this->converter.variables[varName], Z3Solver::getNumeral(exp));
+              smodel[trionModel.getId()] = trionModel;
+
+              /* Uniq result */
+              if (exp.get_sort().is_bv())
+                args.push_back(z3Variable() != exp);
+            }
+
+            /* Check that model is available */
+            if (smodel.empty())
+              break;
+
+            /* Push model */
+            ret.push_back(smodel);
+
+            if (--limit) {
+              /* Escape last models */
+              if (!args.empty())
+                this->solver.add(z3::mk_or(args));
+
+              /* Get next model */
+              res = this->solver.check();
+            }
+          }
+
+          /* Get time of solving end */
+          auto end = std::chrono::system_clock::now();
+
+          if (solvingTime)
+            *solvingTime = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+        }
+        catch (const z3::exception& e) {
+          if (scope)
+            this->solver.pop();
+          if (!strcmp(e.msg(), "max. memory exceeded")) {
+            if (status) {
+              *status = triton::engines::solver::OUTOFMEM;
+            }
+            return {};
+          }
+          throw triton::exceptions::SolverEngine(std::string("Z3Session::getModels(): ") + e.msg());
+        }
+
+        this->solver.pop();
+        return ret;
+      }
+
+
+      bool Z3Session::isSat(const triton::ast::SharedAbstractNode& node, triton::engines::solver::status_e* status, triton::uint32 timeout, triton::uint32* solvingTime) {
+        if (node == nullptr)
+          throw triton::exceptions::SolverEngine("Z3Session::isSat(): node cannot be null.");
+
+        if (node->isLogical() == false)
+          throw triton::exceptions::SolverEngine("Z3Session::isSat(): Must be a logical node.");
+
+        bool scope = false;
+
+        try {
+          z3::expr expr = this->converter.convert(node);
+          this->solver.push();
+          scope = true;
+          this->solver.add(expr);
+          this->setParameters(timeout);
+
+          /* Get time of solving start */
+          auto start = std::chrono::system_clock::now();
+
+          z3::check_result res = this->solver.check();
+
+          /* Get time of solving end */
+          auto end = std::chrono::system_clock::now();
+
+          if (solvingTime)
+            *solvingTime = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+          this->writeBackStatus(res, status);
+          this->solver.pop();
+          return res == z3::sat;
+        }
+        catch (const z3::exception& e) {
+          if (scope)
+            this->solver.pop();
+          if (!strcmp(e.msg(), "max. memory exceeded")) {
+            if (status) {
+              *status = triton::engines::solver::OUTOFMEM;
+            }
+            return {};
+          }
+          throw triton::exceptions::SolverEngine(std::string("Z3Session::isSat(): ") + e.msg());
+        }
+      }
+
+
+      void Z3Session::setParameters(triton::uint32 timeout) {
+        z3::params p(this->converter.getContext());
+
+        /* Define the timeout. Parameters are kept by the solver, so the timeout is always set */
+        if (timeout)
+          p.set(":timeout", timeout);
+        else if (this->timeout)
+          p.set(":timeout", this->timeout);
+        else
+          p.set(":timeout", UINT_MAX);
+
+        /* Define memory limit */
+        if (this->memoryLimit)
+          p.set(":max_memory", this->memoryLimit);
+
+        this->solver.set(p);
+      }
+
+
+      void Z3Session::writeBackStatus(z3::check_result res, triton::engines::solver::status_e* status) {
+        if (status != nullptr) {
+          switch (res) {
+            case z3::sat:
+              *status = triton::engines::solver::SAT;
+              break;
+
+            case z3::unsat:
+              *status = triton::engines::solver::UNSAT;
+              break;
+
+            case z3::unknown:
+              if (this->solver.reason_unknown() == "timeout")
+                *status = triton::engines::solver::TIMEOUT;
+              else if (this->solver.reason_unknown() == "max. memory exceeded")
+                *status = triton::engines::solver::OUTOFMEM;
+              else
+                *status = triton::engines::solver::UNKNOWN;
+              break;
+          }
+        }
+      }
+
+
+      triton::usize Z3Session::getNumberOfScopes(void) const {
+        return this->stamps.size();
+      }
+
+
+      void Z3Session::reset(void) {
+        this->solver.reset();
+        this->stamps.clear();
+      }
+
+
+      void Z3Session::interrupt(void) {
+        this->converter.getContext().interrupt();
+      }
+
+
+      void Z3Session::setTimeout(triton::uint32 ms) {
+        this->timeout = ms;
+      }
+
+
+      void Z3Session::setMemoryLimit(triton::uint32 limit) {
+        this->memoryLimit = limit;
+      }
+
+    };
+  };
+};
@@ -40,6 +40,11 @@ namespace triton {
 
 
       std::vector<std::unordered_map<triton::usize, SolverModel>> Z3Solver::getModels(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, triton::engines::solver::status_e* status, triton::uint32 timeout, triton::uint32* solvingTime) const {
+        return this->getModels(node, limit, std::vector<triton::engines::symbolic::SharedSymbolicVariable>(), status, timeout, solvingTime);
+      }
+
+
+      std::vector<std::unordered_map<triton::usize, SolverModel>> Z3Solver::getModels(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, const std::vector<triton::engines::symbolic::SharedSymbolicVariable>& variables, triton::engines::solver::status_e* status, triton::uint32 timeout, triton::uint32* solvingTime) const {
         std::vector<std::unordered_map<triton::usize, SolverModel>> ret;
         triton::ast::SharedAbstractNode onode = node;
         triton::ast::TritonToZ3Ast z3Ast{false};
@@ -62,6 +67,11 @@ namespace triton {
           /* Create a solver and add the expression */
           solver.add(expr);
 
+          /* The constants of the projected variables */
+          z3::expr_vector projection(ctx);
+          for (auto&& var : variables)
+            projection.push_back(ctx.bv_const(var->getName().c_str(), var->getSize()));
+
           z3::params p(ctx);
 
           /* Define the timeout */
@@ -96,7 +106,7 @@ namespace triton {
             /* Traversing the model */
             std::unordered_map<triton::usize, SolverModel> smodel;
             z3::expr_vector args(ctx);
-            for (triton::uint32 i = 0; i < m.size(); i++) {
+            for (triton::uint32 i = 0; i < m.size() && variables.empty(); i++) {
 
               /* Get the z3 variable */
               z3::func_decl z3Variable = m[i];
@@ -107,24 +117,23 @@ namespace triton {
               /* Get z3 expr */
               z3::expr exp = m.get_const_interp(z3Variable);
 
-              /* Get the size of a z3 expr */
-              triton::uint32 bvSize = exp.get_sort().bv_size();
-
-              /* Get the value of a z3 expr */
-              std::string svalue = Z3_get_numeral_string(ctx, exp);
-
-              /* Convert a string value to a integer value */
-              triton::uint512 value = triton::uint512(svalue);
-
               /* Create a triton model */
-              SolverModel trionModel = SolverModel(z3Ast.variables[varName], value);
+              SolverModel trionModel = SolverModel(z3Ast.variables[varName], Z3Solver::getNumeral(exp));
 
               /* Map the result */
               smodel[trionModel.getId()] = trionModel;
 
               /* Uniq result */
               if (exp.get_sort().is_bv())
-                args.push_back(ctx.bv_const(varName.c_str(), bvSize) != ctx.bv_val(svalue.c_str(), bvSize));
+                args.push_back(z3Variable() != exp);
+            }
+
+            /* Only the projected variables are read and blocked, the ones out of the query get a value as well */
+            for (triton::uint32 i = 0; i < projection.size(); i++) {
+              z3::expr exp = m.eval(projection[i], true);
+              SolverModel trionModel = SolverModel(variables[i], Z3Solver::getNumeral(exp));
+              smodel[trionModel.getId()] = trionModel;
+              args.push_back(projection[i] != exp);
             }
 
             /* Check that model is available */
@@ -314,6 +323,16 @@ namespace triton {
       }
 
 
+      triton::uint512 Z3Solver::getNumeral(const z3::expr& value) {
+        triton::uint64 number = 0;
+
+        if (Z3_get_numeral_uint64(value.ctx(), value, &number))
+          return number;
+
+        return triton::uint512(Z3_get_numeral_string(value.ctx(), value));
+      }
+
+
       std::string Z3Solver::getName(void) const {
         return "z3";
       }
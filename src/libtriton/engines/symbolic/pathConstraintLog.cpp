@@ -0,0 +1,512 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the Apache License 2.0.
+*/
+
+#include <tuple>
+#include <utility>
+
+#include <triton/exceptions.hpp>
+#include <triton/pathConstraintLog.hpp>
+#include <triton/symbolicVariable.hpp>
+
+
+
+/*
+ * A record is its size followed by its payload, and integers are written as
+ * LEB128 varints. The payload of a symbolic expression is:
+ *
+ *   'E' id type comment nodes root
+ *
+ * and the payload of a path constraint is:
+ *
+ *   'P' tid nodes count (taken srcAddr dstAddr root)*
+ *
+ * Nodes are a count followed by the nodes in topological order, children
+ * first. A node is its kind followed by its integer (as 64-bit limbs), its
+ * string, the id of its symbolic variable or expression, or the distances
+ * to its children.
+ */
+
+namespace triton {
+  namespace engines {
+    namespace symbolic {
+
+      static void writeVarint(std::string& payload, triton::uint64 value) {
+        do {
+          triton::uint8 byte = value & 0x7f;
+          value >>= 7;
+          payload.push_back(static_cast<char>(value ? (byte | 0x80) : byte));
+        } while (value);
+      }
+
+
+      static triton::uint64 readVarint(const std::string& payload, triton::usize& pos) {
+        triton::uint64 value = 0;
+        for (triton::uint32 shift = 0; shift < 64; shift += 7) {
+          if (pos >= payload.size())
+            throw triton::exceptions::PathManager("PathConstraintLog::read(): Corrupted record.");
+          triton::uint8 byte = static_cast<triton::uint8>(payload[pos++]);
+          value |= static_cast<triton::uint64>(byte & 0x7f) << shift;
+          if ((byte & 0x80) == 0)
+            return value;
+        }
+        throw triton::exceptions::PathManager("PathConstraintLog::read(): Corrupted record.");
+      }
+
+
+      static void writeString(std::string& payload, const std::string& value) {
+        writeVarint(payload, value.size());
+        payload += value;
+      }
+
+
+      static std::string readString(const std::string& payload, triton::usize& pos) {
+        triton::usize size = readVarint(payload, pos);
+        if (size > payload.size() - pos)
+          throw triton::exceptions::PathManager("PathConstraintLog::read(): Corrupted record.");
+        pos += size;
+        return payload.substr(pos - size, size);
+      }
+
+
+      static triton::uint512 getInteger(const triton::ast::SharedAbstractNode& node) {
+        if (node->getType() != triton::ast::INTEGER_NODE)
+          throw triton::exceptions::PathManager("PathConstraintLog::read(): Corrupted record.");
+        return reinterpret_cast<triton::ast::IntegerNode*>(node.get())->getInteger();
+      }
+
+
+      static std::string getString(const triton::ast::SharedAbstractNode& node) {
+        if (node->getType() != triton::ast::STRING_NODE)
+          throw triton::exceptions::PathManager("PathConstraintLog::read(): Corrupted record.");
+        return reinterpret_cast<triton::ast::StringNode*>(node.get())->getString();
+      }
+
+
+      PathConstraintLog::PathConstraintLog(const std::string& path, const triton::ast::SharedAstContext& astCtxt)
+        : astCtxt(astCtxt) {
+        this->file.open(path, std::ios::in | std::ios::out | std::ios::trunc | std::ios::binary);
+        if (!this->file.is_open())
+          throw triton::exceptions::PathManager("PathConstraintLog::PathConstraintLog(): Cannot open " + path + ".");
+      }
+
+
+      triton::uint64 PathConstraintLog::append(const std::string& payload) {
+        std::string size;
+
+        writeVarint(size, payload.size());
+        this->file.seekp(0, std::ios::end);
+        triton::uint64 offset = static_cast<triton::uint64>(this->file.tellp());
+        this->file.write(size.data(), size.size());
+        this->file.write(payload.data(), payload.size());
+
+        if (!this->file.good())
+          throw triton::exceptions::PathManager("PathConstraintLog::write(): Cannot write the record.");
+
+        return offset;
+      }
+
+
+      void PathConstraintLog::load(triton::uint64 offset, std::string& payload) {
+        triton::uint64 size = 0;
+
+        this->file.seekg(offset);
+        for (triton::uint32 shift = 0; shift < 64; shift += 7) {
+          triton::sint32 byte = this->file.get();
+          if (byte == std::char_traits<char>::eof())
+            break;
+          size |= static_cast<triton::uint64>(byte & 0x7f) << shift;
+          if ((byte & 0x80) == 0)
+            break;
+        }
+
+        payload.resize(size);
+        this->file.read(&payload[0], size);
+
+        if (!this->file.good() || size == 0) {
+          this->file.clear();
+          throw triton::exceptions::PathManager("PathConstraintLog::read(): Cannot read the record.");
+        }
+      }
+
+
+      /*
+       * Expressions are written after the expressions they reference, so a
+       * record can always be read back from the records before it. Chains of
+       * references may be very deep, hence the explicit stack.
+       */
+      void PathConstraintLog::writeDefinitions(const std::vector<triton::ast::SharedAbstractNode>& roots) {
+        std::vector<std::pair<SharedSymbolicExpression, bool>> stack;
+
+        auto pushReferences = [&](const std::vector<triton::ast::SharedAbstractNode>& asts) {
+          for (auto&& root : asts) {
+            for (auto&& node : triton::ast::childrenExtraction(root, false, false)) {
+              if (node->getType() != triton::ast::REFERENCE_NODE)
+                continue;
+              const auto& expr = reinterpret_cast<triton::ast::ReferenceNode*>(node.get())->getSymbolicExpression();
+              if (this->definitions.find(expr->getId()) == this->definitions.end())
+                stack.push_back(std::make_pair(expr, false));
+            }
+          }
+        };
+
+        pushReferences(roots);
+        while (!stack.empty()) {
+          SharedSymbolicExpression expr = stack.back().first;
+
+          if (this->definitions.find(expr->getId()) != this->definitions.end()) {
+            stack.pop_back();
+            continue;
+          }
+
+          /* Its references first */
+          if (stack.back().second == false) {
+            stack.back().second = true;
+            pushReferences({expr->getAst()});
+            continue;
+          }
+
+          std::string payload(1, 'E');
+          writeVarint(payload, expr->getId());
+          writeVarint(payload, expr->getType());
+          writeString(payload, expr->getComment());
+          writeVarint(payload, this->writeNodes(payload, {expr->getAst()}).front());
+
+          this->definitions[expr->getId()] = this->append(payload);
+          this->expressions[expr->getId()] = expr;
+          stack.pop_back();
+        }
+      }
+
+
+      std::vector<triton::usize> PathConstraintLog::writeNodes(std::string& payload, const std::vector<triton::ast::SharedAbstractNode>& roots) {
+        std::unordered_map<triton::ast::AbstractNode*, triton::usize> indexes;
+        std::vector<triton::ast::SharedAbstractNode> nodes;
+        std::vector<triton::usize> ret;
+
+        /* The children of a node already seen have been seen too */
+        for (auto&& root : roots) {
+          for (auto&& node : triton::ast::childrenExtraction(root, false, true)) {
+            if (indexes.find(node.get()) != indexes.end())
+              continue;
+            indexes[node.get()] = nodes.size();
+            nodes.push_back(node);
+          }
+          ret.push_back(indexes.at(root.get()));
+        }
+
+        writeVarint(payload, nodes.size());
+        for (triton::usize index = 0; index < nodes.size(); index++) {
+          const auto& node = nodes[index];
+
+          writeVarint(payload, node->getType());
+          switch (node->getType()) {
+            case triton::ast::INTEGER_NODE: {
+              triton::uint512 value = getInteger(node);
+              std::vector<triton::uint64> limbs;
+              for (; value != 0; value >>= 64)
+                limbs.push_back(static_cast<triton::uint64>(value & 0xffffffffffffffff));
+              writeVarint(payload, limbs.size());
+              for (auto limb : limbs)
+                writeVarint(payload, limb);
+              break;
+            }
+
+            case triton::ast::STRING_NODE:
+              writeString(payload, getString(node));
+              break;
+
+            case triton::ast::VARIABLE_NODE: {
+              triton::usize id = reinterpret_cast<triton::ast::VariableNode*>(node.get())->getSymbolicVariable()->getId();
+              this->variables[id] = node;
+              writeVarint(payload, id);
+              break;
+            }
+
+            case triton::ast::REFERENCE_NODE:
+              writeVarint(payload, reinterpret_cast<triton::ast::ReferenceNode*>(node.get())->getSymbolicExpression()->getId());
+              break;
+
+            default:
+              writeVarint(payload, node->getChildren().size());
+              for (auto&& child : node->getChildren())
+                writeVarint(payload, index - indexes.at(child.get()));
+              break;
+          }
+        }
+
+        return ret;
+      }
+
+
+      std::vector<PathConstraintLog::Node> PathConstraintLog::readNodes(const std::string& payload, triton::usize& pos) const {
+        std::vector<Node> nodes(readVarint(payload, pos));
+
+        for (triton::usize index = 0; index < nodes.size(); index++) {
+          Node& node = nodes[index];
+
+          node.kind = static_cast<triton::ast::ast_e>(readVarint(payload, pos));
+          node.id   = 0;
+          switch (node.kind) {
+            case triton::ast::INTEGER_NODE: {
+              triton::usize limbs = readVarint(payload, pos);
+              for (triton::usize i = 0; i < limbs && i < 8; i++)
+                node.value |= triton::uint512(readVarint(payload, pos)) << (64 * i);
+              break;
+            }
+
+            case triton::ast::STRING_NODE:
+              node.string = readString(payload, pos);
+              break;
+
+            case triton::ast::VARIABLE_NODE:
+            case triton::ast::REFERENCE_NODE:
+              node.id = readVarint(payload, pos);
+              break;
+
+            default: {
+              triton::usize count = readVarint(payload, pos);
+              for (triton::usize i = 0; i < count; i++) {
+                triton::usize distance = readVarint(payload, pos);
+                if (distance == 0 || distance > index)
+                  throw triton::exceptions::PathManager("PathConstraintLog::read(): Corrupted record.");
+                node.children.push_back(index - distance);
+              }
+              break;
+            }
+          }
+        }
+
+        return nodes;
+      }
+
+
+      /*
+       * Expressions still alive are shared, the others are read back from
+       * their records, after the expressions they reference.
+       */
+      void PathConstraintLog::resolve(const std::vector<Node>& nodes, std::unordered_map<triton::usize, SharedSymbolicExpression>& resolved) {
+        struct Definition {
+          std::vector<Node> nodes;
+          triton::engines::symbolic::expression_e type;
+          std::string comment;
+          triton::usize root;
+        };
+
+        std::unordered_map<triton::usize, Definition> pending;
+        std::vector<triton::usize> stack;
+
+        auto pushReferences = [&](const std::vector<Node>& references) {
+          for (auto&& node : references) {
+            if (node.kind == triton::ast::REFERENCE_NODE && resolved.find(node.id) == resolved.end())
+              stack.push_back(node.id);
+          }
+        };
+
+        pushReferences(nodes);
+        while (!stack.empty()) {
+          triton::usize id = stack.back();
+
+          if (resolved.find(id) != resolved.end()) {
+            stack.pop_back();
+            continue;
+          }
+
+          auto alive = this->expressions.find(id);
+          if (alive != this->expressions.end()) {
+            if (auto expr = alive->second.lock()) {
+              resolved[id] = expr;
+              stack.pop_back();
+              continue;
+            }
+          }
+
+          auto it = pending.find(id);
+          if (it == pending.end()) {
+            auto offset = this->definitions.find(id);
+            if (offset == this->definitions.end())
+              throw triton::exceptions::PathManager("PathConstraintLog::read(): Unknown symbolic expression.");
+
+            std::string payload;
+            triton::usize pos = 0;
+            this->load(offset->second, payload);
+            if (payload[pos++] != 'E' || readVarint(payload, pos) != id)
+              throw triton::exceptions::PathManager("PathConstraintLog::read(): Corrupted record.");
+
+            Definition& def = pending[id];
+            def.type    = static_cast<triton::engines::symbolic::expression_e>(readVarint(payload, pos));
+            def.comment = readString(payload, pos);
+            def.nodes   = this->readNodes(payload, pos);
+            def.root    = readVarint(payload, pos);
+            if (def.root >= def.nodes.size())
+              throw triton::exceptions::PathManager("PathConstraintLog::read(): Corrupted record.");
+
+            /* Its references first */
+            pushReferences(def.nodes);
+            continue;
+          }
+
+          auto asts = this->buildNodes(it->second.nodes, resolved);
+          auto expr = std::make_shared<SymbolicExpression>(asts[it->second.root], id, it->second.type, it->second.comment);
+          resolved[id] = expr;
+          this->expressions[id] = expr;
+          pending.erase(it);
+          stack.pop_back();
+        }
+      }
+
+
+      std::vector<triton::ast::SharedAbstractNode> PathConstraintLog::buildNodes(const std::vector<Node>& nodes, const std::unordered_map<triton::usize, SharedSymbolicExpression>& resolved) const {
+        std::vector<triton::ast::SharedAbstractNode> asts;
+
+        for (auto&& node : nodes) {
+          std::vector<triton::ast::SharedAbstractNode> c;
+          for (auto index : node.children)
+            c.push_back(asts[index]);
+
+          /* Only the children used here are checked, init() checks the others */
+          auto arity = [&](triton::usize size) {
+            if (c.size() < size)
+              throw triton::exceptions::PathManager("PathConstraintLog::read(): Corrupted record.");
+          };
+
+          switch (node.kind) {
+            case triton::ast::INTEGER_NODE:   asts.push_back(this->astCtxt->integer(node.value)); break;
+            case triton::ast::STRING_NODE:    asts.push_back(this->astCtxt->string(node.string)); break;
+
+            case triton::ast::VARIABLE_NODE: {
+              auto var = this->variables.find(node.id);
+              if (var == this->variables.end())
+                throw triton::exceptions::PathManager("PathConstraintLog::read(): Unknown symbolic variable.");
+              asts.push_back(var->second);
+              break;
+            }
+
+            case triton::ast::REFERENCE_NODE: asts.push_back(this->astCtxt->reference(resolved.at(node.id))); break;
+
+            case triton::ast::ASSERT_NODE:    arity(1); asts.push_back(this->astCtxt->assert_(c[0])); break;
+            case triton::ast::BVNEG_NODE:     arity(1); asts.push_back(this->astCtxt->bvneg(c[0])); break;
+            case triton::ast::BVNOT_NODE:     arity(1); asts.push_back(this->astCtxt->bvnot(c[0])); break;
+            case triton::ast::DECLARE_NODE:   arity(1); asts.push_back(this->astCtxt->declare(c[0])); break;
+            case triton::ast::LNOT_NODE:      arity(1); asts.push_back(this->astCtxt->lnot(c[0])); break;
+
+            case triton::ast::BVADD_NODE:     arity(2); asts.push_back(this->astCtxt->bvadd(c[0], c[1])); break;
+            case triton::ast::BVAND_NODE:     arity(2); asts.push_back(this->astCtxt->bvand(c[0], c[1])); break;
+            case triton::ast::BVASHR_NODE:    arity(2); asts.push_back(this->astCtxt->bvashr(c[0], c[1])); break;
+            case triton::ast::BVLSHR_NODE:    arity(2); asts.push_back(this->astCtxt->bvlshr(c[0], c[1])); break;
+            case triton::ast::BVMUL_NODE:     arity(2); asts.push_back(this->astCtxt->bvmul(c[0], c[1])); break;
+            case triton::ast::BVNAND_NODE:    arity(2); asts.push_back(this->astCtxt->bvnand(c[0], c[1])); break;
+            case triton::ast::BVNOR_NODE:     arity(2); asts.push_back(this->astCtxt->bvnor(c[0], c[1])); break;
+            case triton::ast::BVOR_NODE:      arity(2); asts.push_back(this->astCtxt->bvor(c[0], c[1])); break;
+            case triton::ast::BVSDIV_NODE:    arity(2); asts.push_back(this->astCtxt->bvsdiv(c[0], c[1])); break;
+            case triton::ast::BVSGE_NODE:     arity(2); asts.push_back(this->astCtxt->bvsge(c[0], c[1])); break;
+            case triton::ast::BVSGT_NODE:     arity(2); asts.push_back(this->astCtxt->bvsgt(c[0], c[1])); break;
+            case triton::ast::BVSHL_NODE:     arity(2); asts.push_back(this->astCtxt->bvshl(c[0], c[1])); break;
+            case triton::ast::BVSLE_NODE:     arity(2); asts.push_back(this->astCtxt->bvsle(c[0], c[1])); break;
+            case triton::ast::BVSLT_NODE:     arity(2); asts.push_back(this->astCtxt->bvslt(c[0], c[1])); break;
+            case triton::ast::BVSMOD_NODE:    arity(2); asts.push_back(this->astCtxt->bvsmod(c[0], c[1])); break;
+            case triton::ast::BVSREM_NODE:    arity(2); asts.push_back(this->astCtxt->bvsrem(c[0], c[1])); break;
+            case triton::ast::BVSUB_NODE:     arity(2); asts.push_back(this->astCtxt->bvsub(c[0], c[1])); break;
+            case triton::ast::BVUDIV_NODE:    arity(2); asts.push_back(this->astCtxt->bvudiv(c[0], c[1])); break;
+            case triton::ast::BVUGE_NODE:     arity(2); asts.push_back(this->astCtxt->bvuge(c[0], c[1])); break;
+            case triton::ast::BVUGT_NODE:     arity(2); asts.push_back(this->astCtxt->bvugt(c[0], c[1])); break;
+            case triton::ast::BVULE_NODE:     arity(2); asts.push_back(this->astCtxt->bvule(c[0], c[1])); break;
+            case triton::ast::BVULT_NODE:     arity(2); asts.push_back(this->astCtxt->bvult(c[0], c[1])); break;
+            case triton::ast::BVUREM_NODE:    arity(2); asts.push_back(this->astCtxt->bvurem(c[0], c[1])); break;
+            case triton::ast::BVXNOR_NODE:    arity(2); asts.push_back(this->astCtxt->bvxnor(c[0], c[1])); break;
+            case triton::ast::BVXOR_NODE:     arity(2); asts.push_back(this->astCtxt->bvxor(c[0], c[1])); break;
+            case triton::ast::DISTINCT_NODE:  arity(2); asts.push_back(this->astCtxt->distinct(c[0], c[1])); break;
+            case triton::ast::EQUAL_NODE:     arity(2); asts.push_back(this->astCtxt->equal(c[0], c[1])); break;
+            case triton::ast::IFF_NODE:       arity(2); asts.push_back(this->astCtxt->iff(c[0], c[1])); break;
+
+            case triton::ast::BV_NODE:        arity(2); asts.push_back(this->astCtxt->bv(getInteger(c[0]), getInteger(c[1]).convert_to<triton::uint32>())); break;
+            case triton::ast::BVROL_NODE:     arity(2); asts.push_back(this->astCtxt->bvrol(c[0], getInteger(c[1]).convert_to<triton::uint32>())); break;
+            case triton::ast::BVROR_NODE:     arity(2); asts.push_back(this->astCtxt->bvror(c[0], getInteger(c[1]).convert_to<triton::uint32>())); break;
+            case triton::ast::SX_NODE:        arity(2); asts.push_back(this->astCtxt->sx(getInteger(c[0]).convert_to<triton::uint32>(), c[1])); break;
+            case triton::ast::ZX_NODE:        arity(2); asts.push_back(this->astCtxt->zx(getInteger(c[0]).convert_to<triton::uint32>(), c[1])); break;
+
+            case triton::ast::EXTRACT_NODE:   arity(3); asts.push_back(this->astCtxt->extract(getInteger(c[0]).convert_to<triton::uint32>(), getInteger(c[1]).convert_to<triton::uint32>(), c[2])); break;
+            case triton::ast::ITE_NODE:       arity(3); asts.push_back(this->astCtxt->ite(c[0], c[1], c[2])); break;
+            case triton::ast::LET_NODE:       arity(3); asts.push_back(this->astCtxt->let(getString(c[0]), c[1], c[2])); break;
+
+            case triton::ast::COMPOUND_NODE:  arity(1); asts.push_back(this->astCtxt->compound(c)); break;
+            case triton::ast::CONCAT_NODE:    arity(2); asts.push_back(this->astCtxt->concat(c)); break;
+            case triton::ast::LAND_NODE:      arity(2); asts.push_back(this->astCtxt->land(c)); break;
+            case triton::ast::LOR_NODE:       arity(2); asts.push_back(this->astCtxt->lor(c)); break;
+            case triton::ast::LXOR_NODE:      arity(2); asts.push_back(this->astCtxt->lxor(c)); break;
+
+            case triton::ast::FORALL_NODE: {
+              arity(2);
+              std::vector<triton::ast::SharedAbstractNode> vars(c.begin(), c.end() - 1);
+              asts.push_back(this->astCtxt->forall(vars, c.back()));
+              break;
+            }
+
+            default:
+              throw triton::exceptions::PathManager("PathConstraintLog::read(): Corrupted record.");
+          }
+        }
+
+        return asts;
+      }
+
+
+      triton::uint64 PathConstraintLog::write(const triton::engines::symbolic::PathConstraint& pco) {
+        std::vector<triton::ast::SharedAbstractNode> roots;
+
+        for (auto&& branch : pco.getBranchConstraints())
+          roots.push_back(std::get<3>(branch));
+
+        this->writeDefinitions(roots);
+
+        std::string payload(1, 'P');
+        writeVarint(payload, pco.getThreadId());
+        auto indexes = this->writeNodes(payload, roots);
+        writeVarint(payload, roots.size());
+        for (triton::usize index = 0; index < roots.size(); index++) {
+          const auto& branch = pco.getBranchConstraints()[index];
+          writeVarint(payload, std::get<0>(branch));
+          writeVarint(payload, std::get<1>(branch));
+          writeVarint(payload, std::get<2>(branch));
+          writeVarint(payload, indexes[index]);
+        }
+
+        return this->append(payload);
+      }
+
+
+      triton::engines::symbolic::PathConstraint PathConstraintLog::read(triton::uint64 offset) {
+        std::unordered_map<triton::usize, SharedSymbolicExpression> resolved;
+        triton::engines::symbolic::PathConstraint pco;
+        std::string payload;
+        triton::usize pos = 0;
+
+        this->load(offset, payload);
+        if (payload[pos++] != 'P')
+          throw triton::exceptions::PathManager("PathConstraintLog::read(): Corrupted record.");
+
+        pco.setThreadId(static_cast<triton::uint32>(readVarint(payload, pos)));
+        auto nodes = this->readNodes(payload, pos);
+        this->resolve(nodes, resolved);
+        auto asts = this->buildNodes(nodes, resolved);
+
+        triton::usize count = readVarint(payload, pos);
+        for (triton::usize index = 0; index < count; index++) {
+          bool taken         = readVarint(payload, pos);
+          triton::uint64 src = readVarint(payload, pos);
+          triton::uint64 dst = readVarint(payload, pos);
+          triton::usize root = readVarint(payload, pos);
+          if (root >= asts.size())
+            throw triton::exceptions::PathManager("PathConstraintLog::read(): Corrupted record.");
+          pco.addBranchConstraint(taken, src, dst, asts[root]);
+        }
+
+        return pco;
+      }
+
+    }; /* symbolic namespace */
+  }; /* engines namespace */
+}; /*triton namespace */
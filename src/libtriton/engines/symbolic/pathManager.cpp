@@ -5,10 +5,15 @@
 **  This program is under the terms of the Apache License 2.0.
 */
 
+#include <algorithm>
+#include <atomic>
+#include <tuple>
+
 #include <triton/astContext.hpp>
 #include <triton/exceptions.hpp>
 #include <triton/pathManager.hpp>
 #include <triton/symbolicEnums.hpp>
+#include <triton/symbolicVariable.hpp>
 
 
 
@@ -18,19 +23,43 @@ namespace triton {
 
       PathManager::PathManager(const triton::modes::SharedModes& modes, const triton::ast::SharedAstContext& astCtxt)
         : modes(modes), astCtxt(astCtxt) {
+        this->maxPathConstraintsPerSite = 0;
+        this->pathConstraintWindow      = 0;
       }
 
 
+      /*
+       * A copy shares the log of the original to read back the path
+       * constraints logged before the copy, but does not append to it, so
+       * the log only holds the records of the original. Its window is 0,
+       * so the log is read-only until setPathConstraintLog() is called.
+       */
       PathManager::PathManager(const PathManager& other)
         : modes(other.modes), astCtxt(other.astCtxt) {
-        this->pathConstraints = other.pathConstraints;
+        this->pathConstraints           = other.pathConstraints;
+        this->pathConstraintStamps      = other.pathConstraintStamps;
+        this->pathConstraintVariables   = other.pathConstraintVariables;
+        this->pathPredicateChunks       = other.pathPredicateChunks;
+        this->pathConstraintSites       = other.pathConstraintSites;
+        this->maxPathConstraintsPerSite = other.maxPathConstraintsPerSite;
+        this->pathConstraintLog         = other.pathConstraintLog;
+        this->pathConstraintWindow      = 0;
+        this->loggedPathConstraints     = other.loggedPathConstraints;
       }
 
 
       PathManager& PathManager::operator=(const PathManager& other) {
-        this->astCtxt         = other.astCtxt;
-        this->modes           = other.modes;
-        this->pathConstraints = other.pathConstraints;
+        this->astCtxt              = other.astCtxt;
+        this->modes                = other.modes;
+        this->pathConstraints           = other.pathConstraints;
+        this->pathConstraintStamps      = other.pathConstraintStamps;
+        this->pathConstraintVariables   = other.pathConstraintVariables;
+        this->pathPredicateChunks       = other.pathPredicateChunks;
+        this->pathConstraintSites       = other.pathConstraintSites;
+        this->maxPathConstraintsPerSite = other.maxPathConstraintsPerSite;
+        this->pathConstraintLog         = other.pathConstraintLog;
+        this->pathConstraintWindow      = 0;
+        this->loggedPathConstraints     = other.loggedPathConstraints;
         return *this;
       }
 
@@ -40,12 +69,36 @@ namespace triton {
       }
 
 
+      triton::usize PathManager::getSizeOfLoggedPathConstraints(void) const {
+        return this->loggedPathConstraints.size();
+      }
+
+
+      std::vector<triton::engines::symbolic::PathConstraint> PathManager::getLoggedPathConstraints(triton::usize start, triton::usize end) const {
+        std::vector<triton::engines::symbolic::PathConstraint> ret;
+
+        if (start > end || end > this->loggedPathConstraints.size())
+          throw triton::exceptions::PathManager("PathManager::getLoggedPathConstraints(): Invalid items extraction.");
+
+        for (triton::usize index = start; index < end; index++)
+          ret.push_back(this->pathConstraintLog->read(this->loggedPathConstraints[index]));
+
+        return ret;
+      }
+
+
       /* Returns the logical conjunction vector of path constraint */
       const std::vector<triton::engines::symbolic::PathConstraint>& PathManager::getPathConstraints(void) const {
         return this->pathConstraints;
       }
 
 
+      /* Returns the stamp of each path constraint */
+      const std::vector<triton::usize>& PathManager::getPathConstraintStamps(void) const {
+        return this->pathConstraintStamps;
+      }
+
+
       /* Returns the logical conjunction vector of path constraint of a given thread */
       std::vector<triton::engines::symbolic::PathConstraint> PathManager::getPathConstraintsOfThread(triton::uint32 threadId) const {
         std::vector<triton::engines::symbolic::PathConstraint> ret;
@@ -86,49 +139,164 @@ namespace triton {
 
       /* Returns the current path predicate as an AST of logical conjunction of each taken branch. */
       triton::ast::SharedAbstractNode PathManager::getPathPredicate(void) const {
-        std::vector<triton::engines::symbolic::PathConstraint>::const_iterator it;
+        return this->getPathPredicate(this->pathConstraints.size());
+      }
+
+
+      /*
+       * The predicate is a flat conjunction of the largest chunks covering the
+       * prefix, followed by the remaining path constraints. Chunks are shared
+       * by all the prefixes, so a prefix only costs a few dozen operands and
+       * its AST stays shallow however long the path is.
+       */
+      triton::ast::SharedAbstractNode PathManager::getPathPredicate(triton::usize prefix) const {
+        std::vector<triton::ast::SharedAbstractNode> operands;
+        std::vector<triton::usize> sizes;
+        triton::usize pos = 0;
+
+        prefix = std::min(prefix, this->pathConstraints.size());
 
         /* by default PC is T (top) */
-        auto node = this->astCtxt->equal(
-                      this->astCtxt->bvtrue(),
-                      this->astCtxt->bvtrue()
-                    );
-
-        /* Then, we create a conjunction of path constraint */
-        for (it = this->pathConstraints.begin(); it != this->pathConstraints.end(); it++) {
-          node = this->astCtxt->land(node, it->getTakenPredicate());
+        operands.push_back(this->astCtxt->equal(this->astCtxt->bvtrue(), this->astCtxt->bvtrue()));
+        if (prefix == 0)
+          return operands.front();
+
+        for (triton::usize size = 64; size <= prefix; size *= 64)
+          sizes.push_back(size);
+
+        for (triton::usize level = sizes.size(); level-- > 0;) {
+          for (; pos + sizes[level] <= prefix; pos += sizes[level])
+            operands.push_back(this->getPathPredicateChunk(level, pos / sizes[level]));
+        }
+
+        for (; pos < prefix; pos++)
+          operands.push_back(this->pathConstraints[pos].getTakenPredicate());
+
+        return this->astCtxt->land(operands);
+      }
+
+
+      triton::ast::SharedAbstractNode PathManager::getPathPredicateChunk(triton::usize level, triton::usize index) const {
+        std::vector<triton::ast::SharedAbstractNode> operands;
+
+        if (this->pathPredicateChunks.size() <= level)
+          this->pathPredicateChunks.resize(level + 1);
+
+        if (index < this->pathPredicateChunks[level].size() && this->pathPredicateChunks[level][index] != nullptr)
+          return this->pathPredicateChunks[level][index];
+
+        for (triton::usize i = index * 64; i < (index + 1) * 64; i++) {
+          if (level == 0)
+            operands.push_back(this->pathConstraints[i].getTakenPredicate());
+          else
+            operands.push_back(this->getPathPredicateChunk(level - 1, i));
         }
 
+        auto node = this->astCtxt->land(operands);
+        if (this->pathPredicateChunks[level].size() <= index)
+          this->pathPredicateChunks[level].resize(index + 1);
+        this->pathPredicateChunks[level][index] = node;
+
         return node;
       }
 
 
 
+      const std::vector<triton::usize>& PathManager::getVariablesOfPathConstraint(triton::usize index) const {
+        triton::usize stamp = this->pathConstraintStamps[index];
+
+        auto it = this->pathConstraintVariables.find(stamp);
+        if (it != this->pathConstraintVariables.end())
+          return it->second;
+
+        std::vector<triton::usize> ids;
+        for (auto&& n : triton::ast::search(this->pathConstraints[index].getTakenPredicate(), triton::ast::VARIABLE_NODE))
+          ids.push_back(reinterpret_cast<triton::ast::VariableNode*>(n.get())->getSymbolicVariable()->getId());
+
+        return this->pathConstraintVariables[stamp] = std::move(ids);
+      }
+
+
+      /*
+       * Path constraints are partitioned into independent clusters with an
+       * union-find over their symbolic variables. Only the constraints of the
+       * cluster of the node are kept, the other variables keep their concrete
+       * values.
+       */
+      triton::ast::SharedAbstractNode PathManager::getPathPredicateSlice(const triton::ast::SharedAbstractNode& node, triton::usize prefix) const {
+        std::unordered_map<triton::usize, triton::usize> parent;
+        std::vector<triton::ast::SharedAbstractNode> slice;
+
+        if (node == nullptr || node->isLogical() == false)
+          throw triton::exceptions::PathManager("PathManager::getPathPredicateSlice(): The node must be a logical node.");
+
+        auto find = [&parent](triton::usize var) -> triton::usize {
+          auto it = parent.find(var);
+          if (it == parent.end()) {
+            parent[var] = var;
+            return var;
+          }
+          while (parent[var] != var) {
+            parent[var] = parent[parent[var]];
+            var = parent[var];
+          }
+          return var;
+        };
+
+        auto unite = [&find, &parent](const std::vector<triton::usize>& vars) {
+          for (triton::usize i = 1; i < vars.size(); i++)
+            parent[find(vars[i])] = find(vars[0]);
+        };
+
+        prefix = std::min(prefix, this->pathConstraints.size());
+        for (triton::usize index = 0; index < prefix; index++)
+          unite(this->getVariablesOfPathConstraint(index));
+
+        std::vector<triton::usize> vars;
+        for (auto&& n : triton::ast::search(node, triton::ast::VARIABLE_NODE))
+          vars.push_back(reinterpret_cast<triton::ast::VariableNode*>(n.get())->getSymbolicVariable()->getId());
+
+        /* A node without symbolic variable does not depend on the path */
+        if (vars.empty())
+          return node;
+
+        unite(vars);
+        triton::usize root = find(vars[0]);
+        for (triton::usize index = 0; index < prefix; index++) {
+          const auto& pcvars = this->getVariablesOfPathConstraint(index);
+          if (!pcvars.empty() && find(pcvars[0]) == root)
+            slice.push_back(this->pathConstraints[index].getTakenPredicate());
+        }
+
+        slice.push_back(node);
+        if (slice.size() == 1)
+          return node;
+
+        return this->astCtxt->land(slice);
+      }
+
+
       std::vector<triton::ast::SharedAbstractNode> PathManager::getPredicatesToReachAddress(triton::uint64 addr) const {
         std::vector<triton::ast::SharedAbstractNode> predicates;
 
-        /* by default PC is T (top) */
-        auto node = this->astCtxt->equal(
-                      this->astCtxt->bvtrue(),
-                      this->astCtxt->bvtrue()
-                    );
-
         /* Go through all path constraints */
-        for (auto pc = this->pathConstraints.begin(); pc != this->pathConstraints.end(); pc++) {
-          auto branches = pc->getBranchConstraints();
+        for (triton::usize index = 0; index < this->pathConstraints.size(); index++) {
+          const auto& branches = this->pathConstraints[index].getBranchConstraints();
+          triton::ast::SharedAbstractNode node = nullptr;
           bool isMultib = (branches.size() >= 2);
 
           /* Check if one of the branch constraint may reach the targeted address */
           for (auto branch = branches.begin(); branch != branches.end(); branch++) {
             /* if source branch == target, add the current path predicate */
             if (std::get<1>(*branch) == addr) {
-              predicates.push_back(node);
+              predicates.push_back(node = node ? node : this->getPathPredicate(index));
             }
             /*
              * if dst branch == target, do the conjunction of the current
              * path predicate and the branch constraint.
              */
             if (std::get<2>(*branch) == addr) {
+              node = node ? node : this->getPathPredicate(index);
               predicates.push_back(this->astCtxt->land(node, std::get<3>(*branch)));
             }
             /*
@@ -138,13 +306,11 @@ namespace triton {
             if (isMultib == false && std::get<1>(*branch) != 0 && std::get<2>(*branch) != 0) {
               if (std::get<3>(*branch)->getType() == triton::ast::EQUAL_NODE) {
                 auto ip = std::get<3>(*branch)->getChildren()[0];
+                node = node ? node : this->getPathPredicate(index);
                 predicates.push_back(this->astCtxt->land(node, this->astCtxt->equal(ip, this->astCtxt->bv(addr, ip->getBitvectorSize()))));
               }
             }
           } /* branch constraints */
-
-          /* Continue to create the conjunction of the current path predicate */
-          node = this->astCtxt->land(node, pc->getTakenPredicate());
         } /* path constraint */
 
         return predicates;
@@ -213,7 +379,7 @@ namespace triton {
             bb2pc           /* expr which must be true to take the branch */
           );
 
-          this->pathConstraints.push_back(pco);
+          this->addPathConstraint(srcAddr, pco);
         }
 
         /* Direct branch */
@@ -225,7 +391,7 @@ namespace triton {
             /* expr which must be true to take the branch */
             this->astCtxt->equal(pc, this->astCtxt->bv(dstAddr, size))
           );
-          this->pathConstraints.push_back(pco);
+          this->addPathConstraint(srcAddr, pco);
         }
       }
 
@@ -248,26 +414,163 @@ namespace triton {
           node  /* expr which must be true to take the branch */
         );
 
-        this->pathConstraints.push_back(pco);
+        this->addPathConstraint(pco);
       }
 
 
       /* Pushes constraint to the current path predicate. */
       void PathManager::pushPathConstraint(const triton::engines::symbolic::PathConstraint& pco) {
+        this->addPathConstraint(pco);
+      }
+
+
+      /*
+       * Stamps are given by a global counter, so a stamp is never reused even
+       * after a pop or by another path manager. A solver session mirroring the
+       * path predicate compares stamps to know which constraints it still holds.
+       */
+      void PathManager::addPathConstraint(const triton::engines::symbolic::PathConstraint& pco) {
+        static std::atomic<triton::usize> stamp(0);
         this->pathConstraints.push_back(pco);
+        this->pathConstraintStamps.push_back(++stamp);
+        this->logPathConstraints();
+      }
+
+
+      /*
+       * Path constraints are moved by batches of `window`, so the cost of
+       * erasing them from the front is amortized. Their ASTs are released
+       * unless they are still referenced elsewhere.
+       */
+      void PathManager::logPathConstraints(void) {
+        if (this->pathConstraintLog == nullptr || this->pathConstraintWindow == 0 || this->pathConstraints.size() < 2 * this->pathConstraintWindow)
+          return;
+
+        triton::usize count = this->pathConstraints.size() - this->pathConstraintWindow;
+        for (triton::usize index = 0; index < count; index++) {
+          const auto& pco = this->pathConstraints[index];
+
+          this->loggedPathConstraints.push_back(this->pathConstraintLog->write(pco));
+          this->pathConstraintVariables.erase(this->pathConstraintStamps[index]);
+
+          /* Its branch site keeps counting it, but no longer holds its predicate */
+          if (pco.getBranchConstraints().empty())
+            continue;
+          auto site = this->pathConstraintSites.find(std::get<1>(pco.getBranchConstraints().front()));
+          if (site != this->pathConstraintSites.end()) {
+            auto predicate = pco.getTakenPredicate();
+            auto range     = site->second.predicates.equal_range(predicate->getHash());
+            for (auto it = range.first; it != range.second; it++) {
+              if (it->second == predicate) {
+                site->second.predicates.erase(it);
+                break;
+              }
+            }
+          }
+        }
+
+        this->pathConstraints.erase(this->pathConstraints.begin(), this->pathConstraints.begin() + count);
+        this->pathConstraintStamps.erase(this->pathConstraintStamps.begin(), this->pathConstraintStamps.begin() + count);
+        this->pathPredicateChunks.clear();
+      }
+
+
+      /*
+       * Loops push a path constraint at each iteration of their branches. With
+       * PC_DEDUPLICATION, a constraint whose taken predicate is structurally
+       * identical to one already pushed by the same branch is dropped, as it
+       * adds nothing to the path predicate. The number of constraints of a
+       * branch may also be capped, which weakens the path predicate but bounds
+       * its size.
+       */
+      void PathManager::addPathConstraint(triton::uint64 srcAddr, const triton::engines::symbolic::PathConstraint& pco) {
+        auto& site     = this->pathConstraintSites[srcAddr];
+        auto predicate = pco.getTakenPredicate();
+        auto hash      = predicate->getHash();
+
+        if (this->maxPathConstraintsPerSite && site.stamps.size() >= this->maxPathConstraintsPerSite)
+          return;
+
+        if (this->modes->isModeEnabled(triton::modes::PC_DEDUPLICATION)) {
+          auto range = site.predicates.equal_range(hash);
+          for (auto it = range.first; it != range.second; it++) {
+            if (predicate->getContext()->isStructurallyIdentical(it->second, predicate))
+              return;
+          }
+        }
+
+        this->addPathConstraint(pco);
+        site.stamps.push_back(this->pathConstraintStamps.back());
+        site.predicates.emplace(hash, predicate);
       }
 
 
       /* Pops the last constraints added to the path predicate. */
       void PathManager::popPathConstraint(void) {
-        if (this->pathConstraints.size())
+        if (this->pathConstraints.size()) {
+          const auto& pco = this->pathConstraints.back();
+
+          /* Forget it in its branch site */
+          auto site = this->pathConstraintSites.end();
+          if (!pco.getBranchConstraints().empty())
+            site = this->pathConstraintSites.find(std::get<1>(pco.getBranchConstraints().front()));
+          if (site != this->pathConstraintSites.end() && !site->second.stamps.empty() && site->second.stamps.back() == this->pathConstraintStamps.back()) {
+            auto predicate = pco.getTakenPredicate();
+            auto range     = site->second.predicates.equal_range(predicate->getHash());
+            for (auto it = range.first; it != range.second; it++) {
+              if (it->second == predicate) {
+                site->second.predicates.erase(it);
+                break;
+              }
+            }
+            site->second.stamps.pop_back();
+          }
+
+          /* The chunks covering the last path constraint are no longer complete */
+          triton::usize last = this->pathConstraints.size() - 1;
+          triton::usize size = 64;
+          for (auto&& chunks : this->pathPredicateChunks) {
+            chunks.resize(std::min(chunks.size(), last / size));
+            size *= 64;
+          }
+          this->pathConstraintVariables.erase(this->pathConstraintStamps.back());
           this->pathConstraints.pop_back();
+          this->pathConstraintStamps.pop_back();
+        }
       }
 
 
       /* Clears the current path predicate. */
       void PathManager::clearPathConstraints(void) {
         this->pathConstraints.clear();
+        this->pathConstraintStamps.clear();
+        this->pathConstraintVariables.clear();
+        this->pathPredicateChunks.clear();
+        this->pathConstraintSites.clear();
+        this->loggedPathConstraints.clear();
+      }
+
+
+      void PathManager::setMaxPathConstraintsPerSite(triton::usize limit) {
+        this->maxPathConstraintsPerSite = limit;
+      }
+
+
+      void PathManager::setPathConstraintLog(const std::string& path, triton::usize window) {
+        this->loggedPathConstraints.clear();
+
+        if (path.empty()) {
+          this->pathConstraintLog    = nullptr;
+          this->pathConstraintWindow = 0;
+          return;
+        }
+
+        if (window == 0)
+          throw triton::exceptions::PathManager("PathManager::setPathConstraintLog(): The window cannot be empty.");
+
+        this->pathConstraintLog    = std::make_shared<PathConstraintLog>(path, this->astCtxt);
+        this->pathConstraintWindow = window;
+        this->logPathConstraints();
       }
 
     }; /* symbolic namespace */
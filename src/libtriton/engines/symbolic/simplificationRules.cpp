@@ -0,0 +1,804 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the Apache License 2.0.
+*/
+
+#include <cctype>
+#include <unordered_map>
+
+#include <triton/astContext.hpp>
+#include <triton/exceptions.hpp>
+#include <triton/simplificationRules.hpp>
+
+
+
+namespace triton {
+  namespace engines {
+    namespace symbolic {
+
+      /* Returns true if the operands of the operator can be swapped */
+      static bool isCommutative(triton::ast::ast_e type) {
+        switch (type) {
+          case triton::ast::BVADD_NODE:
+          case triton::ast::BVAND_NODE:
+          case triton::ast::BVMUL_NODE:
+          case triton::ast::BVNAND_NODE:
+          case triton::ast::BVNOR_NODE:
+          case triton::ast::BVOR_NODE:
+          case triton::ast::BVXNOR_NODE:
+          case triton::ast::BVXOR_NODE:
+          case triton::ast::DISTINCT_NODE:
+          case triton::ast::EQUAL_NODE:
+          case triton::ast::LAND_NODE:
+          case triton::ast::LOR_NODE:
+          case triton::ast::LXOR_NODE:
+            return true;
+          default:
+            return false;
+        }
+      }
+
+
+      /* Returns true if the operator compares two operands of the same size */
+      static bool isComparison(triton::ast::ast_e type) {
+        switch (type) {
+          case triton::ast::BVSGE_NODE:
+          case triton::ast::BVSGT_NODE:
+          case triton::ast::BVSLE_NODE:
+          case triton::ast::BVSLT_NODE:
+          case triton::ast::BVUGE_NODE:
+          case triton::ast::BVUGT_NODE:
+          case triton::ast::BVULE_NODE:
+          case triton::ast::BVULT_NODE:
+          case triton::ast::DISTINCT_NODE:
+          case triton::ast::EQUAL_NODE:
+            return true;
+          default:
+            return false;
+        }
+      }
+
+
+      /* Returns true if the index-th operand has the size of the node */
+      static bool isSameSizeOperand(triton::ast::ast_e type, triton::usize index) {
+        switch (type) {
+          case triton::ast::BVADD_NODE:
+          case triton::ast::BVAND_NODE:
+          case triton::ast::BVASHR_NODE:
+          case triton::ast::BVLSHR_NODE:
+          case triton::ast::BVMUL_NODE:
+          case triton::ast::BVNAND_NODE:
+          case triton::ast::BVNEG_NODE:
+          case triton::ast::BVNOR_NODE:
+          case triton::ast::BVNOT_NODE:
+          case triton::ast::BVOR_NODE:
+          case triton::ast::BVROL_NODE:
+          case triton::ast::BVROR_NODE:
+          case triton::ast::BVSDIV_NODE:
+          case triton::ast::BVSHL_NODE:
+          case triton::ast::BVSMOD_NODE:
+          case triton::ast::BVSREM_NODE:
+          case triton::ast::BVSUB_NODE:
+          case triton::ast::BVUDIV_NODE:
+          case triton::ast::BVUREM_NODE:
+          case triton::ast::BVXNOR_NODE:
+          case triton::ast::BVXOR_NODE:
+            return true;
+          case triton::ast::ITE_NODE:
+            return index != 0;
+          default:
+            return false;
+        }
+      }
+
+
+      /* Returns true if all operands in this group have the same size */
+      static bool isPeerOperand(triton::ast::ast_e type, triton::usize index) {
+        return isComparison(type) || isSameSizeOperand(type, index);
+      }
+
+
+      /* Returns the number of indexes of an indexed operator */
+      static triton::usize numberOfIndexes(triton::ast::ast_e type) {
+        switch (type) {
+          case triton::ast::EXTRACT_NODE:
+            return 2;
+          case triton::ast::BVROL_NODE:
+          case triton::ast::BVROR_NODE:
+          case triton::ast::SX_NODE:
+          case triton::ast::ZX_NODE:
+            return 1;
+          default:
+            return 0;
+        }
+      }
+
+
+      /* Returns the position of the first operand among the children of a node */
+      static triton::usize firstOperand(triton::ast::ast_e type) {
+        switch (type) {
+          case triton::ast::EXTRACT_NODE:
+            return 2;
+          case triton::ast::SX_NODE:
+          case triton::ast::ZX_NODE:
+            return 1;
+          default:
+            return 0;
+        }
+      }
+
+
+      /* Returns the position of the index-th index among the children of a node */
+      static triton::usize indexPosition(triton::ast::ast_e type, triton::usize index) {
+        if (type == triton::ast::BVROL_NODE || type == triton::ast::BVROR_NODE)
+          return 1;
+        return index;
+      }
+
+
+      /* Returns the number of operands expected by an operator, 0 if variadic */
+      static triton::usize arity(triton::ast::ast_e type) {
+        switch (type) {
+          case triton::ast::BVNEG_NODE:
+          case triton::ast::BVNOT_NODE:
+          case triton::ast::BVROL_NODE:
+          case triton::ast::BVROR_NODE:
+          case triton::ast::EXTRACT_NODE:
+          case triton::ast::LNOT_NODE:
+          case triton::ast::SX_NODE:
+          case triton::ast::ZX_NODE:
+            return 1;
+          case triton::ast::ITE_NODE:
+            return 3;
+          case triton::ast::CONCAT_NODE:
+            return 0;
+          default:
+            return 2;
+        }
+      }
+
+
+      /* Returns the mask of a bit-vector size */
+      static triton::uint512 sizeMask(triton::uint32 size) {
+        triton::uint512 mask = -1;
+        mask >>= (512 - size);
+        return mask;
+      }
+
+
+      /*! \class SimplificationRules::Parser
+       *  \brief Parses rules in SMT-LIB prefix form or in infix form.
+       */
+      class SimplificationRules::Parser {
+        private:
+          //! The rule.
+          const std::string& rule;
+
+          //! The tokens of the rule.
+          std::vector<std::string> tokens;
+
+          //! The current token.
+          triton::usize position;
+
+          //! The names of variables, the index of a name is the index of the variable.
+          std::vector<std::string> variables;
+
+          //! True while parsing the pattern, variables are defined by the pattern.
+          bool inPattern;
+
+          //! Throws a parsing error.
+          void error(const std::string& message) const {
+            throw triton::exceptions::SymbolicSimplification("SimplificationRules::addRule(): " + message + " in \"" + this->rule + "\".");
+          }
+
+          //! Splits the rule into tokens.
+          void tokenize(void) {
+            triton::usize index = 0;
+
+            while (index < this->rule.size()) {
+              char c = this->rule[index];
+              char n = (index + 1 < this->rule.size()) ? this->rule[index + 1] : '\0';
+
+              if (std::isspace(static_cast<unsigned char>(c))) {
+                index++;
+              }
+              else if ((c == '-' && n == '>') || (c == '<' && n == '<') || (c == '>' && n == '>') || (c == '=' && n == '=') || (c == '!' && n == '=')) {
+                this->tokens.push_back(this->rule.substr(index, 2));
+                index += 2;
+              }
+              else if (std::string("()~&|^+-*/%=").find(c) != std::string::npos) {
+                this->tokens.push_back(std::string(1, c));
+                index++;
+              }
+              else if (std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '#') {
+                triton::usize start = index++;
+                while (index < this->rule.size() && (std::isalnum(static_cast<unsigned char>(this->rule[index])) || this->rule[index] == '_'))
+                  index++;
+                this->tokens.push_back(this->rule.substr(start, index - start));
+              }
+              else {
+                this->error(std::string("Unexpected character '") + c + "'");
+              }
+            }
+          }
+
+          //! Returns the current token or an empty string at the end of the rule.
+          const std::string& peek(triton::usize offset=0) const {
+            static const std::string end;
+            if (this->position + offset < this->tokens.size())
+              return this->tokens[this->position + offset];
+            return end;
+          }
+
+          //! Consumes the expected token.
+          void expect(const std::string& token) {
+            if (this->peek() != token)
+              this->error("Expected \"" + token + "\" instead of \"" + this->peek() + "\"");
+            this->position++;
+          }
+
+          //! Returns true if the token is a number.
+          static bool isNumber(const std::string& token) {
+            return !token.empty() && (std::isdigit(static_cast<unsigned char>(token[0])) || token[0] == '#');
+          }
+
+          //! Returns true and sets the operator type if the token names a prefix operator.
+          static bool prefixOperator(const std::string& token, triton::ast::ast_e& type) {
+            static const std::unordered_map<std::string, triton::ast::ast_e> operators = {
+              {"=",        triton::ast::EQUAL_NODE},
+              {"and",      triton::ast::LAND_NODE},
+              {"bvadd",    triton::ast::BVADD_NODE},
+              {"bvand",    triton::ast::BVAND_NODE},
+              {"bvashr",   triton::ast::BVASHR_NODE},
+              {"bvlshr",   triton::ast::BVLSHR_NODE},
+              {"bvmul",    triton::ast::BVMUL_NODE},
+              {"bvnand",   triton::ast::BVNAND_NODE},
+              {"bvneg",    triton::ast::BVNEG_NODE},
+              {"bvnor",    triton::ast::BVNOR_NODE},
+              {"bvnot",    triton::ast::BVNOT_NODE},
+              {"bvor",     triton::ast::BVOR_NODE},
+              {"bvsdiv",   triton::ast::BVSDIV_NODE},
+              {"bvsge",    triton::ast::BVSGE_NODE},
+              {"bvsgt",    triton::ast::BVSGT_NODE},
+              {"bvshl",    triton::ast::BVSHL_NODE},
+              {"bvsle",    triton::ast::BVSLE_NODE},
+              {"bvslt",    triton::ast::BVSLT_NODE},
+              {"bvsmod",   triton::ast::BVSMOD_NODE},
+              {"bvsrem",   triton::ast::BVSREM_NODE},
+              {"bvsub",    triton::ast::BVSUB_NODE},
+              {"bvudiv",   triton::ast::BVUDIV_NODE},
+              {"bvuge",    triton::ast::BVUGE_NODE},
+              {"bvugt",    triton::ast::BVUGT_NODE},
+              {"bvule",    triton::ast::BVULE_NODE},
+              {"bvult",    triton::ast::BVULT_NODE},
+              {"bvurem",   triton::ast::BVUREM_NODE},
+              {"bvxnor",   triton::ast::BVXNOR_NODE},
+              {"bvxor",    triton::ast::BVXOR_NODE},
+              {"concat",   triton::ast::CONCAT_NODE},
+              {"distinct", triton::ast::DISTINCT_NODE},
+              {"ite",      triton::ast::ITE_NODE},
+              {"not",      triton::ast::LNOT_NODE},
+              {"or",       triton::ast::LOR_NODE},
+              {"xor",      triton::ast::LXOR_NODE},
+            };
+
+            auto it = operators.find(token);
+            if (it == operators.end())
+              return false;
+
+            type = it->second;
+            return true;
+          }
+
+          //! Returns true and sets the operator type if the token names an indexed operator.
+          static bool indexedOperator(const std::string& token, triton::ast::ast_e& type) {
+            if (token == "extract")           type = triton::ast::EXTRACT_NODE;
+            else if (token == "rotate_left")  type = triton::ast::BVROL_NODE;
+            else if (token == "rotate_right") type = triton::ast::BVROR_NODE;
+            else if (token == "sign_extend")  type = triton::ast::SX_NODE;
+            else if (token == "zero_extend")  type = triton::ast::ZX_NODE;
+            else return false;
+            return true;
+          }
+
+          //! Returns true and sets the operator type and precedence if the token is a binary infix operator.
+          static bool infixOperator(const std::string& token, triton::ast::ast_e& type, triton::uint32& precedence) {
+            if (token == "==")      { type = triton::ast::EQUAL_NODE;    precedence = 1; }
+            else if (token == "!=") { type = triton::ast::DISTINCT_NODE; precedence = 1; }
+            else if (token == "|")  { type = triton::ast::BVOR_NODE;     precedence = 2; }
+            else if (token == "^")  { type = triton::ast::BVXOR_NODE;    precedence = 3; }
+            else if (token == "&")  { type = triton::ast::BVAND_NODE;    precedence = 4; }
+            else if (token == "<<") { type = triton::ast::BVSHL_NODE;    precedence = 5; }
+            else if (token == ">>") { type = triton::ast::BVLSHR_NODE;   precedence = 5; }
+            else if (token == "+")  { type = triton::ast::BVADD_NODE;    precedence = 6; }
+            else if (token == "-")  { type = triton::ast::BVSUB_NODE;    precedence = 6; }
+            else if (token == "*")  { type = triton::ast::BVMUL_NODE;    precedence = 7; }
+            else if (token == "/")  { type = triton::ast::BVUDIV_NODE;   precedence = 7; }
+            else if (token == "%")  { type = triton::ast::BVUREM_NODE;   precedence = 7; }
+            else return false;
+            return true;
+          }
+
+          //! Parses an unsigned decimal integer.
+          triton::uint32 parseIndex(const std::string& token) const {
+            triton::uint32 value = 0;
+
+            if (token.empty() || token.size() > 9)
+              this->error("Invalid index \"" + token + "\"");
+
+            for (char c : token) {
+              if (!std::isdigit(static_cast<unsigned char>(c)))
+                this->error("Invalid index \"" + token + "\"");
+              value = value * 10 + (c - '0');
+            }
+
+            return value;
+          }
+
+          //! Parses a number. Sets the size for `#x` and `#b` literals.
+          triton::uint512 parseNumber(const std::string& token, triton::uint32& size) const {
+            triton::uint512 value = 0;
+            triton::uint32 base   = 10;
+            triton::usize start   = 0;
+
+            size = 0;
+            if (token.size() > 2 && token[0] == '#' && (token[1] == 'x' || token[1] == 'b')) {
+              base  = (token[1] == 'x') ? 16 : 2;
+              start = 2;
+              size  = static_cast<triton::uint32>(token.size() - 2) * (base == 16 ? 4 : 1);
+            }
+            else if (token.size() > 2 && token[0] == '0' && token[1] == 'x') {
+              base  = 16;
+              start = 2;
+            }
+
+            if (start >= token.size() || size > 512)
+              this->error("Invalid number \"" + token + "\"");
+
+            for (triton::usize index = start; index < token.size(); index++) {
+              char c = static_cast<char>(std::tolower(static_cast<unsigned char>(token[index])));
+              triton::uint32 digit = 0;
+
+              if (c >= '0' && c <= '9')
+                digit = c - '0';
+              else if (c >= 'a' && c <= 'f')
+                digit = c - 'a' + 10;
+              else
+                base = 0;
+
+              if (digit >= base)
+                this->error("Invalid number \"" + token + "\"");
+
+              value = value * base + digit;
+            }
+
+            return value;
+          }
+
+          //! Returns a node pattern.
+          static Pattern node(triton::ast::ast_e type, std::vector<Pattern>&& children) {
+            Pattern pattern = {};
+            pattern.kind     = PATTERN_NODE;
+            pattern.type     = type;
+            pattern.children = std::move(children);
+            return pattern;
+          }
+
+          //! Returns a constant pattern.
+          static Pattern constant(const triton::uint512& value, triton::uint32 size) {
+            Pattern pattern = {};
+            pattern.kind  = PATTERN_CONSTANT;
+            pattern.value = value;
+            pattern.size  = size;
+            return pattern;
+          }
+
+          //! Returns a variable pattern.
+          Pattern variable(const std::string& name) {
+            triton::ast::ast_e type = triton::ast::INVALID_NODE;
+            Pattern pattern = {};
+
+            if (name == "_" || prefixOperator(name, type) || indexedOperator(name, type))
+              this->error("Invalid variable name \"" + name + "\"");
+
+            pattern.kind = PATTERN_VARIABLE;
+            for (pattern.variable = 0; pattern.variable < this->variables.size(); pattern.variable++) {
+              if (this->variables[pattern.variable] == name)
+                return pattern;
+            }
+
+            if (!this->inPattern)
+              this->error("Unknown variable \"" + name + "\" in the replacement");
+
+            this->variables.push_back(name);
+            return pattern;
+          }
+
+          //! Checks the number of operands of an operator.
+          void checkArity(const Pattern& pattern) const {
+            triton::usize expected = arity(pattern.type);
+
+            if ((expected == 0 && pattern.children.size() < 2) || (expected != 0 && pattern.children.size() != expected))
+              this->error("Invalid number of operands");
+          }
+
+          //! expression := unary (infix-operator unary)*
+          Pattern parseExpression(triton::uint32 precedence=1) {
+            Pattern lhs = this->parseUnary();
+
+            while (true) {
+              triton::ast::ast_e type = triton::ast::INVALID_NODE;
+              triton::uint32 p = 0;
+
+              if (!infixOperator(this->peek(), type, p) || p < precedence)
+                break;
+
+              this->position++;
+              Pattern rhs = this->parseExpression(p + 1);
+              lhs = node(type, {std::move(lhs), std::move(rhs)});
+            }
+
+            return lhs;
+          }
+
+          //! unary := '~' unary | '-' unary | primary
+          Pattern parseUnary(void) {
+            if (this->peek() == "~") {
+              this->position++;
+              return node(triton::ast::BVNOT_NODE, {this->parseUnary()});
+            }
+
+            if (this->peek() == "-") {
+              this->position++;
+              if (isNumber(this->peek())) {
+                triton::uint32 size = 0;
+                triton::uint512 value = this->parseNumber(this->tokens[this->position++], size);
+                return constant(triton::uint512(0) - value, size);
+              }
+              return node(triton::ast::BVNEG_NODE, {this->parseUnary()});
+            }
+
+            return this->parsePrimary();
+          }
+
+          //! primary := number | variable | (_ bvX size) | ((_ op index...) unary) | (op unary...) | (expression)
+          Pattern parsePrimary(void) {
+            triton::ast::ast_e type = triton::ast::INVALID_NODE;
+            std::string token = this->peek();
+
+            if (token.empty())
+              this->error("Unexpected end");
+
+            if (isNumber(token)) {
+              triton::uint32 size = 0;
+              this->position++;
+              triton::uint512 value = this->parseNumber(token, size);
+              return constant(value, size);
+            }
+
+            if (token != "(") {
+              if (!std::isalpha(static_cast<unsigned char>(token[0])) && token[0] != '_')
+                this->error("Unexpected token \"" + token + "\"");
+              this->position++;
+              return this->variable(token);
+            }
+
+            this->position++;
+
+            /* (_ bvX size) */
+            if (this->peek() == "_") {
+              triton::uint32 ignored = 0;
+              this->position++;
+              token = this->peek();
+              if (token.size() < 3 || token.compare(0, 2, "bv") != 0)
+                this->error("Invalid constant \"" + token + "\"");
+              this->position++;
+              triton::uint512 value = this->parseNumber(token.substr(2), ignored);
+              triton::uint32 size   = this->parseIndex(this->peek());
+              if (size == 0 || size > 512)
+                this->error("Invalid constant size");
+              this->position++;
+              this->expect(")");
+              return constant(value, size);
+            }
+
+            /* ((_ op index...) operand) */
+            if (this->peek() == "(" && this->peek(1) == "_") {
+              this->position += 2;
+              if (!indexedOperator(this->peek(), type))
+                this->error("Unknown operator \"" + this->peek() + "\"");
+              this->position++;
+              Pattern pattern = node(type, {});
+              for (triton::usize index = 0; index < numberOfIndexes(type); index++) {
+                pattern.indexes.push_back(this->parseIndex(this->peek()));
+                this->position++;
+              }
+              this->expect(")");
+              while (this->peek() != ")" && !this->peek().empty())
+                pattern.children.push_back(this->parseUnary());
+              this->expect(")");
+              this->checkArity(pattern);
+              return pattern;
+            }
+
+            /* (op operand...) */
+            if (prefixOperator(this->peek(), type)) {
+              this->position++;
+              Pattern pattern = node(type, {});
+              while (this->peek() != ")" && !this->peek().empty())
+                pattern.children.push_back(this->parseUnary());
+              this->expect(")");
+              this->checkArity(pattern);
+              return pattern;
+            }
+
+            /* (expression) */
+            Pattern pattern = this->parseExpression();
+            this->expect(")");
+            return pattern;
+          }
+
+        public:
+          //! Constructor.
+          Parser(const std::string& rule)
+            : rule(rule), position(0), inPattern(true) {
+            this->tokenize();
+          }
+
+          //! Parses the rule.
+          void parse(Pattern& lhs, Pattern& rhs, triton::uint32& numberOfVariables) {
+            lhs = this->parseExpression();
+            this->expect("->");
+
+            this->inPattern = false;
+            rhs = this->parseExpression();
+            if (this->position != this->tokens.size())
+              this->error("Unexpected token \"" + this->peek() + "\"");
+
+            if (lhs.kind != PATTERN_NODE)
+              this->error("The pattern must be an operator");
+
+            numberOfVariables = static_cast<triton::uint32>(this->variables.size());
+          }
+      };
+
+
+      SimplificationRules::SimplificationRules() {
+      }
+
+
+      void SimplificationRules::addRule(const std::string& rule) {
+        Rule r;
+
+        Parser(rule).parse(r.lhs, r.rhs, r.numberOfVariables);
+        this->checkSizes(r.rhs, true, rule);
+
+        if (this->dispatch.size() <= static_cast<triton::usize>(r.lhs.type))
+          this->dispatch.resize(r.lhs.type + 1);
+
+        this->dispatch[r.lhs.type].push_back(std::move(r));
+        this->texts.push_back(rule);
+      }
+
+
+      void SimplificationRules::clearRules(void) {
+        this->dispatch.clear();
+        this->texts.clear();
+      }
+
+
+      std::vector<std::string> SimplificationRules::getRules(void) const {
+        return this->texts;
+      }
+
+
+      bool SimplificationRules::isEmpty(void) const {
+        return this->texts.empty();
+      }
+
+
+      void SimplificationRules::checkSizes(const Pattern& pattern, bool sized, const std::string& rule) const {
+        if (pattern.kind == PATTERN_CONSTANT && pattern.size == 0 && !sized)
+          throw triton::exceptions::SymbolicSimplification("SimplificationRules::addRule(): Cannot infer the size of a constant in \"" + rule + "\", use (_ bvX size).");
+
+        if (pattern.kind != PATTERN_NODE)
+          return;
+
+        /* A constant takes the size of the node or the size of a non constant peer operand */
+        bool peer = false;
+        for (triton::usize index = 0; index < pattern.children.size(); index++) {
+          if (pattern.children[index].kind != PATTERN_CONSTANT && isPeerOperand(pattern.type, index))
+            peer = true;
+        }
+
+        for (triton::usize index = 0; index < pattern.children.size(); index++) {
+          bool childSized = (sized && isSameSizeOperand(pattern.type, index)) || (peer && isPeerOperand(pattern.type, index));
+          this->checkSizes(pattern.children[index], childSized, rule);
+        }
+      }
+
+
+      bool SimplificationRules::match(std::vector<Goal>& goals, std::vector<triton::ast::SharedAbstractNode>& bindings) const {
+        if (goals.empty())
+          return true;
+
+        Goal goal = goals.back();
+        goals.pop_back();
+
+        const Pattern& pattern = *goal.first;
+        const triton::ast::SharedAbstractNode& node = *goal.second;
+        bool matched = false;
+
+        switch (pattern.kind) {
+          case PATTERN_VARIABLE: {
+            auto& binding = bindings[pattern.variable];
+            if (binding == nullptr) {
+              binding = node;
+              matched = this->match(goals, bindings);
+              if (!matched)
+                binding = nullptr;
+            }
+            else if (binding == node || binding->equalTo(node)) {
+              matched = this->match(goals, bindings);
+            }
+            break;
+          }
+
+          case PATTERN_CONSTANT: {
+            if (node->getType() == triton::ast::BV_NODE && (pattern.size == 0 || pattern.size == node->getBitvectorSize())) {
+              if (node->evaluate() == (pattern.value & node->getBitvectorMask()))
+                matched = this->match(goals, bindings);
+            }
+            break;
+          }
+
+          case PATTERN_NODE: {
+            const auto& children = node->getChildren();
+            triton::usize first  = firstOperand(pattern.type);
+
+            if (node->getType() != pattern.type || children.size() != first + pattern.children.size() + (first ? 0 : pattern.indexes.size()))
+              break;
+
+            bool indexes = true;
+            for (triton::usize index = 0; index < pattern.indexes.size(); index++) {
+              const auto& child = children[indexPosition(pattern.type, index)];
+              if (child->getType() != triton::ast::INTEGER_NODE || reinterpret_cast<triton::ast::IntegerNode*>(child.get())->getInteger() != pattern.indexes[index])
+                indexes = false;
+            }
+            if (!indexes)
+              break;
+
+            /* Goals are processed from the back, so operands are pushed in reverse order */
+            triton::usize base = goals.size();
+            for (triton::usize index = pattern.children.size(); index > 0; index--)
+              goals.push_back({&pattern.children[index - 1], &children[first + index - 1]});
+            matched = this->match(goals, bindings);
+            goals.resize(base);
+
+            if (!matched && pattern.children.size() == 2 && isCommutative(pattern.type)) {
+              goals.push_back({&pattern.children[0], &children[first + 1]});
+              goals.push_back({&pattern.children[1], &children[first]});
+              matched = this->match(goals, bindings);
+              goals.resize(base);
+            }
+            break;
+          }
+        }
+
+        goals.push_back(goal);
+        return matched;
+      }
+
+
+      triton::ast::SharedAbstractNode SimplificationRules::build(const Pattern& pattern, const std::vector<triton::ast::SharedAbstractNode>& bindings, const triton::ast::SharedAstContext& ctxt, triton::uint32 size) const {
+        switch (pattern.kind) {
+          case PATTERN_VARIABLE:
+            return bindings[pattern.variable];
+
+          case PATTERN_CONSTANT: {
+            triton::uint32 sz = pattern.size ? pattern.size : size;
+            return ctxt->bv(pattern.value & sizeMask(sz), sz);
+          }
+
+          default:
+            break;
+        }
+
+        std::vector<triton::ast::SharedAbstractNode> c(pattern.children.size());
+        triton::uint32 peer = 0;
+
+        /* Non constant operands first, constants may take the size of their peers */
+        for (triton::usize index = 0; index < pattern.children.size(); index++) {
+          if (pattern.children[index].kind == PATTERN_CONSTANT)
+            continue;
+          c[index] = this->build(pattern.children[index], bindings, ctxt, isSameSizeOperand(pattern.type, index) ? size : 0);
+          if (peer == 0 && isPeerOperand(pattern.type, index))
+            peer = c[index]->getBitvectorSize();
+        }
+
+        for (triton::usize index = 0; index < pattern.children.size(); index++) {
+          if (pattern.children[index].kind != PATTERN_CONSTANT)
+            continue;
+          triton::uint32 sz = (isSameSizeOperand(pattern.type, index) && size) ? size : (isPeerOperand(pattern.type, index) ? peer : 0);
+          c[index] = this->build(pattern.children[index], bindings, ctxt, sz);
+        }
+
+        switch (pattern.type) {
+          case triton::ast::BVADD_NODE:     return ctxt->bvadd(c[0], c[1]);
+          case triton::ast::BVAND_NODE:     return ctxt->bvand(c[0], c[1]);
+          case triton::ast::BVASHR_NODE:    return ctxt->bvashr(c[0], c[1]);
+          case triton::ast::BVLSHR_NODE:    return ctxt->bvlshr(c[0], c[1]);
+          case triton::ast::BVMUL_NODE:     return ctxt->bvmul(c[0], c[1]);
+          case triton::ast::BVNAND_NODE:    return ctxt->bvnand(c[0], c[1]);
+          case triton::ast::BVNEG_NODE:     return ctxt->bvneg(c[0]);
+          case triton::ast::BVNOR_NODE:     return ctxt->bvnor(c[0], c[1]);
+          case triton::ast::BVNOT_NODE:     return ctxt->bvnot(c[0]);
+          case triton::ast::BVOR_NODE:      return ctxt->bvor(c[0], c[1]);
+          case triton::ast::BVROL_NODE:     return ctxt->bvrol(c[0], pattern.indexes[0]);
+          case triton::ast::BVROR_NODE:     return ctxt->bvror(c[0], pattern.indexes[0]);
+          case triton::ast::BVSDIV_NODE:    return ctxt->bvsdiv(c[0], c[1]);
+          case triton::ast::BVSGE_NODE:     return ctxt->bvsge(c[0], c[1]);
+          case triton::ast::BVSGT_NODE:     return ctxt->bvsgt(c[0], c[1]);
+          case triton::ast::BVSHL_NODE:     return ctxt->bvshl(c[0], c[1]);
+          case triton::ast::BVSLE_NODE:     return ctxt->bvsle(c[0], c[1]);
+          case triton::ast::BVSLT_NODE:     return ctxt->bvslt(c[0], c[1]);
+          case triton::ast::BVSMOD_NODE:    return ctxt->bvsmod(c[0], c[1]);
+          case triton::ast::BVSREM_NODE:    return ctxt->bvsrem(c[0], c[1]);
+          case triton::ast::BVSUB_NODE:     return ctxt->bvsub(c[0], c[1]);
+          case triton::ast::BVUDIV_NODE:    return ctxt->bvudiv(c[0], c[1]);
+          case triton::ast::BVUGE_NODE:     return ctxt->bvuge(c[0], c[1]);
+          case triton::ast::BVUGT_NODE:     return ctxt->bvugt(c[0], c[1]);
+          case triton::ast::BVULE_NODE:     return ctxt->bvule(c[0], c[1]);
+          case triton::ast::BVULT_NODE:     return ctxt->bvult(c[0], c[1]);
+          case triton::ast::BVUREM_NODE:    return ctxt->bvurem(c[0], c[1]);
+          case triton::ast::BVXNOR_NODE:    return ctxt->bvxnor(c[0], c[1]);
+          case triton::ast::BVXOR_NODE:     return ctxt->bvxor(c[0], c[1]);
+          case triton::ast::CONCAT_NODE:    return ctxt->concat(c);
+          case triton::ast::DISTINCT_NODE:  return ctxt->distinct(c[0], c[1]);
+          case triton::ast::EQUAL_NODE:     return ctxt->equal(c[0], c[1]);
+          case triton::ast::EXTRACT_NODE:   return ctxt->extract(pattern.indexes[0], pattern.indexes[1], c[0]);
+          case triton::ast::ITE_NODE:       return ctxt->ite(c[0], c[1], c[2]);
+          case triton::ast::LAND_NODE:      return ctxt->land(c[0], c[1]);
+          case triton::ast::LNOT_NODE:      return ctxt->lnot(c[0]);
+          case triton::ast::LOR_NODE:       return ctxt->lor(c[0], c[1]);
+          case triton::ast::LXOR_NODE:      return ctxt->lxor(c[0], c[1]);
+          case triton::ast::SX_NODE:        return ctxt->sx(pattern.indexes[0], c[0]);
+          case triton::ast::ZX_NODE:        return ctxt->zx(pattern.indexes[0], c[0]);
+          default:
+            throw triton::exceptions::SymbolicSimplification("SimplificationRules::build(): Invalid operator.");
+        }
+      }
+
+
+      triton::ast::SharedAbstractNode SimplificationRules::rewrite(const triton::ast::SharedAbstractNode& node) const {
+        triton::usize type = static_cast<triton::usize>(node->getType());
+
+        if (type >= this->dispatch.size())
+          return node;
+
+        for (const auto& rule : this->dispatch[type]) {
+          std::vector<triton::ast::SharedAbstractNode> bindings(rule.numberOfVariables);
+          std::vector<Goal> goals;
+
+          goals.push_back({&rule.lhs, &node});
+          if (!this->match(goals, bindings))
+            continue;
+
+          /* A replacement may be ill-sorted for a given match (e.g. operands of different sizes), the rule is then skipped */
+          try {
+            auto snode = this->build(rule.rhs, bindings, node->getContext(), node->getBitvectorSize());
+            if (snode->getBitvectorSize() == node->getBitvectorSize() && snode->isLogical() == node->isLogical())
+              return snode;
+          }
+          catch (const triton::exceptions::Ast&) {
+          }
+        }
+
+        return node;
+      }
+
+    }; /* symbolic namespace */
+  }; /* engines namespace */
+}; /* triton namespace */
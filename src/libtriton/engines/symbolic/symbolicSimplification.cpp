@@ -5,7 +5,8 @@
 **  This program is under the terms of the Apache License 2.0.
 */
 
-#include <list>
+#include <unordered_set>
+
 #include <triton/exceptions.hpp>
 #include <triton/symbolicSimplification.hpp>
 
@@ -104,6 +105,26 @@ if __name__ == "__main__":
     print 'Simp: ', c
 ~~~~~~~~~~~~~
 
+\subsection SMT_simplification_rules Simplification via rewrite rules
+<hr>
+
+Callbacks are called for every node, which from Python means a round-trip through the interpreter per node. Simple rules
+can instead be recorded as rewrite rules using the triton::API::addSimplificationRule() function. A rule is written as
+`pattern -> replacement`, in SMT-LIB prefix form or with Python's operators. Identifiers are pattern variables (a variable
+used several times must match equal sub-trees) and constants without explicit size take the size of their context. Rules
+are dispatched on the type of the root node, commutative operators are matched in both orders and rules are applied before
+callbacks (See: triton::engines::symbolic::SimplificationRules).
+
+~~~~~~~~~~~~~{.py}
+>>> ctx.addSimplificationRule("(bvxor x x) -> 0")
+>>> ctx.addSimplificationRule("(a & ~b) | (~a & b) -> a ^ b")
+
+>>> a = ctx.getAstContext().variable(var)
+>>> b = bv(2, 8)
+>>> print ctx.simplify((~b & a) | (~a & b))
+(bvxor SymVar_0 (_ bv2 8))
+~~~~~~~~~~~~~
+
 \subsection SMT_simplification_z3 Simplification via Z3
 <hr>
 
@@ -158,7 +179,8 @@ namespace triton {
 
 
       SymbolicSimplification::SymbolicSimplification(triton::callbacks::Callbacks* callbacks) {
-        this->callbacks = callbacks;
+        this->callbacks     = callbacks;
+        this->maxIterations = 1;
       }
 
 
@@ -168,48 +190,149 @@ namespace triton {
 
 
       void SymbolicSimplification::copy(const SymbolicSimplification& other) {
-        this->callbacks = other.callbacks;
+        this->callbacks     = other.callbacks;
+        this->maxIterations = other.maxIterations;
+        this->rules         = other.rules;
       }
 
 
       triton::ast::SharedAbstractNode SymbolicSimplification::processSimplification(const triton::ast::SharedAbstractNode& node) const {
-        std::list<triton::ast::SharedAbstractNode> worklist;
+        std::vector<triton::ast::SharedAbstractNode> worklist;
+        std::vector<triton::ast::SharedAbstractNode> updated;
+        std::unordered_set<triton::ast::AbstractNode*> visited;
+        SimplificationMemo memo;
         triton::ast::SharedAbstractNode snode = node;
 
         if (node == nullptr)
           throw triton::exceptions::SymbolicSimplification("SymbolicSimplification::processSimplification(): node cannot be null.");
 
-        if (this->callbacks && this->callbacks->isDefined(triton::callbacks::SYMBOLIC_SIMPLIFICATION)) {
-          snode = this->callbacks->processCallbacks(triton::callbacks::SYMBOLIC_SIMPLIFICATION, node);
+        if (!this->rules.isEmpty() || (this->callbacks && this->callbacks->isDefined(triton::callbacks::SYMBOLIC_SIMPLIFICATION))) {
+          snode = this->simplify(node, memo);
           /*
            *  We use a worklist strategy to avoid recursive calls
            *  and so stack overflow when going through a big AST.
+           *  Each node is visited once even if it is shared, and
+           *  each child is simplified once thanks to the memo.
            */
           worklist.push_back(snode);
-          while (worklist.size()) {
-            auto ast = worklist.front();
-            worklist.pop_front();
+          while (!worklist.empty()) {
+            auto ast = worklist.back();
+            worklist.pop_back();
+
+            if (!visited.insert(ast.get()).second)
+              continue;
+
             bool needs_update = false;
             for (triton::uint32 index = 0; index < ast->getChildren().size(); index++) {
               auto child = ast->getChildren()[index];
               /* Don't apply simplification on nodes like String, Integer, etc. */
               if (child->getBitvectorSize()) {
-                auto schild = this->callbacks->processCallbacks(triton::callbacks::SYMBOLIC_SIMPLIFICATION, child);
-                ast->setChild(index, schild);
-                needs_update |= !schild->canReplaceNodeWithoutUpdate(child);
+                auto schild = this->simplify(child, memo);
+                if (schild != child) {
+                  ast->setChild(index, schild);
+                  needs_update |= !schild->canReplaceNodeWithoutUpdate(child);
+                }
                 worklist.push_back(schild);
               }
             }
+
             if (needs_update) {
-              ast->init(true);
+              updated.push_back(ast);
             }
           }
+
+          /* Nodes whose children changed are re-initialized once, after the whole pass */
+          this->initAncestors(updated);
+        }
+
+        return snode;
+      }
+
+
+      triton::ast::SharedAbstractNode SymbolicSimplification::simplify(const triton::ast::SharedAbstractNode& node, SimplificationMemo& memo) const {
+        auto it = memo.find(node.get());
+        if (it != memo.end())
+          return it->second.second;
+
+        bool useCallbacks = this->callbacks && this->callbacks->isDefined(triton::callbacks::SYMBOLIC_SIMPLIFICATION);
+        triton::ast::SharedAbstractNode snode = node;
+        for (triton::usize iteration = 0; iteration < this->maxIterations; iteration++) {
+          auto next = this->rules.rewrite(snode);
+          if (useCallbacks)
+            next = this->callbacks->processCallbacks(triton::callbacks::SYMBOLIC_SIMPLIFICATION, next);
+          if (next == snode)
+            break;
+          snode = next;
         }
 
+        memo[node.get()] = std::make_pair(node, snode);
+
         return snode;
       }
 
 
+      void SymbolicSimplification::initAncestors(const std::vector<triton::ast::SharedAbstractNode>& nodes) const {
+        std::vector<std::pair<triton::ast::SharedAbstractNode, bool>> worklist;
+        std::vector<triton::ast::SharedAbstractNode> order;
+        std::unordered_set<triton::ast::AbstractNode*> visited;
+
+        /* Post-order on parents: a node comes after all its ancestors */
+        for (const auto& node : nodes)
+          worklist.push_back({node, false});
+
+        while (!worklist.empty()) {
+          auto ast       = worklist.back().first;
+          bool postOrder = worklist.back().second;
+          worklist.pop_back();
+
+          if (postOrder) {
+            order.push_back(ast);
+            continue;
+          }
+
+          if (!visited.insert(ast.get()).second)
+            continue;
+
+          worklist.push_back({ast, true});
+          for (const auto& parent : ast->getParents()) {
+            if (visited.find(parent.get()) == visited.end())
+              worklist.push_back({parent, false});
+          }
+        }
+
+        /* Children are initialized before their parents */
+        for (auto it = order.rbegin(); it != order.rend(); it++)
+          (*it)->init();
+      }
+
+
+      void SymbolicSimplification::addSimplificationRule(const std::string& rule) {
+        this->rules.addRule(rule);
+      }
+
+
+      void SymbolicSimplification::clearSimplificationRules(void) {
+        this->rules.clearRules();
+      }
+
+
+      std::vector<std::string> SymbolicSimplification::getSimplificationRules(void) const {
+        return this->rules.getRules();
+      }
+
+
+      void SymbolicSimplification::setMaxSimplificationIterations(triton::usize iterations) {
+        if (iterations == 0)
+          throw triton::exceptions::SymbolicSimplification("SymbolicSimplification::setMaxSimplificationIterations(): iterations must be greater than 0.");
+        this->maxIterations = iterations;
+      }
+
+
+      triton::usize SymbolicSimplification::getMaxSimplificationIterations(void) const {
+        return this->maxIterations;
+      }
+
+
       SymbolicSimplification& SymbolicSimplification::operator=(const SymbolicSimplification& other) {
         this->copy(other);
         return *this;
@@ -213,6 +213,22 @@ namespace triton {
          */
         TRITON_EXPORT void setConcreteMemoryAreaValue(triton::uint64 baseAddr, const triton::uint8* area, triton::usize size);
 
+        /*!
+         * \brief [**architecture api**] - Maps a memory area without copying it.
+         *
+         * \details The bytes of the area are read in place, a page is only copied when it is written
+         * (copy-on-write). The area must outlive the mapping. The mapped memory is concretized.
+         */
+        TRITON_EXPORT void mapConcreteMemoryArea(triton::uint64 baseAddr, const triton::uint8* area, triton::usize size);
+
+        /*!
+         * \brief [**architecture api**] - Maps `size` bytes of a file from `offset` without copying them.
+         *
+         * \details The file is memory-mapped read-only and its pages are shared with the other
+         * processes mapping it, a page is only copied when it is written (copy-on-write). The mapped memory is concretized.
+         */
+        TRITON_EXPORT void mapConcreteMemoryFile(triton::uint64 baseAddr, const std::string& path, triton::uint64 offset, triton::usize size);
+
         /*!
          * \brief [**architecture api**] - Sets the concrete value of a register.
          *
@@ -402,6 +418,21 @@ namespace triton {
         //! [**symbolic api**] - Processes all recorded simplifications. Returns the simplified node.
         TRITON_EXPORT triton::ast::SharedAbstractNode processSimplification(const triton::ast::SharedAbstractNode& node, bool z3=false) const;
 
+        //! [**symbolic api**] - Adds a simplification rule like `(bvxor x x) -> 0`. See triton::engines::symbolic::SimplificationRules.
+        TRITON_EXPORT void addSimplificationRule(const std::string& rule);
+
+        //! [**symbolic api**] - Removes all simplification rules.
+        TRITON_EXPORT void clearSimplificationRules(void);
+
+        //! [**symbolic api**] - Returns all simplification rules.
+        TRITON_EXPORT std::vector<std::string> getSimplificationRules(void) const;
+
+        //! [**symbolic api**] - Sets the maximum number of times simplification rules and callbacks are applied on a node (1 by default).
+        TRITON_EXPORT void setMaxSimplificationIterations(triton::usize iterations);
+
+        //! [**symbolic api**] - Returns the maximum number of times simplification rules and callbacks are applied on a node.
+        TRITON_EXPORT triton::usize getMaxSimplificationIterations(void) const;
+
         //! [**symbolic api**] - Returns the shared symbolic expression corresponding to an id.
         TRITON_EXPORT triton::engines::symbolic::SharedSymbolicExpression getSymbolicExpression(triton::usize symExprId) const;
 
@@ -423,6 +454,9 @@ namespace triton {
         //! [**symbolic api**] - Returns the current path predicate as an AST of logical conjunction of each taken branch.
         TRITON_EXPORT triton::ast::SharedAbstractNode getPathPredicate(void);
 
+        //! [**symbolic api**] - Returns the conjunction of `node` and of the first `prefix` path constraints which are not independent from it. Variables out of the slice keep their concrete values.
+        TRITON_EXPORT triton::ast::SharedAbstractNode getPathPredicateSlice(const triton::ast::SharedAbstractNode& node, triton::usize prefix);
+
         //! [**symbolic api**] - Returns path predicates which may reach the targeted address.
         TRITON_EXPORT std::vector<triton::ast::SharedAbstractNode> getPredicatesToReachAddress(triton::uint64 addr);
 
@@ -441,6 +475,18 @@ namespace triton {
         //! [**symbolic api**] - Clears the current path predicate.
         TRITON_EXPORT void clearPathConstraints(void);
 
+        //! [**symbolic api**] - Defines the max number of path constraints pushed per branch instruction, 0 for unlimited.
+        TRITON_EXPORT void setMaxPathConstraintsPerSite(triton::usize limit);
+
+        //! [**symbolic api**] - Enables the log of path constraints into a file, keeping between `window` and 2 * `window` path constraints in memory. An empty path disables it.
+        TRITON_EXPORT void setPathConstraintLog(const std::string& path, triton::usize window);
+
+        //! [**symbolic api**] - Returns the number of path constraints moved to the log.
+        TRITON_EXPORT triton::usize getSizeOfLoggedPathConstraints(void) const;
+
+        //! [**symbolic api**] - Reads back the logged path constraints from a given range.
+        TRITON_EXPORT std::vector<triton::engines::symbolic::PathConstraint> getLoggedPathConstraints(triton::usize start, triton::usize end) const;
+
         //! [**symbolic api**] - Enables or disables the symbolic execution engine.
         TRITON_EXPORT void enableSymbolicEngine(bool flag);
 
@@ -526,9 +572,68 @@ namespace triton {
          */
         TRITON_EXPORT std::vector<std::unordered_map<triton::usize, triton::engines::solver::SolverModel>> getModels(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, triton::engines::solver::status_e* status = nullptr, triton::uint32 timeout = 0, triton::uint32* solvingTime = nullptr) const;
 
+        /*!
+         * \brief [**solver api**] - Computes and returns several models projected on `variables`. Models only hold these variables and differ
+         * by at least one of them, so enumerating the values of an input does not enumerate the other variables of the constraint.
+         *
+         * \details
+         * **item1**: symbolic variable id<br>
+         * **item2**: model
+         */
+        TRITON_EXPORT std::vector<std::unordered_map<triton::usize, triton::engines::solver::SolverModel>> getModels(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, const std::vector<triton::engines::symbolic::SharedSymbolicVariable>& variables, triton::engines::solver::status_e* status = nullptr, triton::uint32 timeout = 0, triton::uint32* solvingTime = nullptr) const;
+
         //! Returns true if an expression is satisfiable.
         TRITON_EXPORT bool isSat(const triton::ast::SharedAbstractNode& node, triton::engines::solver::status_e* status = nullptr, triton::uint32 timeout = 0, triton::uint32* solvingTime = nullptr) const;
 
+        /*!
+         * \brief [**solver api**] - Computes and returns a model from a symbolic constraint and the first `prefix` path constraints. The query is solved
+         * by the incremental solver session, which only translates and asserts the path constraints it does not hold yet. If the
+         * query has no model, weaker retries are allowed by the solver policy (See: setSolverPolicy()) and `strategy` tells which
+         * path constraints gave the answer.
+         *
+         * \details
+         * **item1**: symbolic variable id<br>
+         * **item2**: model
+         */
+        TRITON_EXPORT std::unordered_map<triton::usize, triton::engines::solver::SolverModel> getModelOnPath(const triton::ast::SharedAbstractNode& node, triton::usize prefix, triton::engines::solver::status_e* status = nullptr, triton::uint32 timeout = 0, triton::uint32* solvingTime = nullptr, triton::engines::solver::policy_e* strategy = nullptr) const;
+
+        /*!
+         * \brief [**solver api**] - Computes and returns several models from a symbolic constraint and the first `prefix` path constraints, using the incremental solver session
+         * and the solver policy.
+         *
+         * \details
+         * **item1**: symbolic variable id<br>
+         * **item2**: model
+         */
+        TRITON_EXPORT std::vector<std::unordered_map<triton::usize, triton::engines::solver::SolverModel>> getModelsOnPath(const triton::ast::SharedAbstractNode& node, triton::usize prefix, triton::uint32 limit, triton::engines::solver::status_e* status = nullptr, triton::uint32 timeout = 0, triton::uint32* solvingTime = nullptr, triton::engines::solver::policy_e* strategy = nullptr) const;
+
+        //! [**solver api**] - Returns true if an expression and the first `prefix` path constraints are satisfiable, using the incremental solver session and the solver policy.
+        TRITON_EXPORT bool isSatOnPath(const triton::ast::SharedAbstractNode& node, triton::usize prefix, triton::engines::solver::status_e* status = nullptr, triton::uint32 timeout = 0, triton::uint32* solvingTime = nullptr, triton::engines::solver::policy_e* strategy = nullptr) const;
+
+        //! [**solver api**] - Destroys the incremental solver session and releases its z3 context.
+        TRITON_EXPORT void resetSolverSession(void);
+
+        /*!
+         * \brief [**solver api**] - Defines the weakest path constraints given to the solver by path-aware queries (POLICY_FULL by default).
+         *
+         * \details A query without model under the full path predicate is retried, as allowed by the policy, with the path constraints
+         * sharing variables with the query (POLICY_NESTED, only if the full query was not UNSAT as both are then equisatisfiable), then
+         * with the query alone (POLICY_LAST). Models of weaker queries may not follow the path and must be checked by running the input.
+         */
+        TRITON_EXPORT void setSolverPolicy(triton::engines::solver::policy_e policy);
+
+        //! [**solver api**] - Returns the weakest path constraints given to the solver by path-aware queries.
+        TRITON_EXPORT triton::engines::solver::policy_e getSolverPolicy(void) const;
+
+        /*!
+         * \brief [**solver api**] - Computes a model for each branch not taken by the current path, in parallel.
+         *
+         * \details Queries are solved on `threads` worker threads (0 for one per core), each owning its own
+         * z3 context, with a `timeout` per query (0 for the solver timeout). `callback` is called on the calling
+         * thread for each answer, in completion order. Workers solve a copy of the path, so the callback may modify it.
+         */
+        TRITON_EXPORT void flipPathConstraints(const triton::engines::solver::ParallelSolver::Callback& callback, triton::uint32 threads = 0, triton::uint32 timeout = 0);
+
         //! Returns the kind of solver as triton::engines::solver::solver_e.
         TRITON_EXPORT triton::engines::solver::solver_e getSolver(void) const;
 
@@ -556,6 +661,30 @@ namespace triton {
         //! [**solver api**] - Defines a solver memory consumption limit (in megabytes).
         TRITON_EXPORT void setSolverMemoryLimit(triton::uint32 limit);
 
+        //! [**solver api**] - Defines the commands of the SOLVER_SMTLIB solver (e.g. `{{"z3", "-in"}, {"cvc5", "--lang", "smt2", "--incremental"}}`). Queries are raced between them.
+        TRITON_EXPORT void setSolverCommands(const std::vector<std::vector<std::string>>& commands);
+
+        //! [**solver api**] - Defines the max number of answers kept by the solver cache. 0 (default) disables the cache.
+        TRITON_EXPORT void setSolverCacheCapacity(triton::usize capacity);
+
+        //! [**solver api**] - Returns the number of queries answered by the solver cache.
+        TRITON_EXPORT triton::usize getSolverCacheHits(void) const;
+
+        //! [**solver api**] - Returns the number of queries forwarded by the solver cache to the solver.
+        TRITON_EXPORT triton::usize getSolverCacheMisses(void) const;
+
+        //! [**solver api**] - Removes all answers from the solver cache and resets its counters.
+        TRITON_EXPORT void clearSolverCache(void);
+
+        //! [**solver api**] - Enables or disables the fast path answering trivial queries without the solver (disabled by default).
+        TRITON_EXPORT void setSolverFastPath(bool flag);
+
+        //! [**solver api**] - Returns true if the fast path answering trivial queries is enabled.
+        TRITON_EXPORT bool isSolverFastPathEnabled(void) const;
+
+        //! [**solver api**] - Returns the number of queries answered by the fast path.
+        TRITON_EXPORT triton::usize getSolverFastPathHits(void) const;
+
 
 
         /* Taint engine API ============================================================================== */
@@ -194,6 +194,24 @@ namespace triton {
          */
         TRITON_EXPORT void setConcreteMemoryAreaValue(triton::uint64 baseAddr, const triton::uint8* area, triton::usize size);
 
+        /*!
+         * \brief [**architecture api**] - Maps a memory area without copying it.
+         *
+         * \details The bytes of the area are read in place, a page is only copied when it is written
+         * (copy-on-write). The area must outlive the mapping. Note that by setting a concrete value will
+         * probably imply a desynchronization with the symbolic state (if it exists).
+         */
+        TRITON_EXPORT void mapConcreteMemoryArea(triton::uint64 baseAddr, const triton::uint8* area, triton::usize size);
+
+        /*!
+         * \brief [**architecture api**] - Maps `size` bytes of a file from `offset` without copying them.
+         *
+         * \details The file is memory-mapped read-only and its pages are shared with the other
+         * processes mapping it, a page is only copied when it is written (copy-on-write). Note that by setting a concrete value will
+         * probably imply a desynchronization with the symbolic state (if it exists).
+         */
+        TRITON_EXPORT void mapConcreteMemoryFile(triton::uint64 baseAddr, const std::string& path, triton::uint64 offset, triton::usize size);
+
         /*!
          * \brief [**architecture api**] - Sets the concrete value of a register.
          *
@@ -65,9 +65,38 @@ namespace triton {
     //! Abstract node
     class AbstractNode : public std::enable_shared_from_this<AbstractNode> {
       private:
+        //! A parent of the node and the number of times it uses the node as child.
+        struct ParentEdge {
+          AbstractNode* node;
+          triton::uint32 count;
+          WeakAbstractNode weak;
+        };
+
+        //! Parents are scanned linearly up to this number, then indexed.
+        static const triton::usize maxLinearParents = 16;
+
         //! Hashes the tree.
         virtual void initHash(void) = 0;
 
+        //! Returns the position of a parent in the parents list, or the size of the list if not found.
+        triton::usize findParent(AbstractNode* p);
+
+        //! Removes the parent at a given position of the parents list.
+        void eraseParent(triton::usize index);
+
+        //! Removes dead parents from the parents list.
+        void pruneParents(void);
+
+        //! Re-evaluates the nodes of the tree which have been computed before the current epoch of the context.
+        void refreshEvaluation(void);
+
+      protected:
+        //! Sets the value of the tree, kept in native storage if it fits in 64 bits.
+        void setEval(const triton::uint512& value);
+
+        //! Sets the value of the tree.
+        void setEval(triton::uint64 value);
+
       protected:
         //! Deep level for computing hash
         triton::uint32 level;
@@ -75,28 +104,38 @@ namespace triton {
         //! The type of the node.
         triton::ast::ast_e type;
 
-        //! The children of the node.
-        std::vector<SharedAbstractNode> children;
-
-        // This structure counter the number of use of a given parent as a node may have
-        // multiple time the same parent: eg. xor rax rax
-        std::unordered_map<AbstractNode*, std::pair<triton::uint32, WeakAbstractNode>> parents;
-
         //! The size of the node.
         triton::uint32 size;
 
-        //! The value of the tree from this root node.
-        triton::uint512 eval;
-
-        //! The hash of the tree
-        triton::uint512 hash;
-
         //! True if the tree contains a symbolic variable.
         bool symbolized;
 
         //! True if it's a logical node.
         bool logical;
 
+        //! The hash of the tree
+        triton::uint64 hash;
+
+        //! The children of the node.
+        std::vector<SharedAbstractNode> children;
+
+        // This structure counter the number of use of a given parent as a node may have
+        // multiple time the same parent: eg. xor rax rax. Most nodes have one or two parents,
+        // so they are kept in a flat list.
+        std::vector<ParentEdge> parents;
+
+        //! Index of the parents list by address. Only built for nodes with many parents.
+        std::unique_ptr<std::unordered_map<AbstractNode*, triton::usize>> parentsIndex;
+
+        //! The value of the tree from this root node, if it fits in 64 bits.
+        triton::uint64 eval;
+
+        //! The value of the tree from this root node if it does not fit in 64 bits, null otherwise.
+        std::unique_ptr<triton::uint512> wideEval;
+
+        //! The evaluation epoch of the context at which eval has been computed.
+        triton::uint64 epoch;
+
         //! Contect use to create this node
         SharedAstContext ctxt;
 
@@ -104,6 +143,9 @@ namespace triton {
         //! Constructor.
         TRITON_EXPORT AbstractNode(triton::ast::ast_e type, const SharedAstContext& ctxt);
 
+        //! Constructor by copy.
+        TRITON_EXPORT AbstractNode(const AbstractNode& other);
+
         //! Destructor.
         TRITON_EXPORT virtual ~AbstractNode();
 
@@ -141,11 +183,14 @@ namespace triton {
         TRITON_EXPORT triton::uint32 getLevel(void) const;
 
         //! Returns the hash of the tree.
-        TRITON_EXPORT triton::uint512 getHash(void) const;
+        TRITON_EXPORT triton::uint64 getHash(void) const;
 
         //! Evaluates the tree.
         TRITON_EXPORT triton::uint512 evaluate(void) const;
 
+        //! Evaluates the tree and returns its 64 least significant bits. Fast path for nodes of 64 bits or less.
+        TRITON_EXPORT triton::uint64 evaluate64(void) const;
+
         //! Initializes parents.
         void initParents(void);
 
@@ -796,10 +841,19 @@ namespace triton {
     };
 
     //! Custom hash2n function for hash routine.
-    triton::uint512 hash2n(triton::uint512 hash, triton::uint32 n);
+    triton::uint64 hash2n(triton::uint64 hash, triton::uint32 n);
+
+    //! Combines a hash into a seed, order sensitive.
+    triton::uint64 hashCombine(triton::uint64 seed, triton::uint64 value);
+
+    //! Combines the hashes of nodes regardless of their order, for commutative operators.
+    triton::uint64 hashUnordered(const std::vector<SharedAbstractNode>& nodes);
 
     //! Custom rotate left function for hash routine.
-    triton::uint512 rotl(const triton::uint512& value, triton::uint32 shift);
+    triton::uint64 rotl(triton::uint64 value, triton::uint32 shift);
+
+    //! Returns the mask of a bit-vector of `size` bits (64 bits at most).
+    triton::uint64 mask64(triton::uint32 size);
 
     //! Custom modular sign extend for bitwise operation.
     triton::sint512 modularSignExtend(AbstractNode* node);
@@ -8,13 +8,15 @@
 #ifndef TRITON_AST_CONTEXT_H
 #define TRITON_AST_CONTEXT_H
 
-#include <deque>
+#include <initializer_list>
 #include <list>
 #include <memory>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <triton/ast.hpp>
+#include <triton/astNodePool.hpp>
 #include <triton/astRepresentation.hpp>
 #include <triton/dllexport.hpp>
 #include <triton/exceptions.hpp>
@@ -61,8 +63,57 @@ namespace triton {
         //! Maps a concrete value and ast node for a variable name.
         std::unordered_map<std::string, std::pair<triton::ast::WeakAbstractNode, triton::uint512>> valueMapping;
 
-        //! The list of nodes
-        std::deque<SharedAbstractNode> nodes;
+        //! The number of old nodes swept by each call to garbage().
+        static const triton::usize garbageBudget = 1024;
+
+        //! The nodes kept since the last call to garbage() (young generation).
+        std::vector<SharedAbstractNode> youngNodes;
+
+        //! The nodes which survived a call to garbage() (old generation).
+        std::vector<SharedAbstractNode> oldNodes;
+
+        //! The position of the incremental sweep in the old generation.
+        triton::usize oldNodesCursor;
+
+        //! The slab pools used by the AST_SLAB_ALLOCATOR mode.
+        NodePool* pool;
+
+        //! The evaluation epoch, incremented by each update of a variable in the AST_LAZY_EVALUATION mode.
+        triton::uint64 epoch;
+
+        //! The unique table used by the hash-consing mode. Maps a structural key to the live nodes which have this key.
+        std::unordered_multimap<triton::uint64, WeakAbstractNode> uniqueTable;
+
+        //! The size of the unique table after its last sweep of dead entries.
+        triton::usize uniqueTableSwept;
+
+        //! Returns the structural key of a node (type, payload and children identity).
+        triton::uint64 getStructuralKey(AbstractNode* node) const;
+
+        //! Returns true if both nodes have the same type, size, payload and children (compared by identity).
+        bool isStructurallyIdentical(AbstractNode* node1, AbstractNode* node2) const;
+
+        //! Returns the node already interned with the same structure or interns this one.
+        SharedAbstractNode intern(const SharedAbstractNode& node);
+
+        //! Returns the live interned node with this key which matches, nullptr otherwise.
+        template <typename Match> SharedAbstractNode findInterned(triton::uint64 key, const Match& match);
+
+        //! Returns the live node of this type built on these children if hash-consing is enabled, nullptr otherwise. Called before a node is allocated.
+        SharedAbstractNode lookupNode(triton::ast::ast_e type, std::initializer_list<SharedAbstractNode> children);
+
+        //! Returns the live integer node of this value if hash-consing is enabled, nullptr otherwise.
+        SharedAbstractNode lookupInteger(const triton::uint512& value);
+
+        //! Returns the live reference node to this expression if hash-consing is enabled, nullptr otherwise.
+        SharedAbstractNode lookupReference(const triton::engines::symbolic::SharedSymbolicExpression& expr);
+
+        //! Allocates a node, from the slab pools if AST_SLAB_ALLOCATOR is enabled.
+        template <typename T, typename... Args> std::shared_ptr<T> newNode(Args&&... args) {
+          if (this->modes->isModeEnabled(triton::modes::AST_SLAB_ALLOCATOR))
+            return std::allocate_shared<T>(NodeAllocator<T>(this->pool), std::forward<Args>(args)...);
+          return std::make_shared<T>(std::forward<Args>(args)...);
+        }
 
         //! Returns simplified concatenation.
         SharedAbstractNode simplify_concat(std::vector<SharedAbstractNode> exprs);
@@ -83,9 +134,18 @@ namespace triton {
         //! Collect new nodes
         TRITON_EXPORT SharedAbstractNode collect(const SharedAbstractNode& node);
 
-        //! Garbage unused nodes.
+        //! Garbage unused nodes. The young generation is swept entirely, the old one by bounded steps.
         TRITON_EXPORT void garbage(void);
 
+        //! Opens a scope of the slab pools and returns true if AST_SLAB_ALLOCATOR is enabled. The nodes allocated in the scope are released in bulk if none of them survives it.
+        TRITON_EXPORT bool beginNodeScope(void);
+
+        //! Closes the scope opened by the last call to beginNodeScope() which returned true.
+        TRITON_EXPORT void endNodeScope(void);
+
+        //! Returns true if both ASTs have the same structure and payloads. Unlike equalTo(), a hash collision cannot make it true.
+        TRITON_EXPORT bool isStructurallyIdentical(const SharedAbstractNode& node1, const SharedAbstractNode& node2) const;
+
         //! AST C++ API - assert node builder
         TRITON_EXPORT SharedAbstractNode assert_(const SharedAbstractNode& expr);
 
@@ -193,7 +253,7 @@ namespace triton {
 
         //! AST C++ API - compound node builder
         template <typename T> SharedAbstractNode compound(const T& exprs) {
-          SharedAbstractNode node = std::make_shared<CompoundNode>(exprs, this->shared_from_this());
+          SharedAbstractNode node = this->newNode<CompoundNode>(exprs, this->shared_from_this());
           if (node == nullptr)
             throw triton::exceptions::Ast("Node builders - Not enough memory");
           node->init();
@@ -205,7 +265,7 @@ namespace triton {
 
         //! AST C++ API - concat node builder
         template <typename T> SharedAbstractNode concat(const T& exprs) {
-          SharedAbstractNode node = std::make_shared<ConcatNode>(exprs, this->shared_from_this());
+          SharedAbstractNode node = this->newNode<ConcatNode>(exprs, this->shared_from_this());
           if (node == nullptr)
             throw triton::exceptions::Ast("Node builders - Not enough memory");
           node->init();
@@ -241,7 +301,7 @@ namespace triton {
 
         //! AST C++ API - forall node builder
         template <typename T> SharedAbstractNode forall(const T& vars, const SharedAbstractNode& body) {
-          SharedAbstractNode node = std::make_shared<ForallNode>(vars, body);
+          SharedAbstractNode node = this->newNode<ForallNode>(vars, body);
           if (node == nullptr)
             throw triton::exceptions::Ast("Node builders - Not enough memory");
           node->init();
@@ -262,7 +322,7 @@ namespace triton {
 
         //! AST C++ API - land node builder
         template <typename T> SharedAbstractNode land(const T& exprs) {
-          SharedAbstractNode node = std::make_shared<LandNode>(exprs, this->shared_from_this());
+          SharedAbstractNode node = this->newNode<LandNode>(exprs, this->shared_from_this());
           if (node == nullptr)
             throw triton::exceptions::Ast("Node builders - Not enough memory");
           node->init();
@@ -280,7 +340,7 @@ namespace triton {
 
         //! AST C++ API - lor node builder
         template <typename T> SharedAbstractNode lor(const T& exprs) {
-          SharedAbstractNode node = std::make_shared<LorNode>(exprs, this->shared_from_this());
+          SharedAbstractNode node = this->newNode<LorNode>(exprs, this->shared_from_this());
           if (node == nullptr)
             throw triton::exceptions::Ast("Node builders - Not enough memory");
           node->init();
@@ -292,7 +352,7 @@ namespace triton {
 
         //! AST C++ API - lxor node builder
         template <typename T> SharedAbstractNode lxor(const T& exprs) {
-          SharedAbstractNode node = std::make_shared<LxorNode>(exprs, this->shared_from_this());
+          SharedAbstractNode node = this->newNode<LxorNode>(exprs, this->shared_from_this());
           if (node == nullptr)
             throw triton::exceptions::Ast("Node builders - Not enough memory");
           node->init();
@@ -326,6 +386,11 @@ namespace triton {
         //! Gets a variable value from its name.
         TRITON_EXPORT const triton::uint512& getVariableValue(const std::string& name) const;
 
+        //! Returns the current evaluation epoch.
+        triton::uint64 getEpoch(void) const {
+          return this->epoch;
+        }
+
         //! Sets the representation mode for this astContext
         TRITON_EXPORT void setRepresentationMode(triton::uint32 mode);
 
@@ -339,6 +404,36 @@ namespace triton {
     //! Shared AST context
     using SharedAstContext = std::shared_ptr<triton::ast::AstContext>;
 
+
+    //! \class NodeScope
+    /*! \brief Opens a scope of the slab pools of an AstContext for its lifetime. Does nothing if AST_SLAB_ALLOCATOR is disabled. */
+    class NodeScope {
+      private:
+        //! The AST context.
+        SharedAstContext astCtxt;
+
+        //! True if a scope has been opened.
+        bool opened;
+
+      public:
+        //! Constructor.
+        NodeScope(const SharedAstContext& astCtxt) : astCtxt(astCtxt) {
+          this->opened = astCtxt->beginNodeScope();
+        }
+
+        //! Destructor.
+        ~NodeScope() {
+          if (this->opened)
+            this->astCtxt->endNodeScope();
+        }
+
+        //! A scope cannot be copied.
+        NodeScope(const NodeScope&) = delete;
+
+        //! A scope cannot be copied.
+        NodeScope& operator=(const NodeScope&) = delete;
+    };
+
   /*! @} End of ast namespace */
   };
 /*! @} End of triton namespace */
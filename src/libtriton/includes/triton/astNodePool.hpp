@@ -0,0 +1,190 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the Apache License 2.0.
+*/
+
+#ifndef TRITON_AST_NODE_POOL_H
+#define TRITON_AST_NODE_POOL_H
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include <triton/dllexport.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  //! The AST namespace
+  namespace ast {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup ast
+   *  @{
+   */
+
+    //! \class NodePool
+    /*! \brief Slab pools used to allocate AST nodes.
+     *
+     * \details Each size class (and thus each node type) has its own slabs. Blocks are
+     * carved out of the current slab of their class, so nodes built one after the other
+     * are contiguous in memory. A freed block goes back to the free list of its class
+     * and slabs are released in bulk, when the pool has been released by its owner
+     * and its last block has been freed.
+     *
+     * Scopes (e.g. one per instruction) own the blocks carved while they are open. When
+     * a scope ends and none of its blocks is alive, its slabs are freed and the cursors
+     * are rewound in bulk. Otherwise, its blocks are handed over to the enclosing scope.
+     * All methods are serialized by a lock, so nodes may be freed from any thread.
+     */
+    class NodePool {
+      private:
+        //! The granularity of size classes.
+        static const triton::usize granularity = 16;
+
+        //! The number of size classes. Bigger blocks are allocated with the global operator new.
+        static const triton::usize classes = 64;
+
+        //! The size of a slab.
+        static const triton::usize slabSize = 64 * 1024;
+
+        //! A free block.
+        struct FreeBlock {
+          FreeBlock* next;
+        };
+
+        //! Free blocks of each class.
+        FreeBlock* freeLists[classes];
+
+        //! Current position in the slab of each class.
+        triton::uint8* cursors[classes];
+
+        //! End of the slab of each class.
+        triton::uint8* limits[classes];
+
+        //! All slabs allocated by the pool, in allocation order.
+        std::vector<triton::uint8*> slabs;
+
+        //! The depth of the scope which owns each slab (0 if no open scope owns it), by address.
+        std::map<triton::uint8*, triton::usize> owners;
+
+        //! An open scope.
+        struct Scope {
+          //! Free blocks of each class carved by the scope.
+          FreeBlock* freeLists[classes];
+
+          //! The position of each class when the scope began. The scope owns the rest of these slabs.
+          triton::uint8* marks[classes];
+
+          //! The end of the slab of each class when the scope began.
+          triton::uint8* limits[classes];
+
+          //! The index of the first slab allocated by the scope.
+          triton::usize slabs;
+
+          //! The number of blocks of the scope currently allocated.
+          triton::usize live;
+        };
+
+        //! The open scopes, innermost last.
+        std::vector<Scope> scopes;
+
+        //! The number of blocks currently allocated.
+        triton::usize live;
+
+        //! True if the owner released the pool.
+        bool released;
+
+        //! Serializes the accesses to the pool.
+        mutable std::mutex lock;
+
+        //! Returns the depth of the open scope which owns a block of class `cls` (0 if no open scope owns it).
+        triton::usize findScope(void* ptr, triton::usize cls) const;
+
+        //! Destructor. Use release() instead.
+        ~NodePool();
+
+      public:
+        //! Constructor.
+        TRITON_EXPORT NodePool();
+
+        //! Allocates a block of `size` bytes.
+        TRITON_EXPORT void* allocate(triton::usize size);
+
+        //! Frees a block of `size` bytes.
+        TRITON_EXPORT void deallocate(void* ptr, triton::usize size);
+
+        //! Returns the number of blocks currently allocated.
+        TRITON_EXPORT triton::usize getNumberOfBlocks(void) const;
+
+        //! Returns the memory held by slabs (in bytes).
+        TRITON_EXPORT triton::usize getMemoryUsage(void) const;
+
+        //! Releases the pool. Slabs are freed as soon as all blocks are freed.
+        TRITON_EXPORT void release(void);
+
+        //! Opens a scope. Blocks carved until endScope() belong to it.
+        TRITON_EXPORT void beginScope(void);
+
+        //! Closes the innermost scope. Its memory is released in bulk if none of its blocks is alive.
+        TRITON_EXPORT void endScope(void);
+    };
+
+
+    //! \class NodeAllocator
+    /*! \brief STL allocator over a NodePool, used with `std::allocate_shared`. */
+    template <typename T>
+    class NodeAllocator {
+      template <typename U> friend class NodeAllocator;
+
+      private:
+        //! The pool used.
+        NodePool* pool;
+
+      public:
+        //! The allocated type.
+        using value_type = T;
+
+        //! Constructor.
+        NodeAllocator(NodePool* pool) : pool(pool) {}
+
+        //! Constructor by copy of another type.
+        template <typename U> NodeAllocator(const NodeAllocator<U>& other) : pool(other.pool) {}
+
+        //! Allocates `n` objects.
+        T* allocate(std::size_t n) {
+          return static_cast<T*>(this->pool->allocate(n * sizeof(T)));
+        }
+
+        //! Frees `n` objects.
+        void deallocate(T* ptr, std::size_t n) {
+          this->pool->deallocate(ptr, n * sizeof(T));
+        }
+
+        //! Returns true if both allocators use the same pool.
+        template <typename U> bool operator==(const NodeAllocator<U>& other) const {
+          return this->pool == other.pool;
+        }
+
+        //! Returns true if allocators use different pools.
+        template <typename U> bool operator!=(const NodeAllocator<U>& other) const {
+          return this->pool != other.pool;
+        }
+    };
+
+  /*! @} End of ast namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_AST_NODE_POOL_H */
@@ -0,0 +1,177 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the Apache License 2.0.
+*/
+
+#ifndef TRITON_AST_PROGRAM_H
+#define TRITON_AST_PROGRAM_H
+
+#include <unordered_map>
+#include <vector>
+
+#include <triton/ast.hpp>
+#include <triton/dllexport.hpp>
+#include <triton/symbolicVariable.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  //! The AST namespace
+  namespace ast {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup ast
+   *  @{
+   */
+
+    //! \class AstProgram
+    /*! \brief An AST compiled into a linear program.
+     *
+     * \details The DAG is flattened into a topologically ordered array of instructions
+     * working on native 64-bit slots. Shared nodes are computed once, references are
+     * followed and sub-trees without symbolic variable are folded into constants. Values
+     * of variables are given as a vector ordered as getVariables(), that is by variable
+     * id. Only bit-vectors up to 64 bits are supported. A program keeps its own slots, so
+     * an instance must not be evaluated by several threads at the same time.
+     */
+    class AstProgram {
+      private:
+        //! The opcodes of the program.
+        enum opcode_e {
+          OP_ADD,
+          OP_AND,
+          OP_ASHR,
+          OP_CONCAT,
+          OP_EQ,
+          OP_EXTRACT,
+          OP_ITE,
+          OP_LSHR,
+          OP_MUL,
+          OP_NAND,
+          OP_NE,
+          OP_NEG,
+          OP_NOR,
+          OP_NOT,
+          OP_OR,
+          OP_ROL,
+          OP_SDIV,
+          OP_SGE,
+          OP_SGT,
+          OP_SHL,
+          OP_SLE,
+          OP_SLT,
+          OP_SMOD,
+          OP_SREM,
+          OP_SUB,
+          OP_SX,
+          OP_UDIV,
+          OP_UGE,
+          OP_UGT,
+          OP_ULE,
+          OP_ULT,
+          OP_UREM,
+          OP_XNOR,
+          OP_XOR,
+        };
+
+        //! An instruction of the program.
+        struct Instruction {
+          //! The opcode.
+          triton::uint32 opcode;
+
+          //! The size of operands.
+          triton::uint32 size;
+
+          //! The immediate operand (rotation, shift or low bit).
+          triton::uint32 imm;
+
+          //! The destination slot.
+          triton::uint32 dst;
+
+          //! The source slots.
+          triton::uint32 src[3];
+
+          //! The mask of the result.
+          triton::uint64 mask;
+        };
+
+        //! The instructions in topological order.
+        std::vector<Instruction> instructions;
+
+        //! The number of lanes of a batch block.
+        static const triton::usize lanes = 64;
+
+        //! The slots. Constants are set once at compile time.
+        std::vector<triton::uint64> slots;
+
+        //! The slots of a batch block, `lanes` values per slot.
+        std::vector<triton::uint64> laneSlots;
+
+        //! The symbolic variables ordered by id, as the input vector.
+        std::vector<triton::engines::symbolic::SharedSymbolicVariable> variables;
+
+        //! The slot of each variable.
+        std::vector<triton::uint32> variableSlots;
+
+        //! The mask of each variable.
+        std::vector<triton::uint64> variableMasks;
+
+        //! The slot of the result.
+        triton::uint32 result;
+
+        //! The size of the result.
+        triton::uint32 size;
+
+        //! Allocates a new slot.
+        triton::uint32 newSlot(triton::uint64 value=0);
+
+        //! Emits an instruction and returns its destination slot.
+        triton::uint32 emit(opcode_e opcode, triton::uint32 size, triton::uint64 mask, triton::uint32 src0, triton::uint32 src1=0, triton::uint32 src2=0, triton::uint32 imm=0);
+
+        //! Executes an instruction on scalar operands.
+        static triton::uint64 execute(const Instruction& inst, triton::uint64 a, triton::uint64 b, triton::uint64 c);
+
+        //! Compiles a node whose children are already compiled.
+        triton::uint32 compile(AbstractNode* node, std::unordered_map<AbstractNode*, triton::uint32>& compiled, std::unordered_map<triton::usize, triton::uint32>& vars);
+
+      public:
+        //! Constructor. Compiles the given node.
+        TRITON_EXPORT AstProgram(const SharedAbstractNode& node);
+
+        //! Returns the symbolic variables, in the order expected by evaluate().
+        TRITON_EXPORT const std::vector<triton::engines::symbolic::SharedSymbolicVariable>& getVariables(void) const;
+
+        //! Returns the size (in bits) of the result.
+        TRITON_EXPORT triton::uint32 getBitvectorSize(void) const;
+
+        //! Returns the number of instructions of the program.
+        TRITON_EXPORT triton::usize getNumberOfInstructions(void) const;
+
+        //! Evaluates the program. `values[i]` is the value of the i-th variable.
+        TRITON_EXPORT triton::uint64 evaluate(const std::vector<triton::uint64>& values);
+
+        //! Evaluates the program. `values` must hold one value per variable.
+        TRITON_EXPORT triton::uint64 evaluate(const triton::uint64* values);
+
+        //! Evaluates the program on several assignments. Each assignment holds one value per variable.
+        TRITON_EXPORT std::vector<triton::uint64> evaluateBatch(const std::vector<std::vector<triton::uint64>>& assignments);
+
+        //! Evaluates the program on `count` assignments. `values[i * count + j]` is the value of the i-th variable in the j-th assignment.
+        TRITON_EXPORT void evaluateBatch(const triton::uint64* values, triton::usize count, triton::uint64* results);
+    };
+
+  /*! @} End of ast namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_AST_PROGRAM_H */
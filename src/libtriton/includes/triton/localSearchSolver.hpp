@@ -0,0 +1,180 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the Apache License 2.0.
+*/
+
+#ifndef TRITON_LOCALSEARCHSOLVER_H
+#define TRITON_LOCALSEARCHSOLVER_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <triton/ast.hpp>
+#include <triton/astProgram.hpp>
+#include <triton/dllexport.hpp>
+#include <triton/solverEnums.hpp>
+#include <triton/solverInterface.hpp>
+#include <triton/solverModel.hpp>
+#include <triton/symbolicVariable.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+  //! The Engines namespace
+  namespace engines {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup engines
+   *  @{
+   */
+    //! The Solver namespace
+    namespace solver {
+    /*!
+     *  \ingroup engines
+     *  \addtogroup solver
+     *  @{
+     */
+
+      //! \class LocalSearchSolver
+      /*! \brief Solver engine searching models by mutating symbolic variables.
+       *
+       * \details The query is turned into a fitness function which is 0 when the query is
+       * satisfied: conjunctions sum the fitness of their operands, disjunctions take the
+       * smallest one and comparisons give a distance between their operands (the number of
+       * different bits for an equality, the magnitude of the gap for an inequality). Operands
+       * are evaluated concretely by AstProgram. Starting from the concrete values of the
+       * variables, the search climbs down the fitness by steps along the gradient of each
+       * variable, bit flips and constants of the query, and restarts from random mutations
+       * when it is stuck. No SMT solver is involved, so queries are either SAT or UNKNOWN
+       * (TIMEOUT once the timeout is reached). Only bit-vectors up to 64 bits are supported.
+       */
+      class LocalSearchSolver : public SolverInterface {
+        private:
+          //! The kinds of objectives.
+          enum objective_e {
+            OBJ_AND,   //!< All children hold.
+            OBJ_OR,    //!< One child holds.
+            OBJ_EQ,    //!< lhs == rhs
+            OBJ_NE,    //!< lhs != rhs
+            OBJ_ULT,   //!< lhs < rhs (unsigned)
+            OBJ_ULE,   //!< lhs <= rhs (unsigned)
+            OBJ_TRUE,  //!< The predicate holds.
+            OBJ_FALSE, //!< The predicate does not hold.
+          };
+
+          //! A node of the fitness function.
+          struct Objective {
+            //! The kind of the objective.
+            objective_e kind;
+
+            //! Xor-ed onto both operands, turns a signed comparison into an unsigned one.
+            triton::uint64 sign;
+
+            //! The children objectives of a conjunction or a disjunction.
+            std::vector<triton::usize> children;
+
+            //! The programs of the operands of a comparison, or of the predicate.
+            std::vector<triton::usize> programs;
+          };
+
+          //! A query being searched.
+          struct Query {
+            //! The compiled operands and predicates.
+            std::vector<std::unique_ptr<triton::ast::AstProgram>> programs;
+
+            //! For each program, the index of each of its variables in `variables`.
+            std::vector<std::vector<triton::usize>> inputs;
+
+            //! The objectives, the root one is the last.
+            std::vector<Objective> objectives;
+
+            //! The symbolic variables of the query.
+            std::vector<triton::engines::symbolic::SharedSymbolicVariable> variables;
+
+            //! The index of each variable in `variables`, by id.
+            std::unordered_map<triton::usize, triton::usize> indexes;
+
+            //! The mask of each variable.
+            std::vector<triton::uint64> masks;
+
+            //! The constants of the query, tried as values of variables.
+            std::vector<triton::uint64> dictionary;
+
+            //! A buffer holding the inputs of a program.
+            std::vector<triton::uint64> buffer;
+          };
+
+          //! The solver timeout. By default, unlimited. This global timeout may be changed for a specific query (isSat/getModel/getModels) via argument `timeout`.
+          triton::uint32 timeout;
+
+          //! The max number of evaluations of the fitness function of a query.
+          triton::usize maxEvaluations;
+
+          //! Compiles a node and returns the index of its program.
+          triton::usize addProgram(Query& query, const triton::ast::SharedAbstractNode& node) const;
+
+          //! Builds the objective of a logical node and returns its index.
+          triton::usize addObjective(Query& query, const triton::ast::SharedAbstractNode& node, bool negate) const;
+
+          //! Evaluates a program on an assignment of the query variables.
+          triton::uint64 evaluate(Query& query, triton::usize program, const std::vector<triton::uint64>& values) const;
+
+          //! Returns the fitness of an objective, 0 if it holds.
+          triton::uint64 getFitness(Query& query, triton::usize objective, const std::vector<triton::uint64>& values) const;
+
+        public:
+          //! Constructor.
+          TRITON_EXPORT LocalSearchSolver();
+
+          //! Computes and returns a model from a symbolic constraint. State is returned in the `status` pointer as well as the solving time. A `timeout` can also be defined.
+          /*! \brief map of symbolic variable id -> model
+           *
+           * \details
+           * **item1**: symbolic variable id<br>
+           * **item2**: model
+           */
+          TRITON_EXPORT std::unordered_map<triton::usize, SolverModel> getModel(const triton::ast::SharedAbstractNode& node, triton::engines::solver::status_e* status = nullptr, triton::uint32 timeout = 0, triton::uint32* solvingTime = nullptr) const;
+
+          //! Computes and returns several models from a symbolic constraint. The `limit` is the number of models returned. State is returned in the `status` pointer as well as the solving time. A `timeout` can also be defined.
+          /*! \brief vector of map of symbolic variable id -> model
+           *
+           * \details
+           * **item1**: symbolic variable id<br>
+           * **item2**: model
+           */
+          TRITON_EXPORT std::vector<std::unordered_map<triton::usize, SolverModel>> getModels(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, triton::engines::solver::status_e* status = nullptr, triton::uint32 timeout = 0, triton::uint32* solvingTime = nullptr) const;
+
+          //! Returns true if an expression is satisfiable.
+          TRITON_EXPORT bool isSat(const triton::ast::SharedAbstractNode& node, triton::engines::solver::status_e* status = nullptr, triton::uint32 timeout = 0, triton::uint32* solvingTime = nullptr) const;
+
+          //! Returns the name of this solver.
+          TRITON_EXPORT std::string getName(void) const;
+
+          //! Defines a solver timeout (in milliseconds).
+          TRITON_EXPORT void setTimeout(triton::uint32 ms);
+
+          //! Defines a solver memory consumption limit (in megabytes). Not used by this solver.
+          TRITON_EXPORT void setMemoryLimit(triton::uint32 mem);
+
+          //! Defines the max number of evaluations of the fitness function of a query.
+          TRITON_EXPORT void setMaxEvaluations(triton::usize count);
+      };
+
+    /*! @} End of solver namespace */
+    };
+  /*! @} End of engines namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_LOCALSEARCHSOLVER_H */
@@ -28,11 +28,15 @@ namespace triton {
     //! Enumerates all kinds of mode.
     enum mode_e {
       ALIGNED_MEMORY,                 //!< [symbolic] Keep a map of aligned memory.
+      AST_HASH_CONSING,               //!< [AST] Share structurally identical nodes instead of allocating duplicates (hash-consing).
+      AST_LAZY_EVALUATION,            //!< [AST] Evaluate nodes on demand when variables change instead of updating all their ancestors.
       AST_OPTIMIZATIONS,              //!< [AST] Classical arithmetic optimisations to reduce the depth of the trees.
+      AST_SLAB_ALLOCATOR,             //!< [AST] Allocate nodes from slab pools owned by the AST context instead of the global heap.
       CONCRETIZE_UNDEFINED_REGISTERS, //!< [symbolic] Concretize every registers tagged as undefined (see #750).
       CONSTANT_FOLDING,               //!< [symbolic] Perform a constant folding optimization of sub ASTs which do not contain symbolic variables.
       ONLY_ON_SYMBOLIZED,             //!< [symbolic] Perform symbolic execution only on symbolized expressions.
       ONLY_ON_TAINTED,                //!< [symbolic] Perform symbolic execution only on tainted instructions.
+      PC_DEDUPLICATION,               //!< [symbolic] Skip path constraints equal to one already pushed by the same branch instruction.
       PC_TRACKING_SYMBOLIC,           //!< [symbolic] Track path constraints only if they are symbolized.
       SYMBOLIZE_INDEX_ROTATION,       //!< [symbolic] Symbolize index rotation for bvrol and bvror (see #751). This mode increases the complexity of solving.
       TAINT_THROUGH_POINTERS,         //!< [taint] Spread the taint if an index pointer is already tainted (see #725).
@@ -0,0 +1,152 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the Apache License 2.0.
+*/
+
+#ifndef TRITON_PAGEDMEMORY_HPP
+#define TRITON_PAGEDMEMORY_HPP
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <triton/dllexport.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  //! The Triton namespace
+  namespace arch {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup arch
+   *  @{
+   */
+
+    /*! \class PagedMemory
+     *  \brief The concrete memory of a CPU.
+     *
+     *  \details Bytes are stored in 4 KiB pages, each page keeping a bitmap of its defined bytes.
+     *  Pages are found through a two-level radix lookup: a hash table of directories covering
+     *  16 MiB each, then an array of 4096 pages per directory. The last page found is cached,
+     *  as consecutive accesses tend to hit the same page. Undefined bytes read as 0.
+     *
+     *  A page reads its bytes through a pointer, which may point into a mapped area (e.g. a
+     *  memory-mapped file) instead of its own storage. Mapped bytes are read in place and are
+     *  never written: the first write to a mapped page copies it (copy-on-write).
+     */
+    class PagedMemory {
+      private:
+        //! The number of bits of a page offset.
+        static const triton::uint32 pageBits = 12;
+
+        //! The number of bits of a page index in a directory.
+        static const triton::uint32 directoryBits = 12;
+
+        //! The size of a page.
+        static const triton::usize pageSize = 1 << pageBits;
+
+        //! A page of memory.
+        struct Page {
+          //! The bytes of the page, in its storage, in a mapped area or in the zero page.
+          const triton::uint8* data;
+
+          //! The storage of the page, null until the page is written.
+          std::unique_ptr<triton::uint8[]> storage;
+
+          //! Keeps the mapped area of the page alive, if any.
+          std::shared_ptr<const void> owner;
+
+          //! A bit per byte, set if the byte is defined.
+          triton::uint64 defined[pageSize / 64];
+
+          //! The number of defined bytes.
+          triton::usize count;
+        };
+
+        //! The pages of 16 MiB of memory.
+        struct Directory {
+          //! The pages, null if none of their bytes is defined.
+          std::unique_ptr<Page> pages[1 << directoryBits];
+
+          //! The number of allocated pages.
+          triton::usize count;
+        };
+
+        //! The bytes of a new page.
+        static const triton::uint8 zeroPage[pageSize];
+
+        //! The directories, by address >> 24.
+        std::unordered_map<triton::uint64, std::unique_ptr<Directory>, IdentityHash<triton::uint64>> directories;
+
+        //! The page number of the last page found.
+        mutable triton::uint64 lastNumber;
+
+        //! The last page found, null if none.
+        mutable Page* lastPage;
+
+        //! Returns the page holding an address, null if it is not allocated.
+        Page* findPage(triton::uint64 addr) const;
+
+        //! Returns the page holding an address, allocating it if needed.
+        Page* getPage(triton::uint64 addr);
+
+        //! Frees the page holding an address.
+        void freePage(triton::uint64 addr);
+
+        //! Returns the storage of a page, copying its bytes into a new storage if needed.
+        triton::uint8* getStorage(Page* page);
+
+      public:
+        //! Constructor.
+        TRITON_EXPORT PagedMemory();
+
+        //! Constructor by copy.
+        TRITON_EXPORT PagedMemory(const PagedMemory& other);
+
+        //! Copies a PagedMemory.
+        TRITON_EXPORT PagedMemory& operator=(const PagedMemory& other);
+
+        //! Undefines all the bytes.
+        TRITON_EXPORT void clear(void);
+
+        //! Returns true if all the bytes of a range are defined.
+        TRITON_EXPORT bool isDefined(triton::uint64 addr, triton::usize size) const;
+
+        //! Returns a byte, 0 if it is undefined.
+        TRITON_EXPORT triton::uint8 read(triton::uint64 addr) const;
+
+        //! Reads a range of bytes into `dst`, undefined bytes are 0.
+        TRITON_EXPORT void read(triton::uint64 addr, triton::uint8* dst, triton::usize size) const;
+
+        //! Defines a byte.
+        TRITON_EXPORT void write(triton::uint64 addr, triton::uint8 value);
+
+        //! Defines a range of bytes from `src`.
+        TRITON_EXPORT void write(triton::uint64 addr, const triton::uint8* src, triton::usize size);
+
+        //! Undefines a range of bytes.
+        TRITON_EXPORT void erase(triton::uint64 addr, triton::usize size);
+
+        //! Defines a range of bytes from `area` without copying its whole pages. `owner` keeps `area` alive, if null `area` must outlive the mapping.
+        TRITON_EXPORT void map(triton::uint64 addr, const triton::uint8* area, triton::usize size, const std::shared_ptr<const void>& owner=nullptr);
+
+        //! Maps `size` bytes of a file from `offset` into the address space of the process, read-only. The bytes live as long as the returned pointer.
+        TRITON_EXPORT static std::shared_ptr<const triton::uint8> mapFile(const std::string& path, triton::uint64 offset, triton::usize size);
+    };
+
+  /*! @} End of arch namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_PAGEDMEMORY_HPP */
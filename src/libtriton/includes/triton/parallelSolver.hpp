@@ -0,0 +1,116 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the Apache License 2.0.
+*/
+
+#ifndef TRITON_PARALLELSOLVER_H
+#define TRITON_PARALLELSOLVER_H
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include <triton/dllexport.hpp>
+#include <triton/pathConstraint.hpp>
+#include <triton/solverEnums.hpp>
+#include <triton/solverModel.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+  //! The Engines namespace
+  namespace engines {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup engines
+   *  @{
+   */
+    //! The Solver namespace
+    namespace solver {
+    /*!
+     *  \ingroup engines
+     *  \addtogroup solver
+     *  @{
+     */
+
+      //! \class ParallelSolver
+      /*! \brief Solves the branches not taken by a path on a pool of threads.
+       *
+       * \details For each branch not taken by a path constraint, the query is the branch
+       * predicate under the path constraints which precede it. Queries are dispatched in
+       * path order to worker threads, each owning an incremental z3 session, so a worker only
+       * asserts the path constraints it does not hold yet. Answers are given back to the
+       * calling thread as soon as they complete. Workers only read the ASTs, which must not
+       * be modified until flip() returns. Only available with the z3 interface.
+       *
+       * When a query has no model under the full prefix, the policy allows weaker retries:
+       * first the path constraints sharing variables with the branch (only if the full
+       * query was not UNSAT, as both are then equisatisfiable), then the branch alone. Each
+       * answer says which constraints gave it.
+       */
+      class ParallelSolver {
+        public:
+          //! The answer to a branch query.
+          struct Result {
+            //! The index of the path constraint.
+            triton::usize index;
+
+            //! The source address of the branch.
+            triton::uint64 srcAddr;
+
+            //! The destination address of the branch.
+            triton::uint64 dstAddr;
+
+            //! The status of the query.
+            triton::engines::solver::status_e status;
+
+            //! The solving time (in milliseconds).
+            triton::uint32 solvingTime;
+
+            //! The model, empty if the branch cannot be taken.
+            std::unordered_map<triton::usize, SolverModel> model;
+
+            //! The path constraints the answer was computed with.
+            triton::engines::solver::policy_e strategy;
+          };
+
+          //! The callback receiving answers.
+          using Callback = std::function<void(const Result&)>;
+
+        private:
+          //! The number of worker threads, 0 for one per core.
+          triton::uint32 threads;
+
+          //! The timeout of each query (in milliseconds), 0 for unlimited.
+          triton::uint32 timeout;
+
+          //! The memory limit of each worker (in megabytes), 0 for unlimited.
+          triton::uint32 memoryLimit;
+
+          //! The weakest path constraints given to the solver.
+          triton::engines::solver::policy_e policy;
+
+        public:
+          //! Constructor.
+          TRITON_EXPORT ParallelSolver(triton::uint32 threads=0, triton::uint32 timeout=0, triton::uint32 memoryLimit=0, triton::engines::solver::policy_e policy=triton::engines::solver::POLICY_FULL);
+
+          //! Solves each branch not taken by the path and calls `callback` on the calling thread for each answer, in completion order.
+          TRITON_EXPORT void flip(const std::vector<triton::engines::symbolic::PathConstraint>& pcs, const std::vector<triton::usize>& stamps, const Callback& callback) const;
+      };
+
+    /*! @} End of solver namespace */
+    };
+  /*! @} End of engines namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_PARALLELSOLVER_H */
@@ -0,0 +1,135 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the Apache License 2.0.
+*/
+
+#ifndef TRITON_PATHCONSTRAINTLOG_H
+#define TRITON_PATHCONSTRAINTLOG_H
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <triton/ast.hpp>
+#include <triton/astContext.hpp>
+#include <triton/dllexport.hpp>
+#include <triton/pathConstraint.hpp>
+#include <triton/symbolicExpression.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  //! The Engines namespace
+  namespace engines {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup engines
+   *  @{
+   */
+
+    //! The Symbolic Execution namespace
+    namespace symbolic {
+    /*!
+     *  \ingroup engines
+     *  \addtogroup symbolic
+     *  @{
+     */
+
+      /*! \class PathConstraintLog
+          \brief An append-only file of path constraints.
+
+          \details Path constraints are written as compact records holding the DAG of their branch predicates.
+          References are not unrolled: the expression of a reference is written once, in its own record, before
+          the first record using it. Written path constraints can then be released from memory and read back
+          later, as new ASTs sharing the symbolic expressions which are still alive. Symbolic variables are
+          kept in memory, so read back ASTs use the same variables.
+      */
+      class PathConstraintLog {
+        private:
+          //! A node read back from the file.
+          struct Node {
+            //! The kind of the node.
+            triton::ast::ast_e kind;
+
+            //! The indexes of its children.
+            std::vector<triton::usize> children;
+
+            //! The value of an integer node.
+            triton::uint512 value;
+
+            //! The symbolic variable id of a variable node, or the symbolic expression id of a reference node.
+            triton::usize id;
+
+            //! The value of a string node.
+            std::string string;
+          };
+
+          //! AstContext API
+          triton::ast::SharedAstContext astCtxt;
+
+          //! The file.
+          std::fstream file;
+
+          //! The offset of the record of each written symbolic expression, by id.
+          std::unordered_map<triton::usize, triton::uint64> definitions;
+
+          //! The written symbolic expressions, by id. Read back ASTs share them while they are alive.
+          std::unordered_map<triton::usize, std::weak_ptr<SymbolicExpression>> expressions;
+
+          //! The variable nodes of written ASTs, by symbolic variable id.
+          std::unordered_map<triton::usize, triton::ast::SharedAbstractNode> variables;
+
+          //! Appends a record to the file and returns its offset.
+          triton::uint64 append(const std::string& payload);
+
+          //! Reads the payload of a record.
+          void load(triton::uint64 offset, std::string& payload);
+
+          //! Writes the records of the symbolic expressions referenced by ASTs and not written yet.
+          void writeDefinitions(const std::vector<triton::ast::SharedAbstractNode>& roots);
+
+          //! Writes the nodes of ASTs into a payload and returns the indexes of their roots. References must be written.
+          std::vector<triton::usize> writeNodes(std::string& payload, const std::vector<triton::ast::SharedAbstractNode>& roots);
+
+          //! Reads the nodes of a payload.
+          std::vector<Node> readNodes(const std::string& payload, triton::usize& pos) const;
+
+          //! Reads back the symbolic expressions referenced by nodes which are not in `resolved` yet.
+          void resolve(const std::vector<Node>& nodes, std::unordered_map<triton::usize, SharedSymbolicExpression>& resolved);
+
+          //! Builds the ASTs of nodes. References must be resolved.
+          std::vector<triton::ast::SharedAbstractNode> buildNodes(const std::vector<Node>& nodes, const std::unordered_map<triton::usize, SharedSymbolicExpression>& resolved) const;
+
+        public:
+          //! Constructor. The file is created, or truncated if it exists.
+          TRITON_EXPORT PathConstraintLog(const std::string& path, const triton::ast::SharedAstContext& astCtxt);
+
+          //! Writes a path constraint and returns the offset of its record.
+          TRITON_EXPORT triton::uint64 write(const triton::engines::symbolic::PathConstraint& pco);
+
+          //! Reads back the path constraint of a record.
+          TRITON_EXPORT triton::engines::symbolic::PathConstraint read(triton::uint64 offset);
+      };
+
+      //! Shared Path Constraint Log
+      using SharedPathConstraintLog = std::shared_ptr<triton::engines::symbolic::PathConstraintLog>;
+
+    /*! @} End of symbolic namespace */
+    };
+  /*! @} End of engines namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_PATHCONSTRAINTLOG_H */
@@ -8,12 +8,14 @@
 #ifndef TRITON_PATHMANAGER_H
 #define TRITON_PATHMANAGER_H
 
+#include <unordered_map>
 #include <vector>
 
 #include <triton/dllexport.hpp>
 #include <triton/instruction.hpp>
 #include <triton/modes.hpp>
 #include <triton/pathConstraint.hpp>
+#include <triton/pathConstraintLog.hpp>
 #include <triton/symbolicExpression.hpp>
 #include <triton/tritonTypes.hpp>
 
@@ -46,29 +48,83 @@ namespace triton {
           \brief The path manager class. */
       class PathManager {
         private:
+          //! The path constraints pushed by a branch instruction.
+          struct PathConstraintSite {
+            //! The stamps of its path constraints, in path order.
+            std::vector<triton::usize> stamps;
+
+            //! The taken predicates of its path constraints, by hash.
+            std::unordered_multimap<triton::uint64, triton::ast::SharedAbstractNode> predicates;
+          };
+
           //! Modes API.
           triton::modes::SharedModes modes;
 
           //! AstContext API
           triton::ast::SharedAstContext astCtxt;
 
+          //! The max number of path constraints pushed per branch instruction. By default, unlimited (0).
+          triton::usize maxPathConstraintsPerSite;
+
+          //! The path constraints of each branch instruction, by address.
+          std::unordered_map<triton::uint64, PathConstraintSite> pathConstraintSites;
+
+          //! Pushes the path constraint of a branch instruction, unless it is filtered by the site policy.
+          void addPathConstraint(triton::uint64 srcAddr, const triton::engines::symbolic::PathConstraint& pco);
+
+          //! The log of the path constraints released from memory, if enabled.
+          triton::engines::symbolic::SharedPathConstraintLog pathConstraintLog;
+
+          //! The number of path constraints kept in memory when the log is enabled. 0 if the log is only read (copies).
+          triton::usize pathConstraintWindow;
+
+          //! The offsets of the logged path constraints in the log, in path order.
+          std::vector<triton::uint64> loggedPathConstraints;
+
+          //! Moves the oldest path constraints to the log once the window is full.
+          void logPathConstraints(void);
+
         protected:
           //! \brief The logical conjunction vector of path constraints.
           std::vector<triton::engines::symbolic::PathConstraint> pathConstraints;
 
+          //! The stamp of each path constraint. A new stamp is given at each push.
+          std::vector<triton::usize> pathConstraintStamps;
+
+          //! The ids of the symbolic variables of path constraints, computed on demand and keyed by stamp.
+          mutable std::unordered_map<triton::usize, std::vector<triton::usize>> pathConstraintVariables;
+
+          //! The chunks of the path predicate, computed on demand. The chunk `i` of `level` is the conjunction of the path constraints [i * 64^(level+1), (i+1) * 64^(level+1)).
+          mutable std::vector<std::vector<triton::ast::SharedAbstractNode>> pathPredicateChunks;
+
+          //! Returns a chunk of the path predicate.
+          triton::ast::SharedAbstractNode getPathPredicateChunk(triton::usize level, triton::usize index) const;
+
+          //! Pushes a path constraint with a new stamp.
+          void addPathConstraint(const triton::engines::symbolic::PathConstraint& pco);
+
+          //! Returns the ids of the symbolic variables of the path constraint at `index`.
+          const std::vector<triton::usize>& getVariablesOfPathConstraint(triton::usize index) const;
+
         public:
           //! Constructor.
           TRITON_EXPORT PathManager(const triton::modes::SharedModes& modes, const triton::ast::SharedAstContext& astCtxt);
 
-          //! Constructor by copy.
+          //! Constructor by copy. The copy does not log path constraints, it only reads back those logged before the copy.
           TRITON_EXPORT PathManager(const PathManager& other);
 
-          //! Copies a PathManager.
+          //! Copies a PathManager. The copy does not log path constraints, it only reads back those logged before the copy.
           TRITON_EXPORT PathManager& operator=(const PathManager& other);
 
           //! Returns the size of the path constraints
           TRITON_EXPORT triton::usize getSizeOfPathConstraints(void) const;
 
+          //! Returns the number of path constraints moved to the log.
+          TRITON_EXPORT triton::usize getSizeOfLoggedPathConstraints(void) const;
+
+          //! Reads back the logged path constraints from a given range. They are older than the path constraints in memory.
+          TRITON_EXPORT std::vector<triton::engines::symbolic::PathConstraint> getLoggedPathConstraints(triton::usize start, triton::usize end) const;
+
           //! Returns the logical conjunction vector of path constraints.
           TRITON_EXPORT const std::vector<triton::engines::symbolic::PathConstraint>& getPathConstraints(void) const;
 
@@ -78,9 +134,18 @@ namespace triton {
           //! Returns the logical conjunction vector of path constraint of a given thread.
           TRITON_EXPORT std::vector<triton::engines::symbolic::PathConstraint> getPathConstraintsOfThread(triton::uint32 threadId) const;
 
+          //! Returns the stamp of each path constraint. Stamps are unique, so equal stamps at an index mean that both paths are equal up to this index.
+          TRITON_EXPORT const std::vector<triton::usize>& getPathConstraintStamps(void) const;
+
           //! Returns the current path predicate as an AST of logical conjunction of each taken branch.
           TRITON_EXPORT triton::ast::SharedAbstractNode getPathPredicate(void) const;
 
+          //! Returns the logical conjunction of the first `prefix` taken branches.
+          TRITON_EXPORT triton::ast::SharedAbstractNode getPathPredicate(triton::usize prefix) const;
+
+          //! Returns the conjunction of `node` and of the first `prefix` path constraints which share symbolic variables with it, directly or through other path constraints.
+          TRITON_EXPORT triton::ast::SharedAbstractNode getPathPredicateSlice(const triton::ast::SharedAbstractNode& node, triton::usize prefix) const;
+
           //! Returns path predicates which may reach the targeted address.
           TRITON_EXPORT std::vector<triton::ast::SharedAbstractNode> getPredicatesToReachAddress(triton::uint64 addr) const;
 
@@ -98,6 +163,12 @@ namespace triton {
 
           //! Clears the current path predicate.
           TRITON_EXPORT void clearPathConstraints(void);
+
+          //! Defines the max number of path constraints pushed per branch instruction, 0 for unlimited. Branches over the limit are not recorded.
+          TRITON_EXPORT void setMaxPathConstraintsPerSite(triton::usize limit);
+
+          //! Enables the log of path constraints into the file at `path`, keeping between `window` and 2 * `window` path constraints in memory. The path predicate only covers the path constraints in memory. An empty path disables the log. A copy must call it to log its own path constraints.
+          TRITON_EXPORT void setPathConstraintLog(const std::string& path, triton::usize window);
       };
 
     /*! @} End of symbolic namespace */
@@ -93,6 +93,9 @@ namespace triton {
       //! Initializes the SOLVER python namespace.
       void initSolverNamespace(PyObject* solverDict);
 
+      //! Initializes the SOLVER_POLICY python namespace.
+      void initSolverPolicyNamespace(PyObject* solverPolicyDict);
+
       //! Initializes the SOLVER_STATE python namespace.
       void initSolverStateNamespace(PyObject* solverStateDict);
 
@@ -13,6 +13,7 @@
 
 #include <triton/archEnums.hpp>
 #include <triton/ast.hpp>
+#include <triton/astProgram.hpp>
 #include <triton/bitsVector.hpp>
 #include <triton/immediate.hpp>
 #include <triton/instruction.hpp>
@@ -53,6 +54,9 @@ namespace triton {
       //! Creates the AstNode python class.
       PyObject* PyAstNode(const triton::ast::SharedAbstractNode& node);
 
+      //! Creates the AstProgram python class.
+      PyObject* PyAstProgram(const triton::ast::AstProgram& prog);
+
       //! Creates the BitsVector python class.
       template <typename T> PyObject* PyBitsVector(const T& op);
 
@@ -112,6 +116,17 @@ namespace triton {
       //! pyAstNode type.
       extern PyTypeObject AstNode_Type;
 
+      /* AstProgram ===================================================== */
+
+      //! pyAstProgram object.
+      typedef struct {
+        PyObject_HEAD
+        triton::ast::AstProgram* prog; //! Pointer to the cpp program
+      } AstProgram_Object;
+
+      //! pyAstProgram type.
+      extern PyTypeObject AstProgram_Type;
+
       /* BitsVector ====================================================== */
 
       //! pyBitsVector object.
@@ -246,6 +261,12 @@ namespace triton {
 /*! Returns the triton::ast::SharedAbstractNode. */
 #define PyAstNode_AsAstNode(v) (((triton::bindings::python::AstNode_Object*)(v))->node)
 
+/*! Checks if the pyObject is a triton::ast::AstProgram. */
+#define PyAstProgram_Check(v) ((v)->ob_type == &triton::bindings::python::AstProgram_Type)
+
+/*! Returns the triton::ast::AstProgram. */
+#define PyAstProgram_AsAstProgram(v) (((triton::bindings::python::AstProgram_Object*)(v))->prog)
+
 /*! Checks if the pyObject is a triton::arch::BitsVector. */
 #define PyBitsVector_Check(v) ((v)->ob_type == &triton::bindings::python::BitsVector_Type)
 
@@ -0,0 +1,149 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the Apache License 2.0.
+*/
+
+#ifndef TRITON_SIMPLIFICATIONRULES_H
+#define TRITON_SIMPLIFICATIONRULES_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <triton/ast.hpp>
+#include <triton/astEnums.hpp>
+#include <triton/dllexport.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  //! The Engines namespace
+  namespace engines {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup engines
+   *  @{
+   */
+
+    //! The Symbolic Execution namespace
+    namespace symbolic {
+    /*!
+     *  \ingroup engines
+     *  \addtogroup symbolic
+     *  @{
+     */
+
+      //! \class SimplificationRules
+      /*! \brief Declarative rewrite rules applied during the symbolic simplification.
+       *
+       * \details A rule is written as `pattern -> replacement`, where both sides are
+       * expressions in SMT-LIB prefix form (e.g. `(bvxor x x) -> 0`) or in infix form
+       * with Python's operators (e.g. `(a & ~b) | (~a & b) -> a ^ b`). Identifiers are
+       * pattern variables, a variable used several times must match equal sub-trees.
+       * Constants without explicit size take the size of their context. Rules are
+       * dispatched on the type of the root node and commutative operators are matched
+       * in both orders, so no callback is involved in the rewriting.
+       */
+      class SimplificationRules {
+        private:
+          //! The kind of a pattern node.
+          enum pattern_e {
+            PATTERN_CONSTANT,
+            PATTERN_NODE,
+            PATTERN_VARIABLE,
+          };
+
+          //! A node of a pattern.
+          struct Pattern {
+            //! The kind of the pattern.
+            pattern_e kind;
+
+            //! The type of the node (PATTERN_NODE).
+            triton::ast::ast_e type;
+
+            //! The indexes of indexed operators like extract or zero_extend (PATTERN_NODE).
+            std::vector<triton::uint32> indexes;
+
+            //! The index of the variable in the bindings (PATTERN_VARIABLE).
+            triton::uint32 variable;
+
+            //! The value, two's complement on 512 bits (PATTERN_CONSTANT).
+            triton::uint512 value;
+
+            //! The size of the constant, 0 if it takes the size of its context (PATTERN_CONSTANT).
+            triton::uint32 size;
+
+            //! The children of the node (PATTERN_NODE).
+            std::vector<Pattern> children;
+          };
+
+          //! A rewrite rule.
+          struct Rule {
+            //! The pattern to match.
+            Pattern lhs;
+
+            //! The replacement.
+            Pattern rhs;
+
+            //! The number of variables of the pattern.
+            triton::uint32 numberOfVariables;
+          };
+
+          //! A pattern which remains to be matched against a node.
+          using Goal = std::pair<const Pattern*, const triton::ast::SharedAbstractNode*>;
+
+          //! The parser of rules.
+          class Parser;
+
+          //! The rules indexed by the type of their root node.
+          std::vector<std::vector<Rule>> dispatch;
+
+          //! The rules as given by the user, in insertion order.
+          std::vector<std::string> texts;
+
+          //! Matches all goals and binds variables. Backtracks on commutative operators. `goals` is left unchanged.
+          bool match(std::vector<Goal>& goals, std::vector<triton::ast::SharedAbstractNode>& bindings) const;
+
+          //! Throws if the size of a constant of the replacement cannot be inferred.
+          void checkSizes(const Pattern& pattern, bool sized, const std::string& rule) const;
+
+          //! Builds the replacement of a rule. `size` is the size expected by the context, 0 if unknown.
+          triton::ast::SharedAbstractNode build(const Pattern& pattern, const std::vector<triton::ast::SharedAbstractNode>& bindings, const triton::ast::SharedAstContext& ctxt, triton::uint32 size) const;
+
+        public:
+          //! Constructor.
+          TRITON_EXPORT SimplificationRules();
+
+          //! Adds a rule. Throws if the rule cannot be parsed.
+          TRITON_EXPORT void addRule(const std::string& rule);
+
+          //! Removes all rules.
+          TRITON_EXPORT void clearRules(void);
+
+          //! Returns all rules, in insertion order.
+          TRITON_EXPORT std::vector<std::string> getRules(void) const;
+
+          //! Returns true if no rule is recorded.
+          TRITON_EXPORT bool isEmpty(void) const;
+
+          //! Applies the first rule matching the node. Returns the node itself if no rule applies.
+          TRITON_EXPORT triton::ast::SharedAbstractNode rewrite(const triton::ast::SharedAbstractNode& node) const;
+      };
+
+    /*! @} End of symbolic namespace */
+    };
+  /*! @} End of engines namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_SIMPLIFICATIONRULES_H */
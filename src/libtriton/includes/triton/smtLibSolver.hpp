@@ -0,0 +1,187 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the Apache License 2.0.
+*/
+
+#ifndef TRITON_SMTLIBSOLVER_H
+#define TRITON_SMTLIBSOLVER_H
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <triton/ast.hpp>
+#include <triton/dllexport.hpp>
+#include <triton/solverEnums.hpp>
+#include <triton/solverInterface.hpp>
+#include <triton/solverModel.hpp>
+#include <triton/symbolicVariable.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+  //! The Engines namespace
+  namespace engines {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup engines
+   *  @{
+   */
+    //! The Solver namespace
+    namespace solver {
+    /*!
+     *  \ingroup engines
+     *  \addtogroup solver
+     *  @{
+     */
+
+      //! \class SmtLibSolver
+      /*! \brief Solver engine talking SMT-LIB2 to external solver processes.
+       *
+       * \details Each command (e.g. `z3 -in`, `cvc5 --lang smt2 --incremental`) is a long-running
+       * process reading SMT-LIB2 on its standard input. A query is printed with the SMT
+       * representation into a `(push 1)` scope, with the declarations of its variables and
+       * the definitions of its references, then popped so the process can be reused. When
+       * several commands are given, the query is raced between them: the first `sat` or
+       * `unsat` answer wins and the processes still running are killed. Processes are also
+       * killed on timeout, and a process dying (e.g. over its memory limit) only fails its
+       * query. Idle processes are kept in a pool and reused by the next queries, so a process
+       * only starts once. Only available on Unix-like systems.
+       */
+      class SmtLibSolver : public SolverInterface {
+        private:
+          //! A solver process, killed when destroyed.
+          struct Process {
+            //! The index of its command.
+            triton::usize command = 0;
+
+            //! The process id.
+            triton::sint32 pid = -1;
+
+            //! The socket connected to its standard input and output.
+            triton::sint32 fd = -1;
+
+            //! The output received but not consumed yet.
+            std::string buffer;
+
+            //! Destructor.
+            ~Process();
+          };
+
+          //! The deadline of a query.
+          using Deadline = std::chrono::steady_clock::time_point;
+
+          //! The commands of the solvers, each one is an argv.
+          std::vector<std::vector<std::string>> commands;
+
+          //! The max number of idle processes kept per command.
+          triton::usize poolSize;
+
+          //! The solver timeout. By default, unlimited. This global timeout may be changed for a specific query (isSat/getModel/getModels) via argument `timeout`.
+          triton::uint32 timeout;
+
+          //! The memory limit of each process (in megabytes). By default, unlimited.
+          triton::uint32 memoryLimit;
+
+          //! Protects the pool.
+          mutable std::mutex mutex;
+
+          //! The idle processes.
+          mutable std::vector<std::unique_ptr<Process>> pool;
+
+          //! Returns an idle process of a command, starting one if needed.
+          std::unique_ptr<Process> acquire(triton::usize command) const;
+
+          //! Gives back a process to the pool.
+          void release(std::unique_ptr<Process> process) const;
+
+          //! Starts a process.
+          std::unique_ptr<Process> spawn(triton::usize command) const;
+
+          //! Kills a process.
+          static void kill(Process& process);
+
+          //! Writes to a process. Returns false if it is dead.
+          bool send(Process& process, const std::string& text) const;
+
+          //! Waits until one of the processes gives an answer line. Returns its index, or -1 on timeout. A dead process answers an empty line.
+          triton::sint32 receive(const std::vector<Process*>& processes, Deadline deadline, bool hasDeadline, std::string& answer) const;
+
+          //! Waits for a complete s-expression from a process. Returns false on timeout or if it is dead.
+          bool receiveExpression(Process& process, Deadline deadline, bool hasDeadline, std::string& expr) const;
+
+          //! Returns the script of a query and fills the printed names of its variables.
+          std::string getScript(const triton::ast::SharedAbstractNode& node, std::unordered_map<std::string, triton::engines::symbolic::SharedSymbolicVariable>& variables) const;
+
+          //! Parses the answer of a get-value command.
+          std::unordered_map<triton::usize, SolverModel> parseModel(const std::string& values, const std::unordered_map<std::string, triton::engines::symbolic::SharedSymbolicVariable>& variables) const;
+
+          //! Kills all the idle processes.
+          void clear(void);
+
+        public:
+          //! Constructor. By default, the command is `z3 -in`.
+          TRITON_EXPORT SmtLibSolver();
+
+          //! Destructor.
+          TRITON_EXPORT ~SmtLibSolver();
+
+          //! Computes and returns a model from a symbolic constraint. State is returned in the `status` pointer as well as the solving time. A `timeout` can also be defined.
+          /*! \brief map of symbolic variable id -> model
+           *
+           * \details
+           * **item1**: symbolic variable id<br>
+           * **item2**: model
+           */
+          TRITON_EXPORT std::unordered_map<triton::usize, SolverModel> getModel(const triton::ast::SharedAbstractNode& node, triton::engines::solver::status_e* status = nullptr, triton::uint32 timeout = 0, triton::uint32* solvingTime = nullptr) const;
+
+          //! Computes and returns several models from a symbolic constraint. The `limit` is the number of models returned. State is returned in the `status` pointer as well as the solving time. A `timeout` can also be defined.
+          /*! \brief vector of map of symbolic variable id -> model
+           *
+           * \details
+           * **item1**: symbolic variable id<br>
+           * **item2**: model
+           */
+          TRITON_EXPORT std::vector<std::unordered_map<triton::usize, SolverModel>> getModels(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, triton::engines::solver::status_e* status = nullptr, triton::uint32 timeout = 0, triton::uint32* solvingTime = nullptr) const;
+
+          //! Returns true if an expression is satisfiable.
+          TRITON_EXPORT bool isSat(const triton::ast::SharedAbstractNode& node, triton::engines::solver::status_e* status = nullptr, triton::uint32 timeout = 0, triton::uint32* solvingTime = nullptr) const;
+
+          //! Returns the name of this solver.
+          TRITON_EXPORT std::string getName(void) const;
+
+          //! Defines a solver timeout (in milliseconds).
+          TRITON_EXPORT void setTimeout(triton::uint32 ms);
+
+          //! Defines the memory limit of each process (in megabytes).
+          TRITON_EXPORT void setMemoryLimit(triton::uint32 mem);
+
+          //! Returns the commands of the solvers.
+          TRITON_EXPORT const std::vector<std::vector<std::string>>& getCommands(void) const;
+
+          //! Defines the commands of the solvers, queries are raced between them.
+          TRITON_EXPORT void setCommands(const std::vector<std::vector<std::string>>& commands);
+
+          //! Defines the max number of idle processes kept per command.
+          TRITON_EXPORT void setPoolSize(triton::usize size);
+      };
+
+    /*! @} End of solver namespace */
+    };
+  /*! @} End of engines namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_SMTLIBSOLVER_H */
@@ -0,0 +1,152 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the Apache License 2.0.
+*/
+
+#ifndef TRITON_SOLVERCACHE_H
+#define TRITON_SOLVERCACHE_H
+
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <triton/ast.hpp>
+#include <triton/dllexport.hpp>
+#include <triton/solverEnums.hpp>
+#include <triton/solverModel.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+  //! The Engines namespace
+  namespace engines {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup engines
+   *  @{
+   */
+    //! The Solver namespace
+    namespace solver {
+    /*!
+     *  \ingroup engines
+     *  \addtogroup solver
+     *  @{
+     */
+
+      //! \class SolverCache
+      /*! \brief A cache of solver answers in front of the solver.
+       *
+       * \details A query is seen as the set of its conjuncts (the operands of its top-level
+       * `land`), each identified by its hash. Hash matches are confirmed structurally, so a
+       * collision cannot return the answer of another query. A query whose set is cached gets
+       * the cached answer back. A query which contains the set of a cached UNSAT query is UNSAT.
+       * A query which contains the set of a cached SAT query is SAT if the cached model,
+       * evaluated concretely, also satisfies it. Cached sets are indexed by their smallest hash,
+       * so only the entries indexed by a hash of the query are checked. Entries are evicted in
+       * insertion order once the capacity is reached. A capacity of 0 disables the cache.
+       */
+      class SolverCache {
+        private:
+          //! A conjunct of a query and its hash.
+          using Conjunct = std::pair<triton::uint64, triton::ast::SharedAbstractNode>;
+
+          //! A cached answer.
+          struct Entry {
+            //! The conjuncts of the query sorted by hash. Nodes are kept to confirm the hash matches.
+            std::vector<Conjunct> key;
+
+            //! The digest of the key.
+            triton::uint64 digest;
+
+            //! The status of the query (SAT or UNSAT).
+            triton::engines::solver::status_e status;
+
+            //! The number of models asked to the solver, 0 for a satisfiability check.
+            triton::uint32 limit;
+
+            //! The models returned by the solver.
+            std::vector<std::unordered_map<triton::usize, SolverModel>> models;
+          };
+
+          //! The entries, oldest first.
+          std::list<Entry> entries;
+
+          //! The entries indexed by the digest of their key.
+          std::unordered_multimap<triton::uint64, std::list<Entry>::iterator> index;
+
+          //! The entries indexed by the smallest hash of their key. A cached subset of a query is indexed by one of the query hashes.
+          std::unordered_multimap<triton::uint64, std::list<Entry>::iterator> subsets;
+
+          //! The max number of entries.
+          triton::usize capacity;
+
+          //! The number of queries answered by the cache.
+          triton::usize hits;
+
+          //! The number of queries forwarded to the solver.
+          triton::usize misses;
+
+          //! Returns the conjuncts of a query sorted by hash and the digest of their hashes.
+          std::vector<Conjunct> getKey(const triton::ast::SharedAbstractNode& node, triton::uint64& digest) const;
+
+          //! Returns true if every conjunct of `subset` is also a conjunct of `set`.
+          bool includes(const std::vector<Conjunct>& set, const std::vector<Conjunct>& subset) const;
+
+          //! Returns a model of the query built from a cached model, or an empty map if the cached model does not satisfy the query.
+          std::unordered_map<triton::usize, SolverModel> extendModel(const triton::ast::SharedAbstractNode& node, const std::vector<const Entry*>& candidates) const;
+
+          //! Records an entry, evicting the oldest ones if needed.
+          void record(Entry&& entry);
+
+          //! Removes an entry and its indexes.
+          void forget(std::list<Entry>::iterator entry);
+
+        public:
+          //! Constructor.
+          TRITON_EXPORT SolverCache();
+
+          //! Returns true if the cache is enabled.
+          TRITON_EXPORT bool isEnabled(void) const;
+
+          //! Looks up a query asking for `limit` models (0 for a satisfiability check). Returns true on hit and fills `models` and `status`.
+          TRITON_EXPORT bool lookup(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, std::vector<std::unordered_map<triton::usize, SolverModel>>& models, triton::engines::solver::status_e& status);
+
+          //! Records the answer of the solver to a query. Only SAT and UNSAT answers are recorded.
+          TRITON_EXPORT void insert(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, const std::vector<std::unordered_map<triton::usize, SolverModel>>& models, triton::engines::solver::status_e status);
+
+          //! Removes all entries and resets the counters.
+          TRITON_EXPORT void clear(void);
+
+          //! Returns the max number of entries.
+          TRITON_EXPORT triton::usize getCapacity(void) const;
+
+          //! Defines the max number of entries. 0 disables the cache.
+          TRITON_EXPORT void setCapacity(triton::usize capacity);
+
+          //! Returns the number of entries.
+          TRITON_EXPORT triton::usize getSize(void) const;
+
+          //! Returns the number of queries answered by the cache.
+          TRITON_EXPORT triton::usize getHits(void) const;
+
+          //! Returns the number of queries forwarded to the solver.
+          TRITON_EXPORT triton::usize getMisses(void) const;
+      };
+
+    /*! @} End of solver namespace */
+    };
+  /*! @} End of engines namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_SOLVERCACHE_H */
@@ -16,11 +16,18 @@
 #include <triton/ast.hpp>
 #include <triton/config.hpp>
 #include <triton/dllexport.hpp>
+#include <triton/localSearchSolver.hpp>
+#include <triton/parallelSolver.hpp>
+#include <triton/pathConstraint.hpp>
+#include <triton/smtLibSolver.hpp>
+#include <triton/solverCache.hpp>
 #include <triton/solverEnums.hpp>
 #include <triton/solverInterface.hpp>
 #include <triton/solverModel.hpp>
 #include <triton/tritonTypes.hpp>
+#include <triton/trivialSolver.hpp>
 #ifdef TRITON_Z3_INTERFACE
+  #include <triton/z3Session.hpp>
   #include <triton/z3Solver.hpp>
 #endif
 
@@ -57,6 +64,26 @@ namespace triton {
           //! Instance to the real solver class.
           std::unique_ptr<triton::engines::solver::SolverInterface> solver;
 
+          #ifdef TRITON_Z3_INTERFACE
+          //! The incremental z3 session, created on demand.
+          std::unique_ptr<triton::engines::solver::Z3Session> session;
+          #endif
+
+          //! The solver timeout, also used by the session.
+          triton::uint32 timeout;
+
+          //! The solver memory limit, also used by the session.
+          triton::uint32 memoryLimit;
+
+          //! The cache of answers in front of the solver.
+          mutable triton::engines::solver::SolverCache cache;
+
+          //! The solver answering trivial queries before the cache and the solver.
+          mutable triton::engines::solver::TrivialSolver trivial;
+
+          //! The weakest path constraints given to the solver by path-aware queries.
+          triton::engines::solver::policy_e policy;
+
         public:
           //! Constructor.
           TRITON_EXPORT SolverEngine();
@@ -94,9 +121,44 @@ namespace triton {
            */
           TRITON_EXPORT std::vector<std::unordered_map<triton::usize, SolverModel>> getModels(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, triton::engines::solver::status_e* status = nullptr, triton::uint32 timeout = 0, triton::uint32* solvingTime = nullptr) const;
 
+          //! Computes and returns several models projected on `variables`. Models only hold these variables and differ by at least one of them. These queries bypass the fast path and the cache.
+          /*! \brief vector of map of symbolic variable id -> model
+           *
+           * \details
+           * **item1**: symbolic variable id<br>
+           * **item2**: model
+           */
+          TRITON_EXPORT std::vector<std::unordered_map<triton::usize, SolverModel>> getModels(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, const std::vector<triton::engines::symbolic::SharedSymbolicVariable>& variables, triton::engines::solver::status_e* status = nullptr, triton::uint32 timeout = 0, triton::uint32* solvingTime = nullptr) const;
+
           //! Returns true if an expression is satisfiable.
           TRITON_EXPORT bool isSat(const triton::ast::SharedAbstractNode& node, triton::engines::solver::status_e* status = nullptr, triton::uint32 timeout = 0, triton::uint32* solvingTime = nullptr) const;
 
+          #ifdef TRITON_Z3_INTERFACE
+          //! Returns the incremental z3 session. The session is created on the first call.
+          TRITON_EXPORT triton::engines::solver::Z3Session& getSession(void);
+          #endif
+
+          //! Destroys the incremental session and releases its z3 context.
+          TRITON_EXPORT void resetSession(void);
+
+          //! Solves the branches not taken by a path on `threads` worker threads (0 for one per core). A `timeout` of 0 uses the solver timeout.
+          TRITON_EXPORT void flipPathConstraints(const std::vector<triton::engines::symbolic::PathConstraint>& pcs, const std::vector<triton::usize>& stamps, const triton::engines::solver::ParallelSolver::Callback& callback, triton::uint32 threads = 0, triton::uint32 timeout = 0) const;
+
+          //! Returns the cache of answers in front of the solver.
+          TRITON_EXPORT triton::engines::solver::SolverCache& getCache(void);
+
+          //! Returns the solver answering trivial queries.
+          TRITON_EXPORT triton::engines::solver::TrivialSolver& getTrivialSolver(void);
+
+          //! Returns the weakest path constraints given to the solver by path-aware queries.
+          TRITON_EXPORT triton::engines::solver::policy_e getPolicy(void) const;
+
+          //! Defines the weakest path constraints given to the solver by path-aware queries.
+          TRITON_EXPORT void setPolicy(triton::engines::solver::policy_e policy);
+
+          //! Defines the commands of the SOLVER_SMTLIB solver, queries are raced between them.
+          TRITON_EXPORT void setCommands(const std::vector<std::vector<std::string>>& commands);
+
           //! Returns the name of the solver.
           TRITON_EXPORT std::string getName(void) const;
 
@@ -37,11 +37,13 @@ namespace triton {
 
       /*! The different kind of solvers */
       enum solver_e {
-        SOLVER_INVALID = 0, /*!< invalid solver. */
-        SOLVER_CUSTOM,      /*!< custom solver. */
+        SOLVER_INVALID = 0,  /*!< invalid solver. */
+        SOLVER_CUSTOM,       /*!< custom solver. */
         #ifdef TRITON_Z3_INTERFACE
-        SOLVER_Z3,          /*!< z3 solver. */
+        SOLVER_Z3,           /*!< z3 solver. */
         #endif
+        SOLVER_LOCAL_SEARCH, /*!< local-search solver. */
+        SOLVER_SMTLIB,       /*!< external SMT-LIB2 solvers. */
       };
 
       /*! The different kind of status */
@@ -53,6 +55,13 @@ namespace triton {
         UNKNOWN    /*!< UNKNOWN */
       };
 
+      /*! The path constraints given to the solver by path-aware queries */
+      enum policy_e {
+        POLICY_FULL = 0, /*!< the full path predicate. */
+        POLICY_NESTED,   /*!< the path constraints sharing variables with the query. */
+        POLICY_LAST,     /*!< the query alone. */
+      };
+
     /*! @} End of solver namespace */
     };
   /*! @} End of engines namespace */
@@ -8,9 +8,16 @@
 #ifndef TRITON_SYMBOLICSIMPLIFICATION_H
 #define TRITON_SYMBOLICSIMPLIFICATION_H
 
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include <triton/ast.hpp>
 #include <triton/callbacks.hpp>
 #include <triton/dllexport.hpp>
+#include <triton/simplificationRules.hpp>
+#include <triton/tritonTypes.hpp>
 
 
 
@@ -44,9 +51,24 @@ namespace triton {
           //! Callbacks API
           triton::callbacks::Callbacks* callbacks;
 
+          //! The rewrite rules.
+          SimplificationRules rules;
+
+          //! The maximum number of times rules and callbacks are applied on a node.
+          triton::usize maxIterations;
+
+          //! Maps an original node to its simplification (the original node is kept alive during the pass).
+          using SimplificationMemo = std::unordered_map<triton::ast::AbstractNode*, std::pair<triton::ast::SharedAbstractNode, triton::ast::SharedAbstractNode>>;
+
           //! Copies a SymbolicSimplification.
           void copy(const SymbolicSimplification& other);
 
+          //! Applies rules and callbacks on a node until it does not change or the iteration limit is reached. Results are memoized.
+          triton::ast::SharedAbstractNode simplify(const triton::ast::SharedAbstractNode& node, SimplificationMemo& memo) const;
+
+          //! Re-initializes the given nodes and all their ancestors once, children first.
+          void initAncestors(const std::vector<triton::ast::SharedAbstractNode>& nodes) const;
+
         public:
           //! Constructor.
           TRITON_EXPORT SymbolicSimplification(triton::callbacks::Callbacks* callbacks=nullptr);
@@ -57,6 +79,21 @@ namespace triton {
           //! Processes all recorded simplifications. Returns the simplified node.
           TRITON_EXPORT triton::ast::SharedAbstractNode processSimplification(const triton::ast::SharedAbstractNode& node) const;
 
+          //! Adds a rewrite rule like `(bvxor x x) -> 0`. See SimplificationRules.
+          TRITON_EXPORT void addSimplificationRule(const std::string& rule);
+
+          //! Removes all rewrite rules.
+          TRITON_EXPORT void clearSimplificationRules(void);
+
+          //! Returns all rewrite rules.
+          TRITON_EXPORT std::vector<std::string> getSimplificationRules(void) const;
+
+          //! Sets the maximum number of times rules and callbacks are applied on a node (1 by default).
+          TRITON_EXPORT void setMaxSimplificationIterations(triton::usize iterations);
+
+          //! Returns the maximum number of times rules and callbacks are applied on a node.
+          TRITON_EXPORT triton::usize getMaxSimplificationIterations(void) const;
+
           //! Copies a SymbolicSimplification.
           TRITON_EXPORT SymbolicSimplification& operator=(const SymbolicSimplification& other);
       };
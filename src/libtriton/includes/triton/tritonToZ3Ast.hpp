@@ -9,6 +9,7 @@
 #define TRITON_TRITONTOZ3AST_H
 
 #include <unordered_map>
+#include <utility>
 #include <z3++.h>
 
 #include <triton/ast.hpp>
@@ -39,6 +40,33 @@ namespace triton {
         //! This flag define if the conversion is used to evaluated a node or not.
         bool isEval;
 
+        //! This flag define if translations are kept across conversions.
+        bool isCached;
+
+        //! A translation kept across conversions.
+        struct CacheEntry {
+          //! The translated node.
+          triton::ast::WeakAbstractNode node;
+
+          //! The hash of the node when translated, a node modified in place no longer matches it.
+          triton::uint64 hash;
+
+          //! The size of the node when translated.
+          triton::uint32 size;
+
+          //! The translation.
+          z3::expr expr;
+        };
+
+        //! The translations kept across conversions, keyed by node identity. Entries of dead nodes are swept lazily.
+        std::unordered_map<const triton::ast::AbstractNode*, CacheEntry> cache;
+
+        //! The size of the cache after its last sweep of dead entries.
+        triton::usize cacheSwept;
+
+        //! Converts a node, reusing and filling the cache.
+        z3::expr convertCached(const triton::ast::SharedAbstractNode& node);
+
         //! Returns the integer of the z3 expression (expr must be an int).
         triton::__uint getUintValue(const z3::expr& expr);
 
@@ -59,14 +87,23 @@ namespace triton {
         //! The set of symbolic variables contained in the expression.
         std::unordered_map<std::string, triton::engines::symbolic::SharedSymbolicVariable> variables;
 
-        //! Constructor.
-        TRITON_EXPORT TritonToZ3Ast(bool eval=true);
+        //! Constructor. If `cache` is true (and `eval` is false), each node is translated once for the life of the converter.
+        TRITON_EXPORT TritonToZ3Ast(bool eval=true, bool cache=false);
 
         //! Destructor.
         TRITON_EXPORT ~TritonToZ3Ast();
 
         //! Converts to Z3's AST
         TRITON_EXPORT z3::expr convert(const triton::ast::SharedAbstractNode& node);
+
+        //! Returns the z3's context in which expressions are converted.
+        TRITON_EXPORT z3::context& getContext(void);
+
+        //! Returns the number of translations kept in the cache.
+        TRITON_EXPORT triton::usize getCacheSize(void) const;
+
+        //! Removes all translations from the cache.
+        TRITON_EXPORT void clearCache(void);
     };
 
   /*! @} End of ast namespace */
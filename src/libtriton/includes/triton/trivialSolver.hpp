@@ -0,0 +1,138 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the Apache License 2.0.
+*/
+
+#ifndef TRITON_TRIVIALSOLVER_H
+#define TRITON_TRIVIALSOLVER_H
+
+#include <unordered_map>
+#include <vector>
+
+#include <triton/ast.hpp>
+#include <triton/dllexport.hpp>
+#include <triton/solverEnums.hpp>
+#include <triton/solverModel.hpp>
+#include <triton/symbolicVariable.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+  //! The Engines namespace
+  namespace engines {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup engines
+   *  @{
+   */
+    //! The Solver namespace
+    namespace solver {
+    /*!
+     *  \ingroup engines
+     *  \addtogroup solver
+     *  @{
+     */
+
+      //! \class TrivialSolver
+      /*! \brief A solver answering trivial queries without calling the solver.
+       *
+       * \details A query is trivial if it is a conjunction of comparisons between a constant
+       * and an affine term `(a * x + b) mod 2^n` over a single variable of at most 64 bits,
+       * e.g. `(= ((_ extract 7 0) SymVar_0) (_ bv65 8))`, an unsigned or signed range check,
+       * or a linear equation over one byte. Terms may go through references, low extractions,
+       * zero extensions of a variable, concatenations with constant high bits, and additions,
+       * subtractions, multiplications or left shifts by constants. Models are enumerated in
+       * ascending order. Queries which are not trivial, or whose enumeration goes over a fixed
+       * budget, are left to the solver.
+       */
+      class TrivialSolver {
+        private:
+          //! The comparison of an atom.
+          enum compare_e {
+            EQ,   //!< term == value
+            NE,   //!< term != value
+            ULE,  //!< term <= value (unsigned)
+            UGE,  //!< term >= value (unsigned)
+          };
+
+          //! An affine term `(a * x + b) mod 2^size` over a variable `x`.
+          struct Term {
+            //! The variable, null for a constant.
+            triton::engines::symbolic::SharedSymbolicVariable variable;
+
+            //! The factor of the variable.
+            triton::uint64 a;
+
+            //! The constant part.
+            triton::uint64 b;
+
+            //! The size of the term in bits.
+            triton::uint32 size;
+          };
+
+          //! A comparison between a term and a constant.
+          struct Atom {
+            //! The term.
+            Term term;
+
+            //! The comparison.
+            compare_e compare;
+
+            //! The constant.
+            triton::uint64 value;
+          };
+
+          //! True if queries are first given to this solver.
+          bool enabled;
+
+          //! The number of queries answered.
+          triton::usize hits;
+
+          //! Builds the affine term of a node. Returns false if the node is not affine.
+          bool getTerm(triton::ast::AbstractNode* node, Term& term, triton::uint32 depth) const;
+
+          //! Adds the atoms of a conjunction. Returns false if the query is not trivial.
+          bool getAtoms(triton::ast::AbstractNode* node, std::vector<Atom>& atoms, bool& unsat) const;
+
+          //! Adds the atom of a comparison. Returns false if the comparison is not trivial.
+          bool getAtom(triton::ast::AbstractNode* node, bool negate, std::vector<Atom>& atoms, bool& unsat) const;
+
+          //! Returns true if the value of the variable satisfies the atom.
+          bool isSatisfied(const Atom& atom, triton::uint64 x) const;
+
+          //! Fills up to `limit` values of a variable satisfying all atoms. Returns false if the budget is exhausted.
+          bool getSolutions(const std::vector<const Atom*>& atoms, triton::uint32 size, triton::uint32 limit, std::vector<triton::uint64>& solutions) const;
+
+        public:
+          //! Constructor.
+          TRITON_EXPORT TrivialSolver();
+
+          //! Returns true if queries are first given to this solver.
+          TRITON_EXPORT bool isEnabled(void) const;
+
+          //! Enables or disables the solver.
+          TRITON_EXPORT void setEnabled(bool flag);
+
+          //! Answers a query asking for `limit` models (0 for a satisfiability check). Returns true if the query is trivial and fills `models` and `status`.
+          TRITON_EXPORT bool solve(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, std::vector<std::unordered_map<triton::usize, SolverModel>>& models, triton::engines::solver::status_e& status);
+
+          //! Returns the number of queries answered.
+          TRITON_EXPORT triton::usize getHits(void) const;
+      };
+
+    /*! @} End of solver namespace */
+    };
+  /*! @} End of engines namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_TRIVIALSOLVER_H */
@@ -0,0 +1,125 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the Apache License 2.0.
+*/
+
+#ifndef TRITON_Z3SESSION_H
+#define TRITON_Z3SESSION_H
+
+#include <unordered_map>
+#include <vector>
+#include <z3++.h>
+#include <z3_api.h>
+
+#include <triton/ast.hpp>
+#include <triton/dllexport.hpp>
+#include <triton/pathConstraint.hpp>
+#include <triton/solverEnums.hpp>
+#include <triton/solverModel.hpp>
+#include <triton/tritonToZ3Ast.hpp>
+#include <triton/tritonTypes.hpp>
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+  //! The Engines namespace
+  namespace engines {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup engines
+   *  @{
+   */
+    //! The Solver namespace
+    namespace solver {
+    /*!
+     *  \ingroup engines
+     *  \addtogroup solver
+     *  @{
+     */
+
+      //! \class Z3Session
+      /*! \brief An incremental z3 session mirroring the path predicate.
+       *
+       * \details The session keeps one z3 context and one solver alive. Each path constraint
+       * is asserted in its own scope, so pushing or popping path constraints only pushes or
+       * pops solver scopes and a query only translates and asserts the constraints which are
+       * not yet in the session. Path constraints are identified by their stamp (See:
+       * triton::engines::symbolic::PathManager::getPathConstraintStamps()). Translations
+       * are cached by the converter, so each node is translated once for the session.
+       */
+      class Z3Session {
+        private:
+          //! The converter, which owns the z3 context of the session and caches translations.
+          triton::ast::TritonToZ3Ast converter;
+
+          //! The incremental solver.
+          z3::solver solver;
+
+          //! The stamps of path constraints asserted in the session, one scope per stamp.
+          std::vector<triton::usize> stamps;
+
+          //! The SMT solver timeout. By default, unlimited.
+          triton::uint32 timeout;
+
+          //! The SMT solver memory limit. By default, unlimited.
+          triton::uint32 memoryLimit;
+
+          //! Sets the solver parameters for a query.
+          void setParameters(triton::uint32 timeout);
+
+          //! Writes back the status code of the solver into the pointer pointed by status.
+          void writeBackStatus(z3::check_result res, triton::engines::solver::status_e* status);
+
+        public:
+          //! Constructor. If `cache` is false, translations are not kept across queries.
+          TRITON_EXPORT Z3Session(bool cache=true);
+
+          //! Pops and pushes scopes so that the session holds the first `size` path constraints.
+          TRITON_EXPORT void sync(const std::vector<triton::engines::symbolic::PathConstraint>& pcs, const std::vector<triton::usize>& stamps, triton::usize size);
+
+          //! Pops and pushes scopes so that the session holds the path constraints at `indexes`, in this order.
+          TRITON_EXPORT void sync(const std::vector<triton::engines::symbolic::PathConstraint>& pcs, const std::vector<triton::usize>& stamps, const std::vector<triton::usize>& indexes);
+
+          //! Computes and returns several models from a symbolic constraint and the path constraints of the session. The `limit` is the max number of models returned.
+          /*! \brief vector of map of symbolic variable id -> model
+           *
+           * \details
+           * **item1**: symbolic variable id<br>
+           * **item2**: model
+           */
+          TRITON_EXPORT std::vector<std::unordered_map<triton::usize, SolverModel>> getModels(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, triton::engines::solver::status_e* status = nullptr, triton::uint32 timeout = 0, triton::uint32* solvingTime = nullptr);
+
+          //! Returns true if a symbolic constraint and the path constraints of the session are satisfiable.
+          TRITON_EXPORT bool isSat(const triton::ast::SharedAbstractNode& node, triton::engines::solver::status_e* status = nullptr, triton::uint32 timeout = 0, triton::uint32* solvingTime = nullptr);
+
+          //! Returns the number of path constraints asserted in the session.
+          TRITON_EXPORT triton::usize getNumberOfScopes(void) const;
+
+          //! Removes all path constraints from the session.
+          TRITON_EXPORT void reset(void);
+
+          //! Interrupts the running query. May be called from another thread.
+          TRITON_EXPORT void interrupt(void);
+
+          //! Defines a solver timeout (in milliseconds).
+          TRITON_EXPORT void setTimeout(triton::uint32 ms);
+
+          //! Defines a solver memory consumption limit (in megabytes).
+          TRITON_EXPORT void setMemoryLimit(triton::uint32 mem);
+      };
+
+    /*! @} End of solver namespace */
+    };
+  /*! @} End of engines namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_Z3SESSION_H */
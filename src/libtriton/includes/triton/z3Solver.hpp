@@ -19,6 +19,7 @@
 #include <triton/solverEnums.hpp>
 #include <triton/solverInterface.hpp>
 #include <triton/solverModel.hpp>
+#include <triton/symbolicVariable.hpp>
 #include <triton/tritonTypes.hpp>
 
 
@@ -82,6 +83,15 @@ namespace triton {
            */
           TRITON_EXPORT std::vector<std::unordered_map<triton::usize, SolverModel>> getModels(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, triton::engines::solver::status_e* status = nullptr, triton::uint32 timeout = 0, triton::uint32* solvingTime = nullptr) const;
 
+          //! Computes and returns several models projected on `variables`. Models only hold these variables and differ by at least one of them. An empty `variables` projects on all the variables of the models.
+          /*! \brief vector of map of symbolic variable id -> model
+           *
+           * \details
+           * **item1**: symbolic variable id<br>
+           * **item2**: model
+           */
+          TRITON_EXPORT std::vector<std::unordered_map<triton::usize, SolverModel>> getModels(const triton::ast::SharedAbstractNode& node, triton::uint32 limit, const std::vector<triton::engines::symbolic::SharedSymbolicVariable>& variables, triton::engines::solver::status_e* status = nullptr, triton::uint32 timeout = 0, triton::uint32* solvingTime = nullptr) const;
+
           //! Returns true if an expression is satisfiable.
           TRITON_EXPORT bool isSat(const triton::ast::SharedAbstractNode& node, triton::engines::solver::status_e* status = nullptr, triton::uint32 timeout = 0, triton::uint32* solvingTime = nullptr) const;
 
@@ -91,6 +101,9 @@ namespace triton {
           //! Evaluates a Triton's AST via Z3 and returns a concrete value.
           TRITON_EXPORT triton::uint512 evaluate(const triton::ast::SharedAbstractNode& node) const;
 
+          //! Returns the value of a numeral, without going through its decimal string if it fits in 64 bits.
+          TRITON_EXPORT static triton::uint512 getNumeral(const z3::expr& value);
+
           //! Returns the name of this solver.
           TRITON_EXPORT std::string getName(void) const;
 
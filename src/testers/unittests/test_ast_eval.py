@@ -538,6 +538,10 @@ class TestAstEval(unittest.TestCase):
             self.astCtxt.bvlshr(self.astCtxt.bv(0b10001000, 8), self.astCtxt.bv(8, 8)),
             self.astCtxt.bvlshr(self.astCtxt.bv(0b10001000, 8), self.astCtxt.bv(9, 8)),
             self.astCtxt.bvlshr(self.astCtxt.bv(0b10001000, 8), self.astCtxt.bv(123, 8)),
+            self.astCtxt.bvlshr(self.astCtxt.bv(0xf2345678f2345678, 64), self.astCtxt.bv(63, 64)),
+            self.astCtxt.bvlshr(self.astCtxt.bv(0xf2345678f2345678, 64), self.astCtxt.bv(64, 64)),
+            self.astCtxt.bvlshr(self.astCtxt.bv(0xf2345678f2345678f2345678f2345678, 128), self.astCtxt.bv(65, 128)),
+            self.astCtxt.bvlshr(self.astCtxt.bv(0xf2345678f2345678f2345678f2345678, 128), self.astCtxt.bv(0x100000000, 128)),
         ]
         self.check_ast(tests)
 
@@ -581,6 +585,10 @@ class TestAstEval(unittest.TestCase):
             self.astCtxt.bvshl(self.astCtxt.bv(0b01000101, 8), self.astCtxt.bv(8, 8)),
             self.astCtxt.bvshl(self.astCtxt.bv(0b00101001, 8), self.astCtxt.bv(9, 8)),
             self.astCtxt.bvshl(self.astCtxt.bv(0b00010001, 8), self.astCtxt.bv(123, 8)),
+            self.astCtxt.bvshl(self.astCtxt.bv(0xf2345678f2345678, 64), self.astCtxt.bv(63, 64)),
+            self.astCtxt.bvshl(self.astCtxt.bv(0xf2345678f2345678, 64), self.astCtxt.bv(64, 64)),
+            self.astCtxt.bvshl(self.astCtxt.bv(0xf2345678f2345678f2345678f2345678, 128), self.astCtxt.bv(65, 128)),
+            self.astCtxt.bvshl(self.astCtxt.bv(0xf2345678f2345678f2345678f2345678, 128), self.astCtxt.bv(0x100000000, 128)),
         ]
         self.check_ast(tests)
 
@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+## -*- coding: utf-8 -*-
+"""Test AST hash-consing."""
+
+import unittest
+from triton import *
+
+
+
+class TestAstHashConsing(unittest.TestCase):
+
+    """Testing the AST_HASH_CONSING mode."""
+
+    def setUp(self):
+        self.ctx = TritonContext()
+        self.ctx.setArchitecture(ARCH.X86_64)
+
+        self.astCtxt = self.ctx.getAstContext()
+
+        self.sv1 = self.ctx.newSymbolicVariable(8)
+        self.v1  = self.astCtxt.variable(self.sv1)
+
+    def test_without_hash_consing(self):
+        n1 = self.astCtxt.bvadd(self.v1, self.astCtxt.bv(1, 8))
+        n2 = self.astCtxt.bvadd(self.v1, self.astCtxt.bv(1, 8))
+        self.assertTrue(n1.equalTo(n2))
+        self.assertEqual(len(self.v1.getParents()), 2)
+
+    def test_with_hash_consing(self):
+        self.ctx.setMode(MODE.AST_HASH_CONSING, True)
+        n1 = self.astCtxt.bvadd(self.v1, self.astCtxt.bv(1, 8))
+        n2 = self.astCtxt.bvadd(self.v1, self.astCtxt.bv(1, 8))
+        n3 = self.astCtxt.bvadd(self.v1, self.astCtxt.bv(2, 8))
+        self.assertTrue(n1.equalTo(n2))
+        self.assertFalse(n1.equalTo(n3))
+        # n1 and n2 are the same node
+        self.assertEqual(len(self.v1.getParents()), 2)
+
+    def test_same_node(self):
+        self.ctx.setMode(MODE.AST_HASH_CONSING, True)
+        n1 = self.astCtxt.extract(3, 0, self.astCtxt.bvadd(self.v1, self.astCtxt.bv(1, 8)))
+        n2 = self.astCtxt.extract(3, 0, self.astCtxt.bvadd(self.v1, self.astCtxt.bv(1, 8)))
+        # The hash of a node is its address
+        self.assertEqual(hash(n1), hash(n2))
+        self.assertEqual(hash(n1.getChildren()[2]), hash(n2.getChildren()[2]))
+        self.assertNotEqual(hash(n1), hash(self.astCtxt.extract(4, 0, n1.getChildren()[2])))
+
+    def test_evaluation(self):
+        self.ctx.setMode(MODE.AST_HASH_CONSING, True)
+        n1 = self.astCtxt.bvxor(self.v1, self.astCtxt.bv(0xff, 8))
+        n2 = self.astCtxt.bvxor(self.v1, self.astCtxt.bv(0xff, 8))
+        self.ctx.setConcreteVariableValue(self.sv1, 0x11)
+        self.assertEqual(n1.evaluate(), 0xee)
+        self.assertEqual(n2.evaluate(), 0xee)
+
+    def test_processing(self):
+        self.ctx.setMode(MODE.AST_HASH_CONSING, True)
+        self.ctx.symbolizeRegister(self.ctx.registers.rax)
+        self.ctx.processing(Instruction(b"\x48\x31\xc0")) # xor rax, rax
+        self.ctx.processing(Instruction(b"\x48\xff\xc0")) # inc rax
+        self.assertEqual(self.ctx.getConcreteRegisterValue(self.ctx.registers.rax), 1)
+        self.assertEqual(self.ctx.getSymbolicRegister(self.ctx.registers.rax).getAst().evaluate(), 1)
@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+## -*- coding: utf-8 -*-
+"""Test AST lazy evaluation."""
+
+import unittest
+from triton import *
+
+
+
+class TestAstLazyEvaluation(unittest.TestCase):
+
+    """Testing the AST_LAZY_EVALUATION mode."""
+
+    def setUp(self):
+        self.ctx = TritonContext()
+        self.ctx.setArchitecture(ARCH.X86_64)
+        self.ctx.setMode(MODE.AST_LAZY_EVALUATION, True)
+
+        self.astCtxt = self.ctx.getAstContext()
+
+    def test_nodes(self):
+        sv1 = self.ctx.newSymbolicVariable(32)
+        sv2 = self.ctx.newSymbolicVariable(32)
+        v1  = self.astCtxt.variable(sv1)
+        v2  = self.astCtxt.variable(sv2)
+
+        n1 = self.astCtxt.bvadd(v1, v2)
+        n2 = self.astCtxt.bvmul(n1, self.astCtxt.bv(2, 32))
+        n3 = self.astCtxt.ite(self.astCtxt.bvugt(n2, v1), n2, v1)
+
+        for i in range(100):
+            self.ctx.setConcreteVariableValue(sv1, i)
+            self.ctx.setConcreteVariableValue(sv2, i * 3)
+
+        self.assertEqual(n1.evaluate(), 99 + 297)
+        self.assertEqual(n3.evaluate(), (99 + 297) * 2)
+
+        self.ctx.setConcreteVariableValue(sv1, 0xffffffff)
+        self.ctx.setConcreteVariableValue(sv2, 0)
+        self.assertEqual(n3.evaluate(), 0xffffffff)
+        self.assertEqual(n2.evaluate(), 0xfffffffe)
+
+    def test_references(self):
+        self.ctx.symbolizeRegister(self.ctx.registers.rax)
+        self.ctx.symbolizeRegister(self.ctx.registers.rbx)
+        self.ctx.processing(Instruction(b"\x48\x01\xd8")) # add rax, rbx
+        self.ctx.processing(Instruction(b"\x48\x31\xc1")) # xor rcx, rax
+
+        rcx = self.ctx.getSymbolicRegister(self.ctx.registers.rcx).getAst()
+        for sv in self.ctx.getSymbolicVariables().values():
+            self.ctx.setConcreteVariableValue(sv, 0x10)
+        self.assertEqual(rcx.evaluate(), 0x20)
+
+    def test_without_lazy_mode(self):
+        sv = self.ctx.newSymbolicVariable(8)
+        n  = self.astCtxt.bvnot(self.astCtxt.variable(sv))
+        self.ctx.setConcreteVariableValue(sv, 1)
+        self.ctx.setMode(MODE.AST_LAZY_EVALUATION, False)
+        self.assertEqual(n.evaluate(), 0xfe)
+        self.ctx.setConcreteVariableValue(sv, 2)
+        self.assertEqual(n.evaluate(), 0xfd)
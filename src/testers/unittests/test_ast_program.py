@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+## -*- coding: utf-8 -*-
+"""Test AST programs."""
+
+import unittest
+from triton import *
+
+
+
+class TestAstProgram(unittest.TestCase):
+
+    """Testing AST compiled into linear programs."""
+
+    def setUp(self):
+        self.ctx = TritonContext()
+        self.ctx.setArchitecture(ARCH.X86_64)
+        self.astCtxt = self.ctx.getAstContext()
+
+        self.sv1 = self.ctx.newSymbolicVariable(32)
+        self.sv2 = self.ctx.newSymbolicVariable(8)
+        self.v1  = self.astCtxt.variable(self.sv1)
+        self.v2  = self.astCtxt.variable(self.sv2)
+
+    def test_variables(self):
+        node = self.astCtxt.bvadd(self.astCtxt.zx(24, self.v2), self.v1)
+        prog = self.astCtxt.compile(node)
+        self.assertEqual([v.getId() for v in prog.getVariables()], [self.sv1.getId(), self.sv2.getId()])
+        self.assertEqual(prog.getBitvectorSize(), 32)
+        self.assertEqual(prog.evaluate([0xffffffff, 2]), 1)
+        self.assertRaises(TypeError, prog.evaluate, [1])
+
+    def test_same_results(self):
+        a = self.astCtxt
+        x = a.zx(24, self.v2)
+        nodes = [
+            a.bvsdiv(self.v1, x),
+            a.bvsrem(self.v1, x),
+            a.bvsmod(self.v1, x),
+            a.bvudiv(self.v1, x),
+            a.bvurem(self.v1, x),
+            a.bvashr(self.v1, x),
+            a.bvshl(self.v1, x),
+            a.bvlshr(self.v1, x),
+            a.bvrol(self.v1, a.bv(7, 32)),
+            a.bvror(self.v1, a.bv(7, 32)),
+            a.concat([a.extract(15, 0, self.v1), self.v2]),
+            a.sx(32, self.v1),
+            a.ite(a.bvslt(self.v1, x), a.bvneg(self.v1), a.bvnot(self.v1)),
+            a.land([a.bvuge(self.v1, x), a.lnot(a.equal(self.v2, a.bv(0, 8)))]),
+        ]
+        for node in nodes:
+            prog = a.compile(node)
+            for v1, v2 in [(0, 0), (1, 3), (0x80000000, 0xff), (0xfffffff0, 7), (1234, 40)]:
+                self.ctx.setConcreteVariableValue(self.sv1, v1)
+                self.ctx.setConcreteVariableValue(self.sv2, v2)
+                values = [v1 if v.getId() == self.sv1.getId() else v2 for v in prog.getVariables()]
+                self.assertEqual(prog.evaluate(values), node.evaluate())
+
+    def test_batch(self):
+        a = self.astCtxt
+        node = a.ite(a.bvult(self.v1, a.bv(100, 32)),
+                     a.bvxor(self.v1, a.concat([self.v2, a.extract(23, 0, self.v1)])),
+                     a.bvsdiv(self.v1, a.sx(24, self.v2)))
+        prog = a.compile(node)
+        assignments = [[(i * 0x9e3779b9) & 0xffffffff, (i * 7) & 0xff] for i in range(300)]
+        results = prog.evaluateBatch(assignments)
+        self.assertEqual(len(results), 300)
+        for values, result in zip(assignments, results):
+            self.assertEqual(prog.evaluate(values), result)
+        self.assertEqual(prog.evaluateBatch([]), [])
+        self.assertRaises(TypeError, prog.evaluateBatch, [[1]])
+
+    def test_references(self):
+        self.ctx.symbolizeRegister(self.ctx.registers.rax)
+        self.ctx.symbolizeRegister(self.ctx.registers.rbx)
+        self.ctx.processing(Instruction(b"\x48\x01\xd8")) # add rax, rbx
+        self.ctx.processing(Instruction(b"\x48\x31\xc1")) # xor rcx, rax
+
+        zf = self.ctx.getSymbolicRegister(self.ctx.registers.zf).getAst()
+        prog = self.astCtxt.compile(zf)
+        self.assertEqual(len(prog.getVariables()), 2)
+        self.assertEqual(prog.evaluate([1, 0xffffffffffffffff]), 1)
+        self.assertEqual(prog.evaluate([1, 1]), 0)
+
+    def test_constant(self):
+        prog = self.astCtxt.compile(self.astCtxt.bvadd(self.astCtxt.bv(1, 8), self.astCtxt.bv(2, 8)))
+        self.assertEqual(prog.getNumberOfInstructions(), 0)
+        self.assertEqual(prog.evaluate([]), 3)
+
+    def test_unsupported(self):
+        sv = self.ctx.newSymbolicVariable(128)
+        node = self.astCtxt.bvadd(self.astCtxt.variable(sv), self.astCtxt.bv(1, 128))
+        self.assertRaises(TypeError, self.astCtxt.compile, node)
@@ -724,3 +724,100 @@ class TestAstSimplification5(unittest.TestCase):
              "(define-fun ref!13 () (_ BitVec 1) ((_ extract 63 63) ref!8)) ; Sign flag - 0x0: sub qword ptr [rdx], rcx\n"
              "(define-fun ref!14 () (_ BitVec 1) (_ bv1 1)) ; Zero flag - 0x0: sub qword ptr [rdx], rcx\n"
              "(define-fun ref!15 () (_ BitVec 64) (_ bv3 64)) ; Program Counter - 0x0: sub qword ptr [rdx], rcx"))
+
+
+class TestAstSimplification6(unittest.TestCase):
+
+    """Testing AST simplification on shared nodes and iterations."""
+
+    def setUp(self):
+        self.ctx = TritonContext()
+        self.ctx.setArchitecture(ARCH.X86_64)
+        self.astCtxt = self.ctx.getAstContext()
+        self.calls = 0
+
+    def count(self, api, node):
+        self.calls += 1
+        return node
+
+    @staticmethod
+    def not_not(api, node):
+        # (bvnot (bvnot x)) => x
+        if node.getType() == AST_NODE.BVNOT and node.getChildren()[0].getType() == AST_NODE.BVNOT:
+            return node.getChildren()[0].getChildren()[0]
+        return node
+
+    def test_shared_nodes(self):
+        self.ctx.addCallback(CALLBACK.SYMBOLIC_SIMPLIFICATION, self.count)
+        v = self.astCtxt.variable(self.ctx.newSymbolicVariable(64))
+        n = v
+        for i in range(64):
+            n = n + n
+        self.ctx.simplify(n)
+        # Each distinct node is given once to the callback
+        self.assertEqual(self.calls, 65)
+
+    def test_iterations(self):
+        self.ctx.addCallback(CALLBACK.SYMBOLIC_SIMPLIFICATION, self.not_not)
+        self.assertEqual(self.ctx.getMaxSimplificationIterations(), 1)
+
+        v = self.astCtxt.variable(self.ctx.newSymbolicVariable(8))
+        n = ~~~~v
+        self.assertEqual(str(self.ctx.simplify(n)), "(bvnot (bvnot SymVar_0))")
+
+        self.ctx.setMaxSimplificationIterations(4)
+        self.assertEqual(self.ctx.getMaxSimplificationIterations(), 4)
+        self.assertEqual(str(self.ctx.simplify(n)), "SymVar_0")
+
+        with self.assertRaises(TypeError):
+            self.ctx.setMaxSimplificationIterations(0)
+
+
+class TestAstSimplificationRules(unittest.TestCase):
+
+    """Testing AST simplification with rewrite rules."""
+
+    def setUp(self):
+        self.ctx = TritonContext()
+        self.ctx.setArchitecture(ARCH.X86_64)
+        self.astCtxt = self.ctx.getAstContext()
+        self.a = self.astCtxt.variable(self.ctx.newSymbolicVariable(8))
+        self.b = self.astCtxt.variable(self.ctx.newSymbolicVariable(8))
+
+    def test_prefix(self):
+        self.ctx.addSimplificationRule("(bvxor x x) -> 0")
+        self.assertEqual(str(self.ctx.simplify(self.a ^ self.a)), "(_ bv0 8)")
+        self.assertEqual(str(self.ctx.simplify(self.a ^ self.b)), "(bvxor SymVar_0 SymVar_1)")
+
+    def test_infix(self):
+        self.ctx.addSimplificationRule("(a & ~b) | (~a & b) -> a ^ b")
+        n = (~self.b & self.a) | (self.b & ~self.a)
+        self.assertEqual(str(self.ctx.simplify(n)), "(bvxor SymVar_0 SymVar_1)")
+
+    def test_sub_trees(self):
+        self.ctx.addSimplificationRule("((_ extract 7 0) ((_ zero_extend 8) x)) -> x")
+        self.ctx.addSimplificationRule("x * 2 -> x << 1")
+        n = self.astCtxt.bvadd(self.astCtxt.extract(7, 0, self.astCtxt.zx(8, self.a)), self.b * 2)
+        self.assertEqual(str(self.ctx.simplify(n)), "(bvadd SymVar_0 (bvshl SymVar_1 (_ bv1 8)))")
+
+    def test_lifting(self):
+        self.ctx.addSimplificationRule("(bvxor x x) -> 0")
+        self.ctx.symbolizeRegister(self.ctx.registers.rax)
+        self.ctx.processing(Instruction(b"\x48\x31\xc0")) # xor rax, rax
+        self.assertEqual(str(self.ctx.getSymbolicRegister(self.ctx.registers.rax).getAst()), "(_ bv0 64)")
+
+    def test_rules(self):
+        self.ctx.addSimplificationRule("(bvxor x x) -> 0")
+        self.ctx.addSimplificationRule("(bvand x -1) -> x")
+        self.assertEqual(self.ctx.getSimplificationRules(), ["(bvxor x x) -> 0", "(bvand x -1) -> x"])
+        self.ctx.clearSimplificationRules()
+        self.assertEqual(self.ctx.getSimplificationRules(), [])
+        self.assertEqual(str(self.ctx.simplify(self.a ^ self.a)), "(bvxor SymVar_0 SymVar_0)")
+
+    def test_invalid(self):
+        with self.assertRaises(TypeError):
+            self.ctx.addSimplificationRule("x -> 0")
+        with self.assertRaises(TypeError):
+            self.ctx.addSimplificationRule("(bvadd x y) -> z")
+        with self.assertRaises(TypeError):
+            self.ctx.addSimplificationRule("(bvadd x y")
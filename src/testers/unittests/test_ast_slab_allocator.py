@@ -0,0 +1,49 @@
+#!/usr/bin/env python3
+## -*- coding: utf-8 -*-
+"""Test AST slab allocator."""
+
+import unittest
+from triton import *
+
+
+
+class TestAstSlabAllocator(unittest.TestCase):
+
+    """Testing the AST_SLAB_ALLOCATOR mode."""
+
+    def setUp(self):
+        self.ctx = TritonContext()
+        self.ctx.setArchitecture(ARCH.X86_64)
+        self.ctx.setMode(MODE.AST_SLAB_ALLOCATOR, True)
+        self.astCtxt = self.ctx.getAstContext()
+
+    def test_processing(self):
+        rax = self.astCtxt.variable(self.ctx.symbolizeRegister(self.ctx.registers.rax))
+        self.ctx.setConcreteRegisterValue(self.ctx.registers.rbx, 0)
+
+        for _ in range(1000):
+            self.ctx.processing(Instruction(b"\x48\x01\xC3")) # add rbx, rax
+            self.ctx.processing(Instruction(b"\x48\x29\xC3")) # sub rbx, rax
+        self.ctx.processing(Instruction(b"\x48\x01\xC3"))     # add rbx, rax
+
+        rbx = self.ctx.getSymbolicRegister(self.ctx.registers.rbx).getAst()
+        self.ctx.setConcreteVariableValue(rax.getSymbolicVariable(), 0xdeadbeaf)
+        self.assertEqual(rbx.evaluate(), 0xdeadbeaf)
+
+    def test_mixed_allocations(self):
+        sv = self.ctx.newSymbolicVariable(32)
+        n1 = self.astCtxt.bvadd(self.astCtxt.variable(sv), self.astCtxt.bv(1, 32))
+        self.ctx.setMode(MODE.AST_SLAB_ALLOCATOR, False)
+        n2 = self.astCtxt.bvmul(n1, self.astCtxt.bv(2, 32))
+        self.ctx.setMode(MODE.AST_SLAB_ALLOCATOR, True)
+        n3 = self.astCtxt.bvsub(n2, n1)
+        self.ctx.setConcreteVariableValue(sv, 10)
+        self.assertEqual(n3.evaluate(), 11)
+
+    def test_context_lifetime(self):
+        sv = self.ctx.newSymbolicVariable(8)
+        node = self.astCtxt.bvnot(self.astCtxt.variable(sv))
+        # The node outlives its context
+        self.ctx = None
+        self.astCtxt = None
+        self.assertEqual(node.evaluate(), 0xff)
@@ -55,3 +55,49 @@ class TestAstUtils(unittest.TestCase):
         self.assertEqual(str(self.astCtxt.dereference(r2)), "SymVar_0")
         self.assertEqual(str(self.astCtxt.dereference(r1)), "SymVar_0")
         self.assertEqual(str(self.astCtxt.dereference(self.v1)), "SymVar_0")
+
+    def test_parents(self):
+        nodes = [self.astCtxt.bvadd(self.v1, self.astCtxt.bv(i, 8)) for i in range(100)]
+        self.assertEqual(len(self.v1.getParents()), 100)
+
+        # A node used twice by the same parent is listed once
+        n = self.astCtxt.bvxor(self.v2, self.v2)
+        self.assertEqual(len(self.v2.getParents()), 1)
+
+        # Dead parents are dropped
+        nodes = nodes[:10]
+        self.assertEqual(len(self.v1.getParents()), 10)
+
+        self.ctx.setConcreteVariableValue(self.sv1, 5)
+        self.assertEqual(nodes[9].evaluate(), 14)
+        self.assertEqual(n.evaluate(), 0)
+
+    def test_deep_ast_destruction(self):
+        # Deep chains are released without recursion
+        node = self.v1
+        for i in range(200000):
+            node = self.astCtxt.bvnot(node)
+        self.assertEqual(node.getLevel(), 200001)
+        node = None
+
+        # Chains built by instructions are released by steps at each instruction
+        self.ctx.symbolizeRegister(self.ctx.registers.rax)
+        for i in range(20000):
+            self.ctx.processing(Instruction(b"\x48\xf7\xd0")) # not rax
+        self.ctx.concretizeAllRegister()
+        self.ctx.processing(Instruction(b"\x48\x31\xc0"))     # xor rax, rax
+        self.assertEqual(self.ctx.getConcreteRegisterValue(self.ctx.registers.rax), 0)
+
+    def test_hash(self):
+        # Commutative operators hash their operands regardless of their order
+        self.assertEqual(self.astCtxt.bvadd(self.v1, self.v2).getHash(), self.astCtxt.bvadd(self.v2, self.v1).getHash())
+        self.assertNotEqual(self.astCtxt.bvsub(self.v1, self.v2).getHash(), self.astCtxt.bvsub(self.v2, self.v1).getHash())
+
+        # Distinct trees have distinct hashes, even with even operands
+        hashes = set()
+        trees = set()
+        for i in range(64):
+            for j in range(64):
+                hashes.add(self.astCtxt.bvmul(self.astCtxt.bv(i, 8), self.astCtxt.bv(j * 2, 8)).getHash())
+                trees.add(frozenset((i, j * 2)))
+        self.assertEqual(len(hashes), len(trees))
@@ -2,6 +2,8 @@
 # coding: utf-8
 """Test architectures."""
 
+import os
+import tempfile
 import unittest
 
 from triton import ARCH, TritonContext
@@ -176,3 +178,27 @@ class TestX8664ConcreteMemoryValue(unittest.TestCase):
         self.Triton.setConcreteMemoryAreaValue(0x1000, b"\x11\x22\x33\x44\x55\x66")
         self.Triton.setConcreteMemoryAreaValue(0x1006, [0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc])
         self.assertEqual(self.Triton.getConcreteMemoryAreaValue(0x1000, 12), b"\x11\x22\x33\x44\x55\x66\x77\x88\x99\xaa\xbb\xcc")
+
+    def test_map_file(self):
+        data = bytes(range(256)) * 80
+        fd, path = tempfile.mkstemp()
+        os.write(fd, data)
+        os.close(fd)
+
+        # A range which is not page aligned, in the file and in memory
+        self.Triton.mapConcreteMemoryFile(0x10010, path, 0x30, len(data) - 0x30)
+        os.remove(path)
+
+        self.assertTrue(self.Triton.isConcreteMemoryValueDefined(0x10010, len(data) - 0x30))
+        self.assertFalse(self.Triton.isConcreteMemoryValueDefined(0x1000f, 1))
+        self.assertEqual(self.Triton.getConcreteMemoryAreaValue(0x10010, len(data) - 0x30), data[0x30:])
+
+        # Written and cleared pages are copied, the other bytes are still read in place
+        self.Triton.setConcreteMemoryValue(0x11010, 0xff)
+        self.assertEqual(self.Triton.getConcreteMemoryValue(0x11010), 0xff)
+        self.assertEqual(self.Triton.getConcreteMemoryValue(0x11011), data[0x1031])
+
+        self.Triton.clearConcreteMemoryValue(0x12000, 0x1000)
+        self.assertFalse(self.Triton.isConcreteMemoryValueDefined(0x12000, 1))
+        self.assertEqual(self.Triton.getConcreteMemoryValue(0x12000), 0)
+        self.assertEqual(self.Triton.getConcreteMemoryValue(0x13000), data[0x3020])
@@ -2,6 +2,8 @@
 # coding: utf-8
 """Test Path Constraint."""
 
+import os
+import tempfile
 import unittest
 from triton import *
 
@@ -76,12 +78,49 @@ class TestPathConstraint(unittest.TestCase):
         self.ctx.pushPathConstraint(ast.equal(ast.bvtrue(), ast.bvtrue()))
 
         pc  = self.ctx.getPathPredicate()
-        self.assertEqual(str(pc), "(and (and (= (_ bv1 1) (_ bv1 1)) (= ref!35 (_ bv1 1))) (= (_ bv1 1) (_ bv1 1)))")
+        self.assertEqual(str(pc), "(and (= (_ bv1 1) (_ bv1 1)) (= ref!35 (_ bv1 1)) (= (_ bv1 1) (_ bv1 1)))")
 
         self.ctx.popPathConstraint()
         pc  = self.ctx.getPathPredicate()
         self.assertEqual(str(pc), str(opc))
 
+    def test_deduplication(self):
+        """Test PC_DEDUPLICATION and setMaxPathConstraintsPerSite"""
+        self.ctx.setMode(MODE.PC_DEDUPLICATION, True)
+        for _ in range(10):
+            self.ctx.processing(Instruction(0x1000, b"\x0F\x84\x55\x00\x00\x00")) # je 0x1055
+        self.assertEqual(self.ctx.getPathPredicateSize(), 2)
+
+        self.ctx.setMode(MODE.PC_DEDUPLICATION, False)
+        self.ctx.setMaxPathConstraintsPerSite(3)
+        for _ in range(10):
+            self.ctx.processing(Instruction(0x2000, b"\x0F\x84\x55\x00\x00\x00")) # je 0x2055
+        self.assertEqual(self.ctx.getPathPredicateSize(), 5)
+
+        self.ctx.popPathConstraint()
+        self.ctx.processing(Instruction(0x2000, b"\x0F\x84\x55\x00\x00\x00")) # je 0x2055
+        self.assertEqual(self.ctx.getPathPredicateSize(), 5)
+
+    def test_log(self):
+        """Test setPathConstraintLog"""
+        pc = self.ctx.getPathConstraints()[0]
+        with tempfile.TemporaryDirectory() as directory:
+            self.ctx.setPathConstraintLog(os.path.join(directory, "pc.log"), 2)
+            for i in range(10):
+                self.ctx.processing(Instruction(0x1000 + i * 0x10, b"\x0F\x84\x55\x00\x00\x00")) # je
+            self.assertEqual(self.ctx.getPathPredicateSize(), 3)
+            self.assertEqual(self.ctx.getSizeOfLoggedPathConstraints(), 8)
+
+            logged = self.ctx.getLoggedPathConstraints(0, 8)
+            self.assertEqual(len(logged), 8)
+            self.assertEqual(logged[0].getTakenAddress(), pc.getTakenAddress())
+            self.assertEqual(str(logged[0].getTakenPredicate()), str(pc.getTakenPredicate()))
+            self.assertEqual(logged[1].getBranchConstraints()[0]['srcAddr'], 0x1000)
+            self.assertNotEqual(len(self.ctx.getModel(logged[0].getTakenPredicate())), 0)
+
+            self.ctx.setPathConstraintLog("", 0)
+            self.assertEqual(self.ctx.getSizeOfLoggedPathConstraints(), 0)
+
     def test_reachingBB(self):
         self.assertEqual(len(self.ctx.getPredicatesToReachAddress(108)), 1)
         self.assertEqual(len(self.ctx.getPredicatesToReachAddress(23)), 1)
@@ -103,3 +142,44 @@ class TestPathConstraint(unittest.TestCase):
             ctx.processing(Instruction(opcodes))
 
         self.assertEqual(ctx.getModel(ctx.getPredicatesToReachAddress(0x1337)[0])[0].getValue(), 0x1336)
+
+
+class TestPathPredicateSlice(unittest.TestCase):
+
+    """Testing the slicing of the path predicate."""
+
+    def setUp(self):
+        self.ctx = TritonContext(ARCH.X86_64)
+        self.ast = self.ctx.getAstContext()
+        self.x = self.ast.variable(self.ctx.newSymbolicVariable(8, 'x'))
+        self.y = self.ast.variable(self.ctx.newSymbolicVariable(8, 'y'))
+        self.z = self.ast.variable(self.ctx.newSymbolicVariable(8, 'z'))
+        self.w = self.ast.variable(self.ctx.newSymbolicVariable(8, 'w'))
+        for cst in [self.x > 10, self.y == 3, self.x + self.z == 5, self.w != 0, self.z < 100]:
+            self.ctx.pushPathConstraint(cst)
+
+    def test_cluster(self):
+        node  = self.y != 3
+        slice = self.ctx.getPathPredicateSlice(node)
+        self.assertEqual(str(slice), str(self.ast.land([self.y == 3, node])))
+
+    def test_transitive(self):
+        pcs   = self.ctx.getPathConstraints()
+        node  = self.ast.lnot(pcs[4].getTakenPredicate())
+        slice = self.ctx.getPathPredicateSlice(node, 4)
+        self.assertEqual(str(slice), str(self.ast.land([pcs[0].getTakenPredicate(), pcs[2].getTakenPredicate(), node])))
+        model = self.ctx.getModel(slice)
+        self.assertEqual(len(model), 2)
+        self.assertGreaterEqual(model[self.z.getSymbolicVariable().getId()].getValue(), 100)
+
+    def test_independent(self):
+        node = self.ast.equal(self.ast.bv(1, 8), self.ast.bv(1, 8))
+        self.assertEqual(str(self.ctx.getPathPredicateSlice(node)), str(node))
+        node = self.ast.variable(self.ctx.newSymbolicVariable(8, 'v')) == 1
+        self.assertEqual(str(self.ctx.getPathPredicateSlice(node, 0)), str(node))
+
+    def test_pop(self):
+        self.ctx.popPathConstraint()
+        self.ctx.pushPathConstraint(self.w == self.y)
+        slice = self.ctx.getPathPredicateSlice(self.y != 3)
+        self.assertEqual(str(slice), str(self.ast.land([self.y == 3, self.w != 0, self.w == self.y, self.y != 3])))
@@ -2,6 +2,7 @@
 # coding: utf-8
 """Test Solver."""
 
+import shutil
 import unittest
 
 from triton import *
@@ -32,3 +33,335 @@ class TestSolver(unittest.TestCase):
         self.solve_a_query()
         self.ctx.setSolver(SOLVER.Z3)
         self.solve_a_query()
+
+    def test_projection(self):
+        x = self.ctx.newSymbolicVariable(8, 'x')
+        y = self.ctx.newSymbolicVariable(64, 'y')
+        query = self.astCtxt.land([self.astCtxt.variable(x) < 200, self.astCtxt.variable(y) != self.astCtxt.zx(56, self.astCtxt.variable(x))])
+        models = self.ctx.getModels(query, 300, variables=[x])
+        self.assertEqual(len(models), 200)
+        self.assertEqual(sorted(m[x.getId()].getValue() for m in models), list(range(200)))
+        self.assertTrue(all(list(m.keys()) == [x.getId()] for m in models))
+        self.ctx.setSolver(SOLVER.LOCAL_SEARCH)
+        models = self.ctx.getModels(self.astCtxt.variable(x) < 4, 10, variables=[x])
+        self.assertEqual(sorted(m[x.getId()].getValue() for m in models), [0, 1, 2, 3])
+
+
+class TestSolverSession(unittest.TestCase):
+
+    """Testing the incremental solver session."""
+
+    def setUp(self):
+        """Define the arch and a path."""
+        self.ctx = TritonContext(ARCH.X86_64)
+        self.ctx.setSolver(SOLVER.Z3)
+        self.ast = self.ctx.getAstContext()
+        self.x = self.ast.variable(self.ctx.newSymbolicVariable(8, 'x'))
+        for cst in [self.x > 10, self.x < 20, self.x != 15, self.x != 16]:
+            self.ctx.pushPathConstraint(cst)
+
+    def flip(self, index):
+        pcs = self.ctx.getPathConstraints()
+        return self.ast.lnot(pcs[index].getTakenPredicate())
+
+    def test_flip_prefixes(self):
+        """Flipping each branch agrees with the non-incremental solver."""
+        pcs = self.ctx.getPathConstraints()
+        for i in range(len(pcs)):
+            prefix = self.ast.land([pc.getTakenPredicate() for pc in pcs[:i]] + [self.flip(i)])
+            expected = self.ctx.isSat(prefix)
+            self.assertEqual(self.ctx.isSatOnPath(self.flip(i), i), expected)
+            model = self.ctx.getModelOnPath(self.flip(i), i)
+            self.assertEqual(len(model) != 0, expected)
+            if model:
+                self.ctx.setConcreteVariableValue(self.ctx.getSymbolicVariable('x'), model[0].getValue())
+                self.assertEqual(prefix.evaluate(), 1)
+
+    def test_status(self):
+        model, status, time = self.ctx.getModelOnPath(self.flip(2), 2, status=True, timeout=5000)
+        self.assertEqual(status, SOLVER_STATE.SAT)
+        self.assertEqual(model[0].getValue(), 15)
+        model, status, time = self.ctx.getModelOnPath(self.x == 15, 3, status=True)
+        self.assertEqual(status, SOLVER_STATE.UNSAT)
+        self.assertEqual(len(model), 0)
+
+    def test_pushpop(self):
+        """The session follows pops and pushes of the path predicate."""
+        self.assertFalse(self.ctx.isSatOnPath(self.x == 16, 4))
+        self.ctx.popPathConstraint()
+        self.assertTrue(self.ctx.isSatOnPath(self.x == 16, 4))
+        self.ctx.pushPathConstraint(self.x == 12)
+        self.assertFalse(self.ctx.isSatOnPath(self.x == 16, 4))
+        self.assertEqual(self.ctx.getModelOnPath(self.x >= 0, 4)[0].getValue(), 12)
+        self.ctx.clearPathConstraints()
+        self.assertTrue(self.ctx.isSatOnPath(self.x == 200, 4))
+        self.ctx.resetSolverSession()
+        self.assertTrue(self.ctx.isSatOnPath(self.x == 200, 0))
+
+
+class TestSolverCache(unittest.TestCase):
+
+    """Testing the solver cache."""
+
+    def setUp(self):
+        """Define the arch and enable the cache."""
+        self.ctx = TritonContext(ARCH.X86_64)
+        self.ctx.setSolverCacheCapacity(64)
+        self.ast = self.ctx.getAstContext()
+        self.x = self.ast.variable(self.ctx.newSymbolicVariable(8, 'x'))
+        self.y = self.ast.variable(self.ctx.newSymbolicVariable(8, 'y'))
+
+    def test_same_query(self):
+        a, b = self.x > 10, self.x < 20
+        m1 = self.ctx.getModel(self.ast.land([a, b]))
+        m2, status, _ = self.ctx.getModel(self.ast.land([b, a]), status=True)
+        self.assertEqual(status, SOLVER_STATE.SAT)
+        self.assertEqual(m1[0].getValue(), m2[0].getValue())
+        self.assertEqual(self.ctx.getSolverCacheHits(), 1)
+        self.assertEqual(self.ctx.getSolverCacheMisses(), 1)
+
+    def test_unsat_subset(self):
+        self.assertFalse(self.ctx.isSat(self.ast.land([self.x > 10, self.x < 5])))
+        self.assertFalse(self.ctx.isSat(self.ast.land([self.x < 5, self.y == 3, self.x > 10])))
+        self.assertEqual(self.ctx.getSolverCacheHits(), 1)
+
+    def test_sat_superset(self):
+        m1 = self.ctx.getModel(self.ast.land([self.x > 10, self.x < 20]))
+        m2 = self.ctx.getModel(self.ast.land([self.x > 10, self.x < 20, self.y == 0]))
+        self.assertEqual(self.ctx.getSolverCacheHits(), 1)
+        self.assertEqual(m2[0].getValue(), m1[0].getValue())
+        self.assertEqual(m2[1].getValue(), 0)
+
+    def test_clear(self):
+        self.ctx.isSat(self.x == 1)
+        self.ctx.isSat(self.x == 1)
+        self.assertEqual(self.ctx.getSolverCacheHits(), 1)
+        self.ctx.clearSolverCache()
+        self.assertEqual(self.ctx.getSolverCacheHits(), 0)
+        self.ctx.isSat(self.x == 1)
+        self.assertEqual(self.ctx.getSolverCacheMisses(), 1)
+        self.ctx.setSolverCacheCapacity(0)
+        self.ctx.isSat(self.x == 1)
+        self.assertEqual(self.ctx.getSolverCacheHits(), 0)
+
+
+class TestSolverFastPath(unittest.TestCase):
+
+    """Testing the solver fast path."""
+
+    def setUp(self):
+        """Define the arch and enable the fast path."""
+        self.ctx = TritonContext(ARCH.X86_64)
+        self.ctx.setSolverFastPath(True)
+        self.ast = self.ctx.getAstContext()
+        self.x = self.ast.variable(self.ctx.newSymbolicVariable(8, 'x'))
+        self.y = self.ast.variable(self.ctx.newSymbolicVariable(32, 'y'))
+
+    def test_extract(self):
+        model, status, _ = self.ctx.getModel(self.ast.extract(7, 0, self.y) == 0x41, status=True)
+        self.assertEqual(status, SOLVER_STATE.SAT)
+        self.assertEqual(model[1].getValue(), 0x41)
+        models = self.ctx.getModels(self.ast.extract(7, 0, self.y) == 0x41, 3)
+        self.assertEqual([m[1].getValue() for m in models], [0x41, 0x141, 0x241])
+        self.assertEqual(self.ctx.getSolverFastPathHits(), 2)
+
+    def test_range(self):
+        models = self.ctx.getModels(self.ast.land([self.y >= 5, self.y < 8, self.y != 6]), 10)
+        self.assertEqual([m[1].getValue() for m in models], [5, 7])
+        models = self.ctx.getModels(self.ast.land([self.ast.bvslt(self.x, self.ast.bv(0, 8)), self.x > 0xfd]), 10)
+        self.assertEqual([m[0].getValue() for m in models], [0xfe, 0xff])
+
+    def test_linear(self):
+        models = self.ctx.getModels(self.x * 6 + 1 == 0x0d, 10)
+        self.assertEqual([m[0].getValue() for m in models], [2, 0x82])
+        self.assertFalse(self.ctx.isSat(self.x * 2 == 3))
+        self.assertEqual(self.ctx.getSolverFastPathHits(), 2)
+
+    def test_unsat(self):
+        model, status, _ = self.ctx.getModel(self.ast.land([self.x > 10, self.x < 5]), status=True)
+        self.assertEqual(status, SOLVER_STATE.UNSAT)
+        self.assertEqual(len(model), 0)
+
+    def test_fallthrough(self):
+        model = self.ctx.getModel((self.x ^ 3) == 0x41)
+        self.assertEqual(model[0].getValue(), 0x42)
+        self.assertEqual(self.ctx.getSolverFastPathHits(), 0)
+        self.ctx.setSolverFastPath(False)
+        self.assertFalse(self.ctx.isSolverFastPathEnabled())
+        self.ctx.isSat(self.x == 1)
+        self.assertEqual(self.ctx.getSolverFastPathHits(), 0)
+
+
+class TestLocalSearchSolver(unittest.TestCase):
+
+    """Testing the local-search solver."""
+
+    def setUp(self):
+        """Define the arch and the solver."""
+        self.ctx = TritonContext(ARCH.X86_64)
+        self.ctx.setSolver(SOLVER.LOCAL_SEARCH)
+        self.ast = self.ctx.getAstContext()
+        self.x = self.ast.variable(self.ctx.newSymbolicVariable(32, 'x'))
+        self.y = [self.ast.variable(self.ctx.newSymbolicVariable(8, 'y%d' % i)) for i in range(4)]
+
+    def test_magic(self):
+        x = self.x
+        model, status, _ = self.ctx.getModel(self.ast.land([self.ast.extract(7, 0, x) == 0x4d, self.ast.extract(15, 8, x) == 0x5a, self.ast.extract(31, 16, x) == 0x4550]), status=True)
+        self.assertEqual(status, SOLVER_STATE.SAT)
+        self.assertEqual(model[0].getValue(), 0x45505a4d)
+
+    def test_checksum(self):
+        total = self.ast.bvadd(self.ast.bvadd(self.ast.zx(8, self.y[0]), self.ast.zx(8, self.y[1])), self.ast.bvadd(self.ast.zx(8, self.y[2]), self.ast.zx(8, self.y[3])))
+        model = self.ctx.getModel(self.ast.land([total == 0x2f1, (self.y[0] ^ self.y[1]) == 0x55]))
+        values = [model[i].getValue() for i in range(1, 5)]
+        self.assertEqual(sum(values), 0x2f1)
+        self.assertEqual(values[0] ^ values[1], 0x55)
+
+    def test_models(self):
+        models = self.ctx.getModels(self.ast.land([self.y[0] < 10, self.ast.bvsgt(self.x, self.ast.bv(-3, 32))]), 5)
+        self.assertEqual(len(models), 5)
+        self.assertEqual(len(set((m[0].getValue(), m[1].getValue()) for m in models)), 5)
+        for m in models:
+            self.assertLess(m[1].getValue(), 10)
+
+    def test_unknown(self):
+        model, status, _ = self.ctx.getModel(self.ast.land([self.y[0] > 10, self.y[0] < 5]), status=True)
+        self.assertEqual(status, SOLVER_STATE.UNKNOWN)
+        self.assertEqual(len(model), 0)
+
+
+@unittest.skipIf(shutil.which('z3') is None, "needs the z3 binary")
+class TestSmtLibSolver(unittest.TestCase):
+
+    """Testing the external SMT-LIB2 solvers."""
+
+    def setUp(self):
+        """Define the arch and the solver."""
+        self.ctx = TritonContext(ARCH.X86_64)
+        self.ctx.setSolver(SOLVER.SMTLIB)
+        self.ctx.setSolverCommands([['z3', '-in']])
+        self.ast = self.ctx.getAstContext()
+        self.x = self.ast.variable(self.ctx.newSymbolicVariable(8, 'x'))
+        self.y = self.ast.variable(self.ctx.newSymbolicVariable(64, 'y'))
+
+    def test_models(self):
+        models, status, _ = self.ctx.getModels(self.ast.land([self.x > 10, self.x < 14]), 10, status=True)
+        self.assertEqual(status, SOLVER_STATE.SAT)
+        self.assertEqual(sorted(m[0].getValue() for m in models), [11, 12, 13])
+        model = self.ctx.getModel(self.y * 3 == 0xfffffffffffffffd)
+        self.assertEqual((model[1].getValue() * 3) & 0xffffffffffffffff, 0xfffffffffffffffd)
+        self.assertFalse(self.ctx.isSat(self.ast.land([self.x > 10, self.x < 5])))
+
+    def test_race(self):
+        self.ctx.setSolverCommands([['sh', '-c', 'cat > /dev/null'], ['z3', '-in']])
+        self.assertTrue(self.ctx.isSat(self.x == 0x41))
+
+    def test_timeout(self):
+        self.ctx.setSolverCommands([['sh', '-c', 'cat > /dev/null']])
+        self.ctx.setSolverTimeout(100)
+        _, status, _ = self.ctx.getModel(self.x == 0x41, status=True)
+        self.assertEqual(status, SOLVER_STATE.TIMEOUT)
+
+
+class TestSolverPolicy(unittest.TestCase):
+
+    """Testing the solver policy of path-aware queries."""
+
+    def setUp(self):
+        """Define the arch and a path."""
+        self.ctx = TritonContext(ARCH.X86_64)
+        self.ctx.setSolver(SOLVER.Z3)
+        self.ast = self.ctx.getAstContext()
+        self.x = self.ast.variable(self.ctx.newSymbolicVariable(8, 'x'))
+        self.y = self.ast.variable(self.ctx.newSymbolicVariable(8, 'y'))
+        self.ctx.pushPathConstraint(self.x > 10)
+        self.ctx.pushPathConstraint(self.y == 3)
+
+    def test_full(self):
+        self.assertEqual(self.ctx.getSolverPolicy(), SOLVER_POLICY.FULL)
+        model, status, _, strategy = self.ctx.getModelOnPath(self.x == 5, 2, strategy=True)
+        self.assertEqual(status, SOLVER_STATE.UNSAT)
+        self.assertEqual(strategy, SOLVER_POLICY.FULL)
+        self.assertEqual(len(model), 0)
+
+    def test_nested(self):
+        """An UNSAT full query is not retried with the nested constraints."""
+        self.ctx.setSolverPolicy(SOLVER_POLICY.NESTED)
+        _, status, _, strategy = self.ctx.getModelOnPath(self.x == 5, 2, strategy=True)
+        self.assertEqual(status, SOLVER_STATE.UNSAT)
+        self.assertEqual(strategy, SOLVER_POLICY.FULL)
+        self.assertFalse(self.ctx.isSatOnPath(self.x == 5, 2))
+
+    def test_last(self):
+        self.ctx.setSolverPolicy(SOLVER_POLICY.LAST)
+        model, status, _, strategy = self.ctx.getModelOnPath(self.x == 5, 2, strategy=True)
+        self.assertEqual(status, SOLVER_STATE.SAT)
+        self.assertEqual(strategy, SOLVER_POLICY.LAST)
+        self.assertEqual(model[0].getValue(), 5)
+        self.assertTrue(self.ctx.isSatOnPath(self.x == 5, 2))
+        model, status, _, strategy = self.ctx.getModelOnPath(self.x == 12, 2, strategy=True)
+        self.assertEqual(strategy, SOLVER_POLICY.FULL)
+        self.assertEqual(model[0].getValue(), 12)
+
+
+class TestFlipPathConstraints(unittest.TestCase):
+
+    """Testing the parallel branch flipping."""
+
+    def setUp(self):
+        """Define the arch and a path with three symbolic branches."""
+        self.ctx = TritonContext(ARCH.X86_64)
+        self.ctx.setSolver(SOLVER.Z3)
+        self.ast = self.ctx.getAstContext()
+        self.ctx.symbolizeRegister(self.ctx.registers.rax, 'rax')
+        self.ctx.symbolizeRegister(self.ctx.registers.rbx, 'rbx')
+        self.ctx.symbolizeRegister(self.ctx.registers.rcx, 'rcx')
+
+        trace = [
+            b"\x3c\x41",          # cmp al, 0x41
+            b"\x74\x00",          # je 0
+            b"\x80\xfb\x42",      # cmp bl, 0x42
+            b"\x75\x00",          # jne 0
+            b"\x80\xf9\x43",      # cmp cl, 0x43
+            b"\x72\x00",          # jb 0
+        ]
+
+        pc = 0x1000
+        for opcodes in trace:
+            inst = Instruction(pc, opcodes)
+            self.ctx.processing(inst)
+            pc = inst.getNextAddress()
+
+    def serial(self):
+        models = list()
+        pcs = self.ctx.getPathConstraints()
+        for index, pc in enumerate(pcs):
+            for branch in pc.getBranchConstraints():
+                if branch['isTaken'] is False:
+                    prefix = [p.getTakenPredicate() for p in pcs[:index]]
+                    node = self.ast.land(prefix + [branch['constraint']])
+                    models.append((index, branch['dstAddr'], node))
+        return models
+
+    def test_results(self):
+        results = self.ctx.flipPathConstraints(threads=2, timeout=5000)
+        expected = self.serial()
+        self.assertEqual(len(results), 3)
+        self.assertEqual([(r['index'], r['dstAddr']) for r in results], [(e[0], e[1]) for e in expected])
+        for result, (_, _, node) in zip(results, expected):
+            self.assertEqual(result['status'], SOLVER_STATE.SAT)
+            self.assertEqual(result['strategy'], SOLVER_POLICY.FULL)
+            for k, v in result['model'].items():
+                self.ctx.setConcreteVariableValue(v.getVariable(), v.getValue())
+            self.assertEqual(node.evaluate(), 1)
+
+    def test_callback(self):
+        seen = list()
+        self.assertIsNone(self.ctx.flipPathConstraints(callback=lambda r: seen.append(r['index'])))
+        self.assertEqual(sorted(seen), [0, 1, 2])
+
+    def test_callback_error(self):
+        def cb(result):
+            raise ValueError('stop')
+        with self.assertRaises(ValueError):
+            self.ctx.flipPathConstraints(callback=cb, threads=2)